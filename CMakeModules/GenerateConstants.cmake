@@ -0,0 +1,145 @@
+# Generates a header with constexpr physical and astronomical constants,
+# parsed from the documents that are shipped in doc/.
+#
+# Run in script mode:
+#
+#     cmake -DASTRONOMICAL=<doc/Astronomical_Constants_2016.txt>
+#           -DPHYSICAL=<doc/Fundamental_Physical_Constants_2014.txt>
+#           -DOUTPUT=<Constants.hpp> -P GenerateConstants.cmake
+
+cmake_minimum_required(VERSION 3.5)
+
+foreach(var ASTRONOMICAL PHYSICAL OUTPUT)
+  if(NOT DEFINED ${var})
+    message(FATAL_ERROR "${var} is not set")
+  endif()
+endforeach()
+
+file(STRINGS "${ASTRONOMICAL}" astronomical_lines)
+file(STRINGS "${PHYSICAL}" physical_lines)
+
+get_filename_component(astronomical_name "${ASTRONOMICAL}" NAME)
+get_filename_component(physical_name "${PHYSICAL}" NAME)
+
+set(body "")
+
+# emits one constant, with its doc comment
+macro(emit name value description)
+  set(body "${body}\n/**\n * @brief ${description}\n *\n */\nconstexpr double ${name} = ${value};\n")
+endmacro()
+
+# "1.32712442099D20" -> "1.32712442099e20"
+macro(fortran_to_c var)
+  string(REPLACE "D" "e" ${var} "${${var}}")
+endmacro()
+
+# one row of the table of IAU constants: "| description | symbol = value |"
+# the first row that matches is used, i.e. TCB-compatible values
+function(astronomical name regex description)
+  foreach(line IN LISTS astronomical_lines)
+    if(line MATCHES "${regex}[^|]*\\|[^|]*= *([-+0-9.D]+) *\\|")
+      set(value "${CMAKE_MATCH_1}")
+      fortran_to_c(value)
+      emit(${name} "${value}" "${description}")
+      set(body "${body}" PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+
+  message(FATAL_ERROR "${astronomical_name}: no '${regex}'")
+endfunction()
+
+# one row of the table of equatorial radii, [km] -> [m]
+function(radius name body_regex description)
+  foreach(line IN LISTS astronomical_lines)
+    if(line MATCHES "^\\|   \\| +${body_regex} +\\| += +([0-9.]+) +\\| km ")
+      emit(${name} "${CMAKE_MATCH_1}e3" "${description}")
+      set(body "${body}" PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+
+  message(FATAL_ERROR "${astronomical_name}: no radius of '${body_regex}'")
+endfunction()
+
+# one row of the CODATA listing, fixed-width columns, the value is in
+# columns 60-84, with the digits grouped by spaces: "6.674 08 e-11"
+function(physical name quantity description)
+  foreach(line IN LISTS physical_lines)
+    if(line MATCHES "^${quantity}  ")
+      string(SUBSTRING "${line}" 60 25 value)
+      string(REPLACE " " "" value "${value}")
+      string(REPLACE "..." "" value "${value}")
+      if(NOT value MATCHES "^[-+0-9.]+(e[-+]?[0-9]+)?$")
+        message(FATAL_ERROR "${physical_name}: bad value '${value}'")
+      endif()
+      emit(${name} "${value}" "${description}")
+      set(body "${body}" PARENT_SCOPE)
+      return()
+    endif()
+  endforeach()
+
+  message(FATAL_ERROR "${physical_name}: no '${quantity}'")
+endfunction()
+
+set(body "${body}\n// ${physical_name}\n")
+
+physical(SpeedOfLight "speed of light in vacuum"
+  "speed of light in vacuum [m/s]")
+physical(GravitationalConstant "Newtonian constant of gravitation"
+  "Newtonian constant of gravitation [m^3/(kg*s^2)]")
+physical(StandardGravity "standard acceleration of gravity"
+  "standard acceleration of gravity, \\\\f$g_0\\\\f$ [m/s^2]")
+physical(StandardAtmosphere "standard atmosphere"
+  "standard atmosphere [Pa]")
+physical(MolarGasConstant "molar gas constant"
+  "molar gas constant [J/(mol*K)]")
+physical(BoltzmannConstant "Boltzmann constant"
+  "Boltzmann constant [J/K]")
+physical(AvogadroConstant "Avogadro constant"
+  "Avogadro constant [1/mol]")
+
+set(body "${body}\n// ${astronomical_name}\n")
+
+astronomical(AstronomicalUnit "Astronomical unit \\(unit distance\\)"
+  "astronomical unit [m]")
+astronomical(SunMu "Solar mass parameter"
+  "solar mass parameter, \\\\f$GM_S\\\\f$ [m^3/s^2]")
+astronomical(EarthMu "Geocentric gravitational constant"
+  "geocentric gravitational constant, \\\\f$GM_E\\\\f$ [m^3/s^2]")
+astronomical(EarthEquatorialRadius "Equatorial radius for Earth"
+  "equatorial radius of the Earth [m]")
+astronomical(EarthJ2 "Dynamical form-factor for the Earth"
+  "dynamical form-factor of the Earth, \\\\f$J_2\\\\f$")
+astronomical(EarthAngularVelocity "Nominal mean angular vel\\.of Earth rotation"
+  "nominal mean angular velocity of the Earth rotation [rad/s]")
+astronomical(EarthInverseFlattening "Earth, reciprocal of flattening"
+  "reciprocal of flattening of the Earth, \\\\f$1/f\\\\f$")
+astronomical(MoonToEarthMassRatio "Mass Ratio: Moon to Earth"
+  "mass ratio of the Moon to the Earth")
+
+foreach(planet Mercury Venus Mars Jupiter Saturn Uranus Neptune)
+  astronomical(SunTo${planet}MassRatio "Mass Ratio: Sun to ${planet} "
+    "mass ratio of the Sun to ${planet}, with its satellites")
+endforeach()
+astronomical(SunToPlutoMassRatio "Mass Ratio: Sun to \\(134340\\) Pluto"
+  "mass ratio of the Sun to Pluto, with its satellites")
+
+foreach(planet Mercury Venus Earth Mars Jupiter Saturn Uranus Neptune)
+  radius(${planet}Radius "${planet}" "equatorial radius of ${planet} [m]")
+endforeach()
+radius(PlutoRadius "\\(134340\\) Pluto" "equatorial radius of Pluto [m]")
+radius(MoonRadius "Moon \\(mean\\)" "mean radius of the Moon [m]")
+radius(SunRadius "Sun" "equatorial radius of the Sun [m]")
+
+set(header "// Generated by GenerateConstants.cmake from ${astronomical_name}
+// and ${physical_name}. Do not edit.
+
+#pragma once
+
+namespace Constants {
+${body}
+} // namespace Constants
+")
+
+file(WRITE "${OUTPUT}" "${header}")
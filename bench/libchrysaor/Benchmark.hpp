@@ -0,0 +1,58 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <chrono>   // for duration, steady_clock
+#include <cstddef>  // for size_t
+#include <iostream> // for operator<<, basic_ostream, cout, endl
+
+/**
+ * @brief runs the kernel repeatedly, and measures it's average run time
+ *
+ * The kernel is run once before the measurement, to warm up the caches.
+ *
+ * @param kernel the code to benchmark
+ * @param iterations how many times to run the kernel
+ * @return double average wall time of one kernel run [ns]
+ */
+template <typename Kernel>
+double Measure(Kernel kernel, std::size_t iterations) {
+  kernel();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; i++) {
+    kernel();
+  }
+  const auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         static_cast<double>(iterations);
+}
+
+/**
+ * @brief prints the result of a Measure() run
+ *
+ * @param name name of the benchmark
+ * @param ns average wall time of one kernel run [ns]
+ * @param items how many items one kernel run processes
+ */
+static inline void Report(const char *name, double ns, std::size_t items) {
+  std::cout << name << ": " << ns << " ns/run, "
+            << (ns / static_cast<double>(items)) << " ns/item" << std::endl;
+}
@@ -0,0 +1,130 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.hpp" // for Measure, Report
+#include "Kepler.hpp"    // for EccentricAnomaly, HyperbolicAnomaly, Tru...
+#include <cmath>         // for sin, sinh, abs, M_PI
+#include <cstddef>       // for size_t
+#include <iostream>      // for operator<<, basic_ostream, cout, cerr
+#include <vector>        // for vector
+
+// Kepler's equation throughput and accuracy, over the eccentricity bands.
+//
+// For each band of the elliptic orbits:
+//  * the scalar EccentricAnomaly(), one orbit at a time
+//  * the batched, fixed-iteration SIMD EccentricAnomaly()
+//  * the batched TrueAnomaly()
+// and the largest residual of M = E - e sin(E) of the batch.
+//
+// The hyperbolic solver, which is scalar and iterates until converged.
+
+static const std::size_t N = 4096;
+static const std::size_t ITERATIONS = 200;
+
+struct Band {
+  const char *name;
+  double lo;
+  double hi;
+};
+
+static const Band Bands[] = {
+    {"e in [0, 0.1)", 0.0, 0.1},
+    {"e in [0.1, 0.5)", 0.1, 0.5},
+    {"e in [0.5, 0.9)", 0.5, 0.9},
+    {"e in [0.9, 0.999)", 0.9, 0.999},
+    {"e in [0.999, 0.99999)", 0.999, 0.99999},
+};
+
+int main() {
+  std::vector<double> M(N), e(N), E(N), nu(N);
+  for (std::size_t i = 0; i < N; i++) {
+    // covers the whole revolution, and then some
+    M[i] = -4.0 * M_PI + 8.0 * M_PI * static_cast<double>(i) / N;
+  }
+
+  int ret = 0;
+
+  for (const Band &band : Bands) {
+    for (std::size_t i = 0; i < N; i++) {
+      const auto k = static_cast<double>((i * 2654435761U) % N) / N;
+      e[i] = band.lo + (band.hi - band.lo) * k;
+    }
+
+    const double t_scalar = Measure(
+        [&]() {
+          for (std::size_t i = 0; i < N; i++) {
+            E[i] = EccentricAnomaly(M[i], e[i]);
+          }
+        },
+        ITERATIONS);
+    const double t_batch = Measure(
+        [&]() { EccentricAnomaly(M.data(), e.data(), E.data(), N); },
+        ITERATIONS);
+    const double t_true = Measure(
+        [&]() { TrueAnomaly(M.data(), e.data(), nu.data(), N); },
+        ITERATIONS);
+
+    double worst = 0.0;
+    for (std::size_t i = 0; i < N; i++) {
+      const double r = std::abs(E[i] - e[i] * std::sin(E[i]) - M[i]);
+      worst = r > worst ? r : worst;
+    }
+
+    std::cout << band.name << ":" << std::endl;
+    Report("  EccentricAnomaly, scalar", t_scalar, N);
+    Report("  EccentricAnomaly, batched", t_batch, N);
+    Report("  TrueAnomaly, batched", t_true, N);
+    std::cout << "  max |E - e sin(E) - M|: " << worst << std::endl;
+
+    if (!(worst < 1e-13)) {
+      std::cerr << band.name << ": inaccurate" << std::endl;
+      ret = 1;
+    }
+  }
+
+  for (std::size_t i = 0; i < N; i++) {
+    e[i] = 1.0 + 1e-3 + 10.0 * static_cast<double>(i) / N;
+    M[i] = -100.0 + 200.0 * static_cast<double>((i * 2654435761U) % N) / N;
+  }
+
+  const double t_hyperbolic = Measure(
+      [&]() {
+        for (std::size_t i = 0; i < N; i++) {
+          E[i] = HyperbolicAnomaly(M[i], e[i]);
+        }
+      },
+      ITERATIONS);
+
+  double worst = 0.0;
+  for (std::size_t i = 0; i < N; i++) {
+    const double r = std::abs(e[i] * std::sinh(E[i]) - E[i] - M[i]) /
+                     (1.0 + std::abs(M[i]));
+    worst = r > worst ? r : worst;
+  }
+
+  std::cout << "e in (1, 11):" << std::endl;
+  Report("  HyperbolicAnomaly, scalar", t_hyperbolic, N);
+  std::cout << "  max |e sinh(H) - H - M| / (1 + |M|): " << worst << std::endl;
+
+  if (!(worst < 1e-13)) {
+    std::cerr << "hyperbolic: inaccurate" << std::endl;
+    ret = 1;
+  }
+
+  return ret;
+}
@@ -0,0 +1,93 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.hpp"     // for Measure, Report
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Constants.hpp"     // for AstronomicalUnit
+#include "Porkchop.hpp"      // for Porkchop, PorkchopAxis
+#include "SolarSystem.hpp"   // for SolarSystem::Sun
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for sqrt, cos, sin
+#include <cstddef>           // for size_t
+#include <cstdio>            // for remove
+#include <iostream>          // for operator<<, basic_ostream, cout, cerr, endl
+#include <vector>            // for vector
+
+// The porkchop plot of the Earth to Mars transfers, with circular coplanar
+// orbits, a day apart over two years of departures and of arrivals:
+//  * one thread, Evaluate() of every cell of the first rows
+//  * Write() of the whole grid, on all the cores, streamed to the file
+
+static const std::size_t N = 1024;
+static const double Day = 86400.0;
+
+struct Circle {
+  std::vector<double> t;
+  std::vector<Vec3> r;
+  std::vector<Vec3> v;
+
+  Circle(double R, double phase, double t0) {
+    const double V = std::sqrt(SolarSystem::Sun.mu_ / R);
+    for (std::size_t i = 0; i < N; i++) {
+      t.push_back(t0 + i * Day);
+      const double angle = phase + t.back() * V / R;
+      r.emplace_back(R * std::cos(angle), R * std::sin(angle), 0.0);
+      v.emplace_back(-V * std::sin(angle), V * std::cos(angle), 0.0);
+    }
+  }
+
+  PorkchopAxis Axis() const { return {t.data(), r.data(), v.data(), N}; }
+};
+
+int main() {
+  const Circle earth(Constants::AstronomicalUnit, 0.0, 0.0);
+  const Circle mars(1.524 * Constants::AstronomicalUnit, 0.8, 100.0 * Day);
+  const Porkchop porkchop(&SolarSystem::Sun, 1);
+
+  const std::size_t rows = 16;
+  double sink = 0.0;
+  const double t_scalar = Measure(
+      [&]() {
+        for (std::size_t i = 0; i < rows; i++) {
+          for (std::size_t j = 0; j < N; j++) {
+            double cell[Porkchop::Columns];
+            porkchop.Evaluate(earth.r[i], earth.v[i], mars.r[j], mars.v[j],
+                              mars.t[j] - earth.t[i], cell);
+            sink += cell[Porkchop::Revolutions] == 0.0;
+          }
+        }
+      },
+      1);
+
+  const char *path = "porkchop.bin";
+  bool written = false;
+  const double t_write = Measure(
+      [&]() { written = porkchop.Write(path, earth.Axis(), mars.Axis()); }, 1);
+  std::remove(path);
+
+  if (!written) {
+    std::cerr << "cannot write " << path << std::endl;
+    return 1;
+  }
+
+  Report("Evaluate, one thread", t_scalar, rows * N);
+  Report("Write, all threads", t_write, N * N);
+  std::cout << "(" << sink << " direct transfers)" << std::endl;
+
+  return 0;
+}
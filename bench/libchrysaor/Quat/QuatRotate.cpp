@@ -0,0 +1,136 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.hpp" // for Measure, Report
+#include "Mat3.hpp"      // for Mat3, BasicMat3
+#include "Quat.hpp"      // for Quat, BasicQuat
+#include "Vec3.hpp"      // for Vec3
+#include <cmath>         // for cos, sin
+#include <cstddef>       // for size_t
+#include <iostream>      // for operator<<, basic_ostream, cerr, endl
+#include <vector>        // for vector
+
+// Rotate-vector throughput.
+//
+// One attitude per vector (e.g. each sample of an attitude history):
+//  * naive matrix code: rotation matrix built from the Euler angles
+//  * Quat::rotate(), the fused q v q* form
+//
+// One attitude for many vectors (e.g. a frame transformation):
+//  * Mat3 * Vec3, one vector at a time
+//  * Quat::rotate() batched over SoA arrays
+
+static const std::size_t N = 4096;
+static const std::size_t ITERATIONS = 1000;
+
+struct Euler {
+  double yaw;
+  double pitch;
+  double roll;
+};
+
+// Z-Y-X Euler angles, as it is usually hand-written.
+static Vec3 NaiveRotate(Euler e, Vec3 v) {
+  const double cy = std::cos(e.yaw), sy = std::sin(e.yaw);
+  const double cp = std::cos(e.pitch), sp = std::sin(e.pitch);
+  const double cr = std::cos(e.roll), sr = std::sin(e.roll);
+
+  const double m[3][3] = {
+      {cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr},
+      {sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr},
+      {-sp, cp * sr, cp * cr}};
+
+  return Vec3(m[0][0] * v.x_ + m[0][1] * v.y_ + m[0][2] * v.z_,
+              m[1][0] * v.x_ + m[1][1] * v.y_ + m[1][2] * v.z_,
+              m[2][0] * v.x_ + m[2][1] * v.y_ + m[2][2] * v.z_);
+}
+
+static Quat FromEuler(Euler e) {
+  return Quat::FromAxisAngle(Vec3(0.0, 0.0, 1.0), e.yaw) *
+         Quat::FromAxisAngle(Vec3(0.0, 1.0, 0.0), e.pitch) *
+         Quat::FromAxisAngle(Vec3(1.0, 0.0, 0.0), e.roll);
+}
+
+static bool Near(Vec3 a, Vec3 b, Vec3 ref) {
+  return (a - b).norm() <= 1.0e-12 * (1.0 + ref.norm());
+}
+
+int main() {
+  std::vector<Euler> euler(N);
+  std::vector<Quat> quat(N);
+  std::vector<Vec3> in(N);
+  std::vector<double> x(N), y(N), z(N);
+  for (std::size_t i = 0; i < N; i++) {
+    const auto k = static_cast<double>(i);
+    euler[i] = Euler{1.0e-03 * k, -0.5 + 2.0e-04 * k, 2.4 - 1.0e-03 * k};
+    quat[i] = FromEuler(euler[i]);
+    in[i] = Vec3(k, 1.0 - 0.5 * k, 1.0e+03 / (1.0 + k));
+    x[i] = in[i].x_;
+    y[i] = in[i].y_;
+    z[i] = in[i].z_;
+  }
+
+  const Mat3 m = quat[N / 2].matrix();
+
+  std::vector<Vec3> naive(N), fused(N), matrix(N);
+  std::vector<double> ox(N), oy(N), oz(N);
+
+  const double t_naive = Measure(
+      [&]() {
+        for (std::size_t i = 0; i < N; i++) {
+          naive[i] = NaiveRotate(euler[i], in[i]);
+        }
+      },
+      ITERATIONS);
+  const double t_fused = Measure(
+      [&]() {
+        for (std::size_t i = 0; i < N; i++) {
+          fused[i] = quat[i].rotate(in[i]);
+        }
+      },
+      ITERATIONS);
+  const double t_matrix = Measure(
+      [&]() {
+        for (std::size_t i = 0; i < N; i++) {
+          matrix[i] = m * in[i];
+        }
+      },
+      ITERATIONS);
+  const double t_batch = Measure(
+      [&]() {
+        quat[N / 2].rotate(x.data(), y.data(), z.data(), ox.data(), oy.data(),
+                           oz.data(), N);
+      },
+      ITERATIONS);
+
+  Report("one attitude per vector: naive matrix", t_naive, N);
+  Report("one attitude per vector: Quat::rotate", t_fused, N);
+  Report("one attitude: Mat3 * Vec3", t_matrix, N);
+  Report("one attitude: Quat::rotate, batched", t_batch, N);
+
+  for (std::size_t i = 0; i < N; i++) {
+    if (!Near(naive[i], fused[i], in[i]) ||
+        !Near(matrix[i], Vec3(ox[i], oy[i], oz[i]), in[i])) {
+      std::cerr << "mismatch at " << i << ": " << naive[i] << ", "
+                << fused[i] << ", " << matrix[i] << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
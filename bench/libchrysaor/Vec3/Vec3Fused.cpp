@@ -0,0 +1,81 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Benchmark.hpp" // for Measure, Report
+#include "Vec3.hpp"      // for Vec3
+#include <cstddef>       // for size_t
+#include <iostream>      // for operator<<, basic_ostream, cerr, endl
+#include <vector>        // for vector
+
+// Integrates r += v*dt + a*dt^2/2 for a cloud of particles, once written
+// with Vec3 operators, and once as a hand-written per-component loop.
+// Both must produce bit-for-bit identical results, and should take the same
+// time, which shows that the Vec3 expression did not leave any temporaries.
+
+static const std::size_t N = 4096;
+static const std::size_t ITERATIONS = 10000;
+static const double dt = 1.0 / 64.0;
+
+static void Fused(std::vector<Vec3> &r, const std::vector<Vec3> &v,
+                  const std::vector<Vec3> &a) {
+  for (std::size_t i = 0; i < r.size(); i++) {
+    r[i] = r[i] + v[i] * dt + a[i] * (0.5 * dt * dt);
+  }
+}
+
+static void HandWritten(std::vector<Vec3> &r, const std::vector<Vec3> &v,
+                        const std::vector<Vec3> &a) {
+  for (std::size_t i = 0; i < r.size(); i++) {
+    r[i].x_ = r[i].x_ + v[i].x_ * dt + a[i].x_ * (0.5 * dt * dt);
+    r[i].y_ = r[i].y_ + v[i].y_ * dt + a[i].y_ * (0.5 * dt * dt);
+    r[i].z_ = r[i].z_ + v[i].z_ * dt + a[i].z_ * (0.5 * dt * dt);
+  }
+}
+
+int main() {
+  std::vector<Vec3> r(N);
+  std::vector<Vec3> v(N);
+  std::vector<Vec3> a(N);
+
+  for (std::size_t i = 0; i < N; i++) {
+    const auto k = static_cast<double>(i);
+    r[i] = Vec3(6.4e+06 + k, -k, 0.5 * k);
+    v[i] = Vec3(7.8e+03, 1.0e-03 * k, -2.0);
+    a[i] = Vec3(-9.8, 0.25, 1.0e-04 * k);
+  }
+
+  std::vector<Vec3> r_fused(r);
+  std::vector<Vec3> r_hand(r);
+
+  const double fused = Measure([&]() { Fused(r_fused, v, a); }, ITERATIONS);
+  const double hand =
+      Measure([&]() { HandWritten(r_hand, v, a); }, ITERATIONS);
+
+  Report("Vec3 operators", fused, N);
+  Report("hand-written loop", hand, N);
+
+  for (std::size_t i = 0; i < N; i++) {
+    if (!(r_fused[i] == r_hand[i])) {
+      std::cerr << "mismatch at " << i << ": " << r_fused[i]
+                << " != " << r_hand[i] << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BodySystem.hpp"
+#include "CelestialBody.hpp"      // for CelestialBody
+#include "ChebyshevEphemeris.hpp" // for ChebyshevEphemeris
+#include "Vec3.hpp"               // for Vec3
+#include <cassert>                // for assert
+#include <cmath>                  // for cos, sin, sqrt, pow, isfinite, M_PI
+#include <cstddef>                // for size_t
+#include <limits>                 // for numeric_limits
+#include <vector>                 // for vector
+
+const CelestialBody *BodySystem::Body(std::size_t body) const {
+  assert(body < bodies_.size());
+
+  return bodies_[body];
+}
+
+std::size_t BodySystem::Index(const CelestialBody *body) const {
+  for (std::size_t i = 0; i < bodies_.size(); i++) {
+    if (bodies_[i] == body)
+      return i;
+  }
+
+  return bodies_.size();
+}
+
+std::size_t BodySystem::Parent(std::size_t body) const {
+  assert(body < bodies_.size());
+
+  return parent_[body];
+}
+
+double BodySystem::SphereOfInfluence(std::size_t body) const {
+  assert(body < bodies_.size());
+
+  return soi_[body];
+}
+
+std::size_t BodySystem::Add(const CelestialBody *root) {
+  assert(root);
+  assert(bodies_.empty());
+
+  bodies_.push_back(root);
+  parent_.push_back(0);
+  children_.emplace_back();
+
+  soi_.push_back(std::numeric_limits<double>::infinity());
+  soi2_.push_back(std::numeric_limits<double>::infinity());
+
+  P_.emplace_back();
+  Q_.emplace_back();
+  n_.push_back(0.0);
+  theta0_.push_back(0.0);
+
+  position_.emplace_back();
+
+  return 0;
+}
+
+std::size_t BodySystem::Add(const CelestialBody *body, double sma,
+                            double inclination, double raan, double phase) {
+  assert(body);
+  assert(!bodies_.empty());
+  assert(std::isfinite(sma));
+  assert(sma > 0.0);
+  assert(std::isfinite(inclination));
+  assert(inclination >= 0.0 && inclination <= 180.0);
+  assert(std::isfinite(raan));
+  assert(std::isfinite(phase));
+
+  const std::size_t parent = Index(body->ParentBody());
+  const std::size_t index = bodies_.size();
+  if (parent == index)
+    return index;
+
+  const double i = M_PI * inclination / 180.0;
+  const double O = M_PI * raan / 180.0;
+
+  const double muParent = bodies_[parent]->mu_;
+  assert(muParent > 0.0);
+
+  const double soi = sma * std::pow(body->mu_ / muParent, 0.4);
+  assert(std::isfinite(soi));
+
+  bodies_.push_back(body);
+  parent_.push_back(parent);
+  children_.emplace_back();
+  children_[parent].push_back(index);
+
+  soi_.push_back(soi);
+  soi2_.push_back(soi * soi);
+
+  P_.emplace_back(sma * std::cos(O), sma * std::sin(O), 0.0);
+  Q_.emplace_back(-sma * std::sin(O) * std::cos(i),
+                  sma * std::cos(O) * std::cos(i), sma * std::sin(i));
+  n_.push_back(std::sqrt((muParent + body->mu_) / (sma * sma * sma)));
+  theta0_.push_back(M_PI * phase / 180.0);
+
+  position_.emplace_back();
+
+  // the cached positions are missing the new body now
+  assert(!ephemeris_);
+  t_ = std::numeric_limits<double>::quiet_NaN();
+
+  return index;
+}
+
+Vec3 BodySystem::RelativePosition(std::size_t body, double t) const {
+  assert(body < bodies_.size());
+  assert(std::isfinite(t));
+
+  const double theta = theta0_[body] + n_[body] * t;
+
+  return P_[body] * std::cos(theta) + Q_[body] * std::sin(theta);
+}
+
+void BodySystem::UseEphemeris(const ChebyshevEphemeris *ephemeris) {
+  assert(!ephemeris || ephemeris->size() == bodies_.size());
+
+  ephemeris_ = ephemeris;
+
+  t_ = std::numeric_limits<double>::quiet_NaN();
+}
+
+void BodySystem::Update(double t) {
+  assert(!bodies_.empty());
+  assert(std::isfinite(t));
+
+  if (t == t_)
+    return;
+
+  position_[0] = Vec3();
+  if (ephemeris_) {
+    for (std::size_t i = 1; i < bodies_.size(); i++)
+      position_[i] = position_[parent_[i]] + ephemeris_->Position(i, t);
+  } else {
+    for (std::size_t i = 1; i < bodies_.size(); i++)
+      position_[i] = position_[parent_[i]] + RelativePosition(i, t);
+  }
+
+  t_ = t;
+}
+
+Vec3 BodySystem::Position(std::size_t body) const {
+  assert(body < bodies_.size());
+  assert(std::isfinite(t_));
+
+  return position_[body];
+}
+
+std::size_t BodySystem::DominantBody(Vec3 r, std::size_t hint) const {
+  assert(hint < bodies_.size());
+  assert(std::isfinite(t_));
+
+  std::size_t body = hint;
+  while (body != 0 && !Inside(r, body))
+    body = parent_[body];
+
+  // spheres of influence of the siblings do not overlap
+  bool descended = true;
+  while (descended) {
+    descended = false;
+    for (const std::size_t child : children_[body]) {
+      if (Inside(r, child)) {
+        body = child;
+        descended = true;
+        break;
+      }
+    }
+  }
+
+  return body;
+}
+
+void BodySystem::DominantBody(const double *x, const double *y,
+                              const double *z, std::size_t *body,
+                              std::size_t n) const {
+  std::size_t hint = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    hint = DominantBody(Vec3(x[i], y[i], z[i]), hint);
+    body[i] = hint;
+  }
+}
+
+BodySystem::BodySystem()
+    : bodies_(), parent_(), children_(), soi_(), soi2_(), P_(), Q_(), n_(),
+      theta0_(), ephemeris_(nullptr),
+      t_(std::numeric_limits<double>::quiet_NaN()), position_() {}
@@ -0,0 +1,233 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+#include <vector>   // for vector
+
+class CelestialBody;
+class ChebyshevEphemeris;
+
+/**
+ * @brief hierarchy of celestial bodies, with patched-conic spheres of
+ * influence
+ *
+ * Every body but the root one orbits its CelestialBody::ParentBody(), on a
+ * circular orbit. The bodies are stored flat, indexed in the order in which
+ * they were added, and a parent is always added before its children, so
+ * one forward pass computes all the positions.
+ *
+ * The radius of the sphere of influence of each body,
+ * \f$r_{SOI} = a\left({\mu\over{\mu_{parent}}}\right)^{2/5}\f$,
+ * is precomputed once, when the body is added.
+ *
+ * Update() computes the positions of all the bodies, relative to the root,
+ * at the given time, once. After that, all the queries are read-only, and
+ * can be done from any number of threads.
+ *
+ * \see https://en.wikipedia.org/wiki/Sphere_of_influence_(astrodynamics)
+ */
+class BodySystem {
+private:
+  /**
+   * @brief the bodies, the root one is the first
+   *
+   */
+  std::vector<const CelestialBody *> bodies_;
+
+  /**
+   * @brief index of the parent body, the root is its own parent
+   *
+   */
+  std::vector<std::size_t> parent_;
+
+  /**
+   * @brief indexes of the children of each body
+   *
+   */
+  std::vector<std::vector<std::size_t>> children_;
+
+  /**
+   * @brief radius of the sphere of influence [m], and its square [m^2]
+   *
+   */
+  std::vector<double> soi_;
+  std::vector<double> soi2_;
+
+  /**
+   * @brief the orbit, \f$\vec{r} = \vec{P}\cos\theta + \vec{Q}\sin\theta\f$,
+   * with \f$\theta = \theta_0 + nt\f$
+   *
+   */
+  std::vector<Vec3> P_;
+  std::vector<Vec3> Q_;
+  std::vector<double> n_;
+  std::vector<double> theta0_;
+
+  /**
+   * @brief precomputed orbits, if any
+   *
+   */
+  const ChebyshevEphemeris *ephemeris_;
+
+  /**
+   * @brief the time of the cached positions [s]
+   *
+   */
+  double t_;
+
+  /**
+   * @brief the cached positions, relative to the root body [m]
+   *
+   */
+  std::vector<Vec3> position_;
+
+  bool Inside(Vec3 r, std::size_t body) const {
+    const Vec3 d = r - position_[body];
+    return d.dot(d) < soi2_[body];
+  }
+
+public:
+  /**
+   * @brief number of bodies
+   *
+   */
+  std::size_t size() const { return bodies_.size(); }
+
+  /**
+   * @brief the body with given index
+   *
+   */
+  const CelestialBody *Body(std::size_t body) const;
+
+  /**
+   * @brief index of the given body, linear search
+   *
+   * @return std::size_t index of the body, or size() if it is not in the
+   * system
+   */
+  std::size_t Index(const CelestialBody *body) const;
+
+  /**
+   * @brief index of the parent of the given body
+   *
+   */
+  std::size_t Parent(std::size_t body) const;
+
+  /**
+   * @brief radius of the sphere of influence [m], infinite for the root
+   *
+   */
+  double SphereOfInfluence(std::size_t body) const;
+
+  /**
+   * @brief adds the root body, it must be the first one
+   *
+   * @return std::size_t index of the body, 0
+   */
+  std::size_t Add(const CelestialBody *root);
+
+  /**
+   * @brief adds a body on a circular orbit around its parent
+   *
+   * The parent (CelestialBody::ParentBody()) must already be added,
+   * otherwise nothing is added.
+   *
+   * @param body the body
+   * @param sma orbit radius [m]
+   * @param inclination orbit inclination [deg]
+   * @param raan longitude of the ascending node [deg]
+   * @param phase argument of latitude at t = 0 [deg]
+   * @return std::size_t index of the body, or size() if the parent is not
+   * in the system
+   */
+  std::size_t Add(const CelestialBody *body, double sma, double inclination,
+                  double raan, double phase);
+
+  /**
+   * @brief position of the body, relative to its parent, at given time [m]
+   *
+   * Evaluates the orbit directly, does not touch the cache.
+   *
+   * @param body index of the body
+   * @param t time [s]
+   */
+  Vec3 RelativePosition(std::size_t body, double t) const;
+
+  /**
+   * @brief makes Update() take the positions from the ephemeris
+   *
+   * @param ephemeris the ephemeris of this system, or nullptr to evaluate
+   * the orbits directly
+   */
+  void UseEphemeris(const ChebyshevEphemeris *ephemeris);
+
+  /**
+   * @brief computes the positions of all the bodies at given time
+   *
+   * Does nothing if they are already computed for that time.
+   *
+   * @param t time [s]
+   */
+  void Update(double t);
+
+  /**
+   * @brief the time of the cached positions [s]
+   *
+   */
+  double Epoch() const { return t_; }
+
+  /**
+   * @brief cached position of the body, relative to the root body [m]
+   *
+   */
+  Vec3 Position(std::size_t body) const;
+
+  /**
+   * @brief the body whose sphere of influence contains the position
+   *
+   * Walks up from the hint until the position is inside the sphere of
+   * influence, and then down into the children, so when the hint is the
+   * previous answer for a nearby position, that is just a few distance
+   * checks.
+   *
+   * @param r position, relative to the root body, at Epoch() [m]
+   * @param hint index of the body to start the search from
+   * @return std::size_t index of the dominant body
+   */
+  std::size_t DominantBody(Vec3 r, std::size_t hint = 0) const;
+
+  /**
+   * @brief batched DominantBody(), over SoA arrays
+   *
+   * Consecutive positions are assumed to be close, each answer is the hint
+   * for the next position.
+   *
+   * @param x position x coordinates, relative to the root body [m]
+   * @param y position y coordinates, relative to the root body [m]
+   * @param z position z coordinates, relative to the root body [m]
+   * @param body output indexes of the dominant bodies
+   * @param n number of positions
+   */
+  void DominantBody(const double *x, const double *y, const double *z,
+                    std::size_t *body, std::size_t n) const;
+
+  BodySystem();
+};
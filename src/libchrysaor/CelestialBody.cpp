@@ -17,28 +17,21 @@
  */
 
 #include "CelestialBody.hpp"
-#include <cassert> // for assert
-#include <cmath>   // for isfinite, pow, cos, M_PI
+#include "Gravity/SphericalHarmonicGravity.hpp" // for SphericalHarmonicGravity
+#include "Vec3.hpp"                             // for Vec3
+#include <cassert>                              // for assert
+#include <cmath>                                // for isfinite, cos, sqrt, M_PI
+#include <cstddef>                              // for size_t
 
 double CelestialBody::GravitationalAcceleration(double alt) const {
-  assert(std::isfinite(R_));
-  assert(R_ >= 0.0);
-  assert(std::isfinite(mu_));
-  assert(mu_ >= 0.0);
-
   assert(std::isfinite(alt));
   assert(alt >= 0.0);
 
   const double r = alt + R_;
 
-  assert(std::isfinite(r));
-  assert(r >= 0.0);
-  assert(r != 0.0);
-
-  assert(std::isfinite(std::pow(r, 2.0)));
-  assert((std::pow(r, 2.0)) != 0.0);
+  assert(r > 0.0);
 
-  const double g = ((mu_) / (std::pow(r, 2.0)));
+  const double g = GravitationalAccelerationAtRadius(r);
 
   assert(std::isfinite(g));
   assert(g >= 0.0);
@@ -46,73 +39,38 @@ double CelestialBody::GravitationalAcceleration(double alt) const {
   return g;
 }
 
-double CelestialBody::EquatorialSpeed() const {
-  assert(std::isfinite(R_));
-  assert(R_ >= 0.0);
-  assert(std::isfinite(Trot_));
-  assert(Trot_ >= 0.0);
-  assert(Trot_ != 0.0);
+Vec3 CelestialBody::FieldAcceleration(Vec3 r) const {
+  if (!gravityField_)
+    return GravitationalAcceleration(r);
 
-  const double speed = ((2.0 * M_PI) * (R_ / Trot_));
-
-  assert(std::isfinite(speed));
-  assert(speed >= 0.0);
+  return gravityField_->Acceleration(r);
+}
 
-  return speed;
+void CelestialBody::GravitationalAcceleration(const double *x,
+                                              const double *y,
+                                              const double *z, double *ax,
+                                              double *ay, double *az,
+                                              std::size_t n) const {
+  const double mu = mu_;
+
+  for (std::size_t i = 0; i < n; i++) {
+    const double r2 = x[i] * x[i] + y[i] * y[i] + z[i] * z[i];
+    const double k = -mu / (r2 * std::sqrt(r2));
+
+    ax[i] = k * x[i];
+    ay[i] = k * y[i];
+    az[i] = k * z[i];
+  }
 }
 
 double CelestialBody::EquatorialSpeed(double latitude) const {
   assert(std::isfinite(latitude));
   assert((latitude >= -90.0) && (latitude <= 90.0));
 
-  const double s_eq = EquatorialSpeed();
-
-  assert(std::isfinite(s_eq));
-  assert(s_eq >= 0.0);
-
-  assert(std::isfinite(std::cos(M_PI * latitude / 180.0)));
-
-  const double speed = s_eq * std::cos(M_PI * latitude / 180.0);
+  const double speed = equatorialSpeed_ * std::cos(M_PI * latitude / 180.0);
 
   assert(std::isfinite(speed));
   assert(speed >= 0.0);
 
   return speed;
 }
-
-CelestialBody::CelestialBody() noexcept
-    : parentBody_(nullptr), orbit_(nullptr), mu_(0.0), R_(0.0), Trot_(0.0),
-      atmosphere_(nullptr) {}
-
-CelestialBody::CelestialBody(double mu, double R) noexcept
-    : parentBody_(nullptr), orbit_(nullptr), mu_(mu), R_(R), Trot_(0.0),
-      atmosphere_(nullptr) {
-  assert(std::isfinite(mu));
-  assert(mu >= 0.0);
-  assert(std::isfinite(R));
-  assert(R >= 0.0);
-}
-
-CelestialBody::CelestialBody(double mu, double R, double Trot) noexcept
-    : parentBody_(nullptr), orbit_(nullptr), mu_(mu), R_(R), Trot_(Trot),
-      atmosphere_(nullptr) {
-  assert(std::isfinite(mu));
-  assert(mu >= 0.0);
-  assert(std::isfinite(R));
-  assert(R >= 0.0);
-  assert(std::isfinite(Trot));
-  assert(Trot >= 0.0);
-}
-
-CelestialBody::CelestialBody(double mu, double R, double Trot,
-                             Atmosphere *atmosphere) noexcept
-    : parentBody_(nullptr), orbit_(nullptr), mu_(mu), R_(R), Trot_(Trot),
-      atmosphere_(atmosphere) {
-  assert(std::isfinite(mu));
-  assert(mu >= 0.0);
-  assert(std::isfinite(R));
-  assert(R >= 0.0);
-  assert(std::isfinite(Trot));
-  assert(Trot >= 0.0);
-  assert(atmosphere);
-}
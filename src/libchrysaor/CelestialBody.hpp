@@ -18,9 +18,23 @@
 
 #pragma once
 
+#include "Vec3.hpp" // for Vec3
+#include <cassert>  // for assert
+#include <cmath>    // for sqrt, M_PI
+#include <cstddef>  // for size_t
+#include <limits>   // for numeric_limits
+
 class Orbit;
 class Atmosphere;
+class SphericalHarmonicGravity;
 
+/**
+ * @brief a celestial body
+ *
+ * All the constructors are constexpr, so the bodies can be constructed at
+ * compile time, e.g. from the constants in the generated Constants.hpp,
+ * see SolarSystem.hpp.
+ */
 class CelestialBody {
 private:
   /**
@@ -61,6 +75,29 @@ public:
    */
   const Atmosphere *atmosphere_;
 
+  /**
+   * @brief non-spherical gravity field, or nullptr for a point mass
+   *
+   */
+  const SphericalHarmonicGravity *gravityField_;
+
+  // Derived constants. Validated and precomputed once, in the constructor,
+  // since these are needed on every step of any trajectory propagation.
+
+  /**
+   * @brief angular rotation speed [rad/s]
+   *
+   * \f$\omega = {{2\pi}\over{T_{rot}}}\f$, or 0 for non-rotating body.
+   */
+  const double omega_;
+
+  /**
+   * @brief planet's angular rotation speed, at equator [m/s]
+   *
+   * \f$v = \omega{R}\f$
+   */
+  const double equatorialSpeed_;
+
   /**
    * @brief barycentric gravitational acceleration at given radius [m/s^2]
    *
@@ -72,6 +109,57 @@ public:
    */
   double GravitationalAcceleration(double alt) const;
 
+  /**
+   * @brief barycentric gravitational acceleration at given radius [m/s^2]
+   *
+   * Fast path of GravitationalAcceleration(), without any validation.
+   *
+   * @param r distance from the center of the parent body [m]
+   */
+  constexpr double GravitationalAccelerationAtRadius(double r) const {
+    return mu_ / (r * r);
+  }
+
+  /**
+   * @brief barycentric gravitational acceleration vector [m/s^2]
+   *
+   * \f$\vec{g} = -{\mu\over{r^3}}\vec{r}\f$
+   *
+   * \see ZonalGravity for the non-spherical bodies.
+   *
+   * @param r position, relative to the center of the body [m]
+   */
+  Vec3 GravitationalAcceleration(Vec3 r) const {
+    const double r2 = r.dot(r);
+    return r * (-mu_ / (r2 * std::sqrt(r2)));
+  }
+
+  /**
+   * @brief gravitational acceleration vector, with the gravity field [m/s^2]
+   *
+   * Uses gravityField_, if the body has one, and falls back to
+   * GravitationalAcceleration(Vec3) otherwise.
+   *
+   * @param r position, relative to the center of the body, body-fixed [m]
+   * @return Vec3 acceleration, body-fixed [m/s^2]
+   */
+  Vec3 FieldAcceleration(Vec3 r) const;
+
+  /**
+   * @brief batched GravitationalAcceleration(Vec3), over SoA arrays
+   *
+   * @param x position x coordinates [m]
+   * @param y position y coordinates [m]
+   * @param z position z coordinates [m]
+   * @param ax output acceleration x components [m/s^2]
+   * @param ay output acceleration y components [m/s^2]
+   * @param az output acceleration z components [m/s^2]
+   * @param n number of positions
+   */
+  void GravitationalAcceleration(const double *x, const double *y,
+                                 const double *z, double *ax, double *ay,
+                                 double *az, std::size_t n) const;
+
   /**
    * @brief planet's angular rotation speed, at equator [m/s]
    *
@@ -79,7 +167,7 @@ public:
    *
    * \see https://en.wikipedia.org/wiki/Earth%27s_rotation#Angular_speed
    */
-  double EquatorialSpeed() const;
+  constexpr double EquatorialSpeed() const { return equatorialSpeed_; }
 
   /**
    * @brief planet's angular rotation speed, at given latitude [m/s]
@@ -92,9 +180,73 @@ public:
    */
   double EquatorialSpeed(double latitude) const;
 
-  CelestialBody() noexcept;
-  CelestialBody(double mu, double R) noexcept;
-  CelestialBody(double mu, double R, double Trot) noexcept;
-  CelestialBody(double mu, double R, double Trot,
-                Atmosphere *atmosphere) noexcept;
+  /**
+   * @brief the body around which this one orbits, or nullptr for the root
+   *
+   * \see BodySystem for the orbits themselves.
+   */
+  constexpr const CelestialBody *ParentBody() const { return parentBody_; }
+
+  constexpr CelestialBody() noexcept : CelestialBody(0.0, 0.0, 0.0) {}
+
+  constexpr CelestialBody(double mu, double R) noexcept
+      : CelestialBody(mu, R, 0.0) {}
+
+  constexpr CelestialBody(double mu, double R, double Trot) noexcept
+      : CelestialBody(nullptr, mu, R, Trot, nullptr, nullptr) {}
+
+  constexpr CelestialBody(double mu, double R, double Trot,
+                          Atmosphere *atmosphere) noexcept
+      : CelestialBody(nullptr, mu, R, Trot, atmosphere, nullptr) {
+    assert(atmosphere);
+  }
+
+  constexpr CelestialBody(
+      double mu, double R, double Trot,
+      const SphericalHarmonicGravity *gravityField) noexcept
+      : CelestialBody(nullptr, mu, R, Trot, nullptr, gravityField) {
+    assert(gravityField);
+  }
+
+  constexpr CelestialBody(
+      double mu, double R, double Trot, Atmosphere *atmosphere,
+      const SphericalHarmonicGravity *gravityField) noexcept
+      : CelestialBody(nullptr, mu, R, Trot, atmosphere, gravityField) {
+    assert(gravityField);
+  }
+
+  constexpr CelestialBody(const CelestialBody *parentBody, double mu,
+                          double R, double Trot) noexcept
+      : CelestialBody(parentBody, mu, R, Trot, nullptr, nullptr) {
+    assert(parentBody);
+  }
+
+private:
+  /**
+   * @brief std::isfinite(), but constexpr
+   *
+   */
+  static constexpr bool IsFinite(double x) {
+    return x >= -std::numeric_limits<double>::max() &&
+           x <= std::numeric_limits<double>::max();
+  }
+
+  constexpr CelestialBody(
+      const CelestialBody *parentBody, double mu, double R, double Trot,
+      Atmosphere *atmosphere,
+      const SphericalHarmonicGravity *gravityField) noexcept
+      : parentBody_(parentBody), orbit_(nullptr), mu_(mu), R_(R), Trot_(Trot),
+        atmosphere_(atmosphere), gravityField_(gravityField),
+        omega_((Trot > 0.0) ? ((2.0 * M_PI) / Trot) : 0.0),
+        equatorialSpeed_(omega_ * R) {
+    assert(IsFinite(mu));
+    assert(mu >= 0.0);
+    assert(IsFinite(R));
+    assert(R >= 0.0);
+    assert(IsFinite(Trot));
+    assert(Trot >= 0.0);
+
+    assert(IsFinite(omega_));
+    assert(IsFinite(equatorialSpeed_));
+  }
 };
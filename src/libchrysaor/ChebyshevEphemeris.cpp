@@ -0,0 +1,266 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChebyshevEphemeris.hpp"
+#include "BodySystem.hpp" // for BodySystem
+#include "MappedFile.hpp" // for MappedFile
+#include "Vec3.hpp"       // for Vec3
+#include <algorithm>      // for min, max
+#include <cassert>        // for assert
+#include <cmath>          // for ceil, cos, isfinite, M_PI
+#include <cstddef>        // for size_t
+#include <cstdint>        // for uint64_t
+#include <cstdio>         // for fopen, fwrite, fclose, FILE
+#include <cstring>        // for memcpy, memcmp
+#include <memory>         // for unique_ptr
+#include <string>         // for string
+#include <vector>         // for vector
+
+namespace {
+
+// the file starts with this, and then has the parent indexes (uint64_t),
+// and the coefficients (double), all naturally aligned.
+struct Header {
+  char magic[8];
+  std::uint64_t bodies;
+  std::uint64_t segments;
+  std::uint64_t terms;
+  double t0;
+  double t1;
+  double dt;
+  std::uint64_t reserved;
+};
+
+static_assert(sizeof(Header) == 64, "the header must have no padding");
+
+const char Magic[8] = {'C', 'H', 'R', 'Y', 'E', 'P', 'H', '1'};
+
+} // namespace
+
+void ChebyshevEphemeris::Fit(const BodySystem &system) {
+  const std::size_t N = terms_;
+
+  storage_.assign(bodies_ * segments_ * 3 * N, 0.0);
+
+  // the Chebyshev nodes, and the cosine table of the discrete transform
+  std::vector<double> nodes(N);
+  std::vector<double> cosines(N * N);
+  for (std::size_t k = 0; k < N; k++) {
+    nodes[k] = std::cos(M_PI * (k + 0.5) / N);
+    for (std::size_t j = 0; j < N; j++)
+      cosines[j * N + k] = std::cos(M_PI * j * (k + 0.5) / N);
+  }
+
+  std::vector<Vec3> samples(N);
+  for (std::size_t body = 1; body < bodies_; body++) {
+    for (std::size_t segment = 0; segment < segments_; segment++) {
+      const double mid = t0_ + dt_ * (segment + 0.5);
+
+      for (std::size_t k = 0; k < N; k++)
+        samples[k] = system.RelativePosition(body, mid + 0.5 * dt_ * nodes[k]);
+
+      double *c = &storage_[(body * segments_ + segment) * 3 * N];
+      for (std::size_t j = 0; j < N; j++) {
+        Vec3 sum;
+        for (std::size_t k = 0; k < N; k++)
+          sum += samples[k] * cosines[j * N + k];
+
+        sum *= (j == 0 ? 1.0 : 2.0) / N;
+
+        c[j] = sum.x_;
+        c[N + j] = sum.y_;
+        c[2 * N + j] = sum.z_;
+      }
+    }
+  }
+
+  coefficients_ = storage_.data();
+}
+
+bool ChebyshevEphemeris::Map() {
+  if (file_->size() < sizeof(Header))
+    return false;
+
+  Header header;
+  std::memcpy(&header, file_->data(), sizeof(header));
+  if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+    return false;
+
+  if (header.bodies == 0 || header.segments == 0 || header.terms == 0)
+    return false;
+
+  if (!std::isfinite(header.t0) || !std::isfinite(header.t1) ||
+      !(header.t1 > header.t0) || !std::isfinite(header.dt) ||
+      !(header.dt > 0.0))
+    return false;
+
+  // the parents, and then a whole number of coefficients
+  std::size_t left = file_->size() - sizeof(Header);
+  if (header.bodies > left / sizeof(std::uint64_t))
+    return false;
+
+  left -= sizeof(std::uint64_t) * header.bodies;
+  if (left % sizeof(double) != 0)
+    return false;
+
+  // exact divisions, so that a product that overflows cannot match
+  const std::size_t count = left / sizeof(double);
+  if (count % header.bodies != 0 ||
+      (count / header.bodies) % header.segments != 0 ||
+      (count / header.bodies / header.segments) % 3 != 0 ||
+      count / header.bodies / header.segments / 3 != header.terms)
+    return false;
+
+  const char *data = static_cast<const char *>(file_->data());
+
+  std::vector<std::uint64_t> parent(header.bodies);
+  std::memcpy(parent.data(), data + sizeof(Header),
+              sizeof(std::uint64_t) * header.bodies);
+  for (const std::uint64_t p : parent)
+    if (p >= header.bodies)
+      return false;
+
+  bodies_ = header.bodies;
+  segments_ = header.segments;
+  terms_ = header.terms;
+  t0_ = header.t0;
+  t1_ = header.t1;
+  dt_ = header.dt;
+  invDt_ = 1.0 / dt_;
+  parent_.assign(parent.begin(), parent.end());
+
+  // mmap is page-aligned, and so is the header, so these are aligned too
+  coefficients_ = reinterpret_cast<const double *>(
+      data + sizeof(Header) + sizeof(std::uint64_t) * bodies_);
+  return true;
+}
+
+std::size_t ChebyshevEphemeris::Parent(std::size_t body) const {
+  assert(body < bodies_);
+
+  return parent_[body];
+}
+
+Vec3 ChebyshevEphemeris::Position(std::size_t body, double t) const {
+  assert(body < bodies_);
+  assert(t >= t0_ && t <= t1_);
+
+  // t1 itself is the end of the last segment; clamped before the cast,
+  // which is undefined for the negative or the huge ones
+  const double s = (t - t0_) * invDt_;
+  const double last = static_cast<double>(segments_ - 1);
+  const std::size_t segment =
+      static_cast<std::size_t>(std::min(std::max(0.0, s), last));
+
+  // position within the segment, [-1, 1]
+  const double x = 2.0 * (s - segment) - 1.0;
+  const double x2 = 2.0 * x;
+
+  const std::size_t N = terms_;
+  const double *cx = coefficients_ + (body * segments_ + segment) * 3 * N;
+  const double *cy = cx + N;
+  const double *cz = cy + N;
+
+  Vec3 b1;
+  Vec3 b2;
+  for (std::size_t j = N - 1; j > 0; j--) {
+    const Vec3 b(x2 * b1.x_ - b2.x_ + cx[j], x2 * b1.y_ - b2.y_ + cy[j],
+                 x2 * b1.z_ - b2.z_ + cz[j]);
+    b2 = b1;
+    b1 = b;
+  }
+
+  return Vec3(x * b1.x_ - b2.x_ + cx[0], x * b1.y_ - b2.y_ + cy[0],
+              x * b1.z_ - b2.z_ + cz[0]);
+}
+
+void ChebyshevEphemeris::Position(std::size_t body, const double *t,
+                                  double *x, double *y, double *z,
+                                  std::size_t n) const {
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 r = Position(body, t[i]);
+    x[i] = r.x_;
+    y[i] = r.y_;
+    z[i] = r.z_;
+  }
+}
+
+bool ChebyshevEphemeris::Save(const std::string &path) const {
+  assert(valid());
+
+  Header header;
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.bodies = bodies_;
+  header.segments = segments_;
+  header.terms = terms_;
+  header.t0 = t0_;
+  header.t1 = t1_;
+  header.dt = dt_;
+  header.reserved = 0;
+
+  std::vector<std::uint64_t> parent(parent_.begin(), parent_.end());
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+
+  std::size_t written = std::fwrite(&header, sizeof(header), 1, file);
+  written += std::fwrite(parent.data(), sizeof(parent[0]), bodies_, file);
+  written += std::fwrite(coefficients_, sizeof(double),
+                         bodies_ * segments_ * 3 * terms_, file);
+
+  // the buffered tail is only written by fclose
+  const bool closed = std::fclose(file) == 0;
+  return closed && written == 1 + bodies_ + bodies_ * segments_ * 3 * terms_;
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris(const BodySystem &system, double t0,
+                                       double t1, double segment,
+                                       std::size_t degree)
+    : file_(), storage_(), coefficients_(nullptr), parent_(),
+      bodies_(system.size()), segments_(0), terms_(degree + 1), t0_(t0),
+      t1_(t1), dt_(0), invDt_(0) {
+  assert(bodies_ > 0);
+  assert(std::isfinite(t0));
+  assert(std::isfinite(t1));
+  assert(t1 > t0);
+  assert(std::isfinite(segment));
+  assert(segment > 0.0);
+
+  // whole segments, no longer than requested
+  const double segments = std::ceil((t1 - t0) / segment);
+  assert(segments >= 1.0);
+
+  segments_ = static_cast<std::size_t>(segments);
+  dt_ = (t1 - t0) / segments;
+  invDt_ = 1.0 / dt_;
+
+  parent_.resize(bodies_);
+  for (std::size_t body = 0; body < bodies_; body++)
+    parent_[body] = system.Parent(body);
+
+  Fit(system);
+}
+
+ChebyshevEphemeris::ChebyshevEphemeris(const std::string &path)
+    : file_(new MappedFile(path)), storage_(), coefficients_(nullptr),
+      parent_(), bodies_(0), segments_(0), terms_(0), t0_(0), t1_(0),
+      dt_(0), invDt_(0) {
+  if (!Map())
+    file_.reset();
+}
@@ -0,0 +1,173 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "MappedFile.hpp" // for MappedFile
+#include "Vec3.hpp"       // for Vec3
+#include <cstddef>        // for size_t
+#include <memory>         // for unique_ptr
+#include <string>         // for string
+#include <vector>         // for vector
+
+class BodySystem;
+
+/**
+ * @brief precomputed positions of the bodies, as Chebyshev polynomials
+ *
+ * The time span is split into equal segments, and in each segment, the
+ * position of each body relative to its parent is a Chebyshev series,
+ * evaluated with the Clenshaw recurrence: finding the segment is one
+ * multiplication, and the series is 2 fused multiply-adds per coefficient
+ * per axis, with no trigonometry at all.
+ *
+ * The coefficients can be saved to a file, and later memory-mapped from
+ * it, without parsing or copying. The file is in the native byte order.
+ *
+ * The object is immutable after construction, so a single instance can be
+ * shared by all the threads.
+ *
+ * \see https://en.wikipedia.org/wiki/Chebyshev_polynomials
+ * \see https://en.wikipedia.org/wiki/Clenshaw_algorithm
+ */
+class ChebyshevEphemeris {
+private:
+  /**
+   * @brief the mapped file, if the coefficients are from the file
+   *
+   */
+  std::unique_ptr<MappedFile> file_;
+
+  /**
+   * @brief the coefficients, if they were fitted here
+   *
+   */
+  std::vector<double> storage_;
+
+  /**
+   * @brief the coefficients, [body][segment][axis][coefficient]
+   *
+   */
+  const double *coefficients_;
+
+  /**
+   * @brief index of the parent body of each body
+   *
+   */
+  std::vector<std::size_t> parent_;
+
+  std::size_t bodies_;
+  std::size_t segments_;
+
+  /**
+   * @brief number of coefficients per axis, i.e. degree + 1
+   *
+   */
+  std::size_t terms_;
+
+  /**
+   * @brief the time span [s], and the length of one segment [s]
+   *
+   */
+  double t0_;
+  double t1_;
+  double dt_;
+  double invDt_;
+
+  void Fit(const BodySystem &system);
+
+  /**
+   * @brief validates the mapped file, and points at its coefficients
+   *
+   * @return false, with the ephemeris left empty, if the file is malformed
+   */
+  bool Map();
+
+public:
+  std::size_t size() const { return bodies_; }
+  std::size_t Segments() const { return segments_; }
+  std::size_t Degree() const { return terms_ - 1; }
+  double Begin() const { return t0_; }
+  double End() const { return t1_; }
+
+  /**
+   * @brief whether there are coefficients, false if the file failed to map
+   *
+   */
+  bool valid() const { return coefficients_ != nullptr; }
+
+  /**
+   * @brief index of the parent of the given body
+   *
+   */
+  std::size_t Parent(std::size_t body) const;
+
+  /**
+   * @brief position of the body, relative to its parent [m]
+   *
+   * A time out of the span, by rounding, extrapolates the first or the last
+   * segment.
+   *
+   * @param body index of the body, as in the BodySystem
+   * @param t time, within [Begin(), End()] [s]
+   */
+  Vec3 Position(std::size_t body, double t) const;
+
+  /**
+   * @brief batched Position(), for many times, into SoA arrays
+   *
+   * @param body index of the body
+   * @param t times [s]
+   * @param x output position x coordinates [m]
+   * @param y output position y coordinates [m]
+   * @param z output position z coordinates [m]
+   * @param n number of times
+   */
+  void Position(std::size_t body, const double *t, double *x, double *y,
+                double *z, std::size_t n) const;
+
+  /**
+   * @brief saves the coefficients, for the mapping constructor
+   *
+   * @param path path to the file, it is overwritten
+   * @return false if the file could not be written completely
+   */
+  bool Save(const std::string &path) const;
+
+  /**
+   * @brief fits the orbits of all the bodies of the system
+   *
+   * @param system the bodies
+   * @param t0 start of the time span [s]
+   * @param t1 end of the time span [s]
+   * @param segment length of one segment [s]
+   * @param degree degree of the polynomials
+   */
+  ChebyshevEphemeris(const BodySystem &system, double t0, double t1,
+                     double segment, std::size_t degree);
+
+  /**
+   * @brief maps the coefficients, as written by Save()
+   *
+   * A file that is missing, truncated, not an ephemeris, or inconsistent
+   * with its header gives an empty ephemeris, see valid().
+   *
+   * @param path path to the file
+   */
+  explicit ChebyshevEphemeris(const std::string &path);
+};
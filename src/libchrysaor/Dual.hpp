@@ -0,0 +1,218 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cmath>    // for sqrt, sin, cos, exp, log, pow, atan2, ...
+#include <iostream> // for operator<<, basic_ostream, ostream
+
+/**
+ * @brief dual number, \f$a + b\varepsilon\f$, \f$\varepsilon^2 = 0\f$
+ *
+ * Forward-mode automatic differentiation: evaluating \f$f(x + \varepsilon)\f$
+ * yields \f$f(x) + f'(x)\varepsilon\f$, i.e. the exact derivative is carried
+ * along with the value, in the same pass, without finite differences.
+ *
+ * Usable as the scalar type of BasicVec3, e.g. BasicVec3<Dual<double>>.
+ *
+ * \see https://en.wikipedia.org/wiki/Dual_number
+ * \see https://en.wikipedia.org/wiki/Automatic_differentiation
+ *
+ * @tparam T underlying scalar type
+ */
+template <typename T> class Dual {
+public:
+  /**
+   * @brief the real part, value of the function
+   *
+   */
+  T val_;
+
+  /**
+   * @brief the dual part, derivative of the function
+   *
+   */
+  T eps_;
+
+  constexpr Dual operator-() const { return Dual(-val_, -eps_); }
+
+  constexpr Dual &operator+=(Dual rhs) {
+    val_ += rhs.val_;
+    eps_ += rhs.eps_;
+    return *this;
+  }
+  constexpr Dual &operator-=(Dual rhs) {
+    val_ -= rhs.val_;
+    eps_ -= rhs.eps_;
+    return *this;
+  }
+  constexpr Dual &operator*=(Dual rhs) {
+    eps_ = eps_ * rhs.val_ + val_ * rhs.eps_;
+    val_ *= rhs.val_;
+    return *this;
+  }
+  constexpr Dual &operator/=(Dual rhs) {
+    eps_ = (eps_ * rhs.val_ - val_ * rhs.eps_) / (rhs.val_ * rhs.val_);
+    val_ /= rhs.val_;
+    return *this;
+  }
+
+  /**
+   * @brief creates a constant, with zero derivative
+   *
+   * @param val the value
+   */
+  constexpr Dual(T val = T(0)) : val_(val), eps_(T(0)) {}
+
+  /**
+   * @brief creates a dual number with given value and derivative
+   *
+   * To differentiate with respect to some variable \f$x\f$, seed it with
+   * derivative of 1: Dual<double>(x, 1.0)
+   *
+   * @param val the value
+   * @param eps the derivative
+   */
+  constexpr Dual(T val, T eps) : val_(val), eps_(eps) {}
+};
+
+template <typename T> constexpr Dual<T> operator+(Dual<T> lhs, Dual<T> rhs) {
+  return lhs += rhs;
+}
+template <typename T> constexpr Dual<T> operator-(Dual<T> lhs, Dual<T> rhs) {
+  return lhs -= rhs;
+}
+template <typename T> constexpr Dual<T> operator*(Dual<T> lhs, Dual<T> rhs) {
+  return lhs *= rhs;
+}
+template <typename T> constexpr Dual<T> operator/(Dual<T> lhs, Dual<T> rhs) {
+  return lhs /= rhs;
+}
+
+template <typename T> constexpr Dual<T> operator+(Dual<T> lhs, T rhs) {
+  return Dual<T>(lhs.val_ + rhs, lhs.eps_);
+}
+template <typename T> constexpr Dual<T> operator+(T lhs, Dual<T> rhs) {
+  return Dual<T>(lhs + rhs.val_, rhs.eps_);
+}
+template <typename T> constexpr Dual<T> operator-(Dual<T> lhs, T rhs) {
+  return Dual<T>(lhs.val_ - rhs, lhs.eps_);
+}
+template <typename T> constexpr Dual<T> operator-(T lhs, Dual<T> rhs) {
+  return Dual<T>(lhs - rhs.val_, -rhs.eps_);
+}
+template <typename T> constexpr Dual<T> operator*(Dual<T> lhs, T rhs) {
+  return Dual<T>(lhs.val_ * rhs, lhs.eps_ * rhs);
+}
+template <typename T> constexpr Dual<T> operator*(T lhs, Dual<T> rhs) {
+  return Dual<T>(lhs * rhs.val_, lhs * rhs.eps_);
+}
+template <typename T> constexpr Dual<T> operator/(Dual<T> lhs, T rhs) {
+  return Dual<T>(lhs.val_ / rhs, lhs.eps_ / rhs);
+}
+template <typename T> constexpr Dual<T> operator/(T lhs, Dual<T> rhs) {
+  return Dual<T>(lhs / rhs.val_, -lhs * rhs.eps_ / (rhs.val_ * rhs.val_));
+}
+
+// only the value takes part in comparisons.
+template <typename T> constexpr bool operator==(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ == rhs.val_;
+}
+template <typename T> constexpr bool operator!=(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ != rhs.val_;
+}
+template <typename T> constexpr bool operator<(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ < rhs.val_;
+}
+template <typename T> constexpr bool operator>(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ > rhs.val_;
+}
+template <typename T> constexpr bool operator<=(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ <= rhs.val_;
+}
+template <typename T> constexpr bool operator>=(Dual<T> lhs, Dual<T> rhs) {
+  return lhs.val_ >= rhs.val_;
+}
+
+// elementary functions, found via ADL, so generic code should do
+// "using std::sqrt; sqrt(x);"
+
+template <typename T> Dual<T> sqrt(Dual<T> x) {
+  const T s = std::sqrt(x.val_);
+  return Dual<T>(s, x.eps_ / (T(2) * s));
+}
+
+template <typename T> Dual<T> sin(Dual<T> x) {
+  return Dual<T>(std::sin(x.val_), x.eps_ * std::cos(x.val_));
+}
+
+template <typename T> Dual<T> cos(Dual<T> x) {
+  return Dual<T>(std::cos(x.val_), -x.eps_ * std::sin(x.val_));
+}
+
+template <typename T> Dual<T> tan(Dual<T> x) {
+  const T t = std::tan(x.val_);
+  return Dual<T>(t, x.eps_ * (T(1) + t * t));
+}
+
+template <typename T> Dual<T> asin(Dual<T> x) {
+  return Dual<T>(std::asin(x.val_),
+                 x.eps_ / std::sqrt(T(1) - x.val_ * x.val_));
+}
+
+template <typename T> Dual<T> acos(Dual<T> x) {
+  return Dual<T>(std::acos(x.val_),
+                 -x.eps_ / std::sqrt(T(1) - x.val_ * x.val_));
+}
+
+template <typename T> Dual<T> atan(Dual<T> x) {
+  return Dual<T>(std::atan(x.val_), x.eps_ / (T(1) + x.val_ * x.val_));
+}
+
+template <typename T> Dual<T> atan2(Dual<T> y, Dual<T> x) {
+  return Dual<T>(std::atan2(y.val_, x.val_),
+                 (x.val_ * y.eps_ - y.val_ * x.eps_) /
+                     (x.val_ * x.val_ + y.val_ * y.val_));
+}
+
+template <typename T> Dual<T> exp(Dual<T> x) {
+  const T e = std::exp(x.val_);
+  return Dual<T>(e, x.eps_ * e);
+}
+
+template <typename T> Dual<T> log(Dual<T> x) {
+  return Dual<T>(std::log(x.val_), x.eps_ / x.val_);
+}
+
+template <typename T> Dual<T> pow(Dual<T> x, T p) {
+  const T xp = std::pow(x.val_, p - T(1));
+  return Dual<T>(xp * x.val_, x.eps_ * p * xp);
+}
+
+template <typename T> Dual<T> fabs(Dual<T> x) {
+  return (x.val_ < T(0)) ? -x : x;
+}
+
+template <typename T> bool isfinite(Dual<T> x) {
+  return std::isfinite(x.val_) && std::isfinite(x.eps_);
+}
+
+template <typename T>
+std::ostream &operator<<(std::ostream &os, const Dual<T> &obj) {
+  return os << obj.val_ << " + " << obj.eps_ << "e";
+}
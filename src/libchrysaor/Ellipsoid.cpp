@@ -0,0 +1,109 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Ellipsoid.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <cassert>           // for assert
+#include <cmath>             // for sin, cos, sqrt, atan2, isfinite, M_PI
+#include <cstddef>           // for size_t
+
+namespace {
+
+const double DegToRad = M_PI / 180.0;
+const double RadToDeg = 180.0 / M_PI;
+
+} // namespace
+
+Vec3 Ellipsoid::ToCartesian(double latitude, double longitude,
+                            double altitude) const {
+  const double phi = latitude * DegToRad;
+  const double lambda = longitude * DegToRad;
+
+  const double sinPhi = std::sin(phi);
+  const double cosPhi = std::cos(phi);
+
+  // prime vertical radius of curvature
+  const double N = a_ / std::sqrt(1.0 - e2_ * sinPhi * sinPhi);
+
+  const double p = (N + altitude) * cosPhi;
+
+  return Vec3(p * std::cos(lambda), p * std::sin(lambda),
+              (N * (1.0 - e2_) + altitude) * sinPhi);
+}
+
+void Ellipsoid::ToGeodetic(Vec3 r, double *latitude, double *longitude,
+                           double *altitude) const {
+  const double p2 = r.x_ * r.x_ + r.y_ * r.y_;
+  const double p = std::sqrt(p2);
+  const double rho = std::sqrt(p2 + r.z_ * r.z_);
+
+  // the starting parametric latitude, as a direction, not as an angle.
+  // the altitude-aware guess keeps the single iteration accurate far out
+  const double u = r.z_ * b_ * (1.0 + ep2_ * b_ / rho);
+  const double w = p * a_;
+  const double d = 1.0 / std::sqrt(u * u + w * w);
+  const double sinBeta = u * d;
+  const double cosBeta = w * d;
+
+  const double n = r.z_ + ep2_ * b_ * sinBeta * sinBeta * sinBeta;
+  const double m = p - e2_ * a_ * cosBeta * cosBeta * cosBeta;
+  const double D = 1.0 / std::sqrt(n * n + m * m);
+  const double sinPhi = n * D;
+  const double cosPhi = m * D;
+
+  // stable everywhere, including the poles
+  *altitude = p * cosPhi + r.z_ * sinPhi -
+              a_ * std::sqrt(1.0 - e2_ * sinPhi * sinPhi);
+  *latitude = std::atan2(n, m) * RadToDeg;
+  *longitude = std::atan2(r.y_, r.x_) * RadToDeg;
+}
+
+void Ellipsoid::ToCartesian(const double *latitude, const double *longitude,
+                            const double *altitude, double *x, double *y,
+                            double *z, std::size_t n) const {
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 r = ToCartesian(latitude[i], longitude[i], altitude[i]);
+    x[i] = r.x_;
+    y[i] = r.y_;
+    z[i] = r.z_;
+  }
+}
+
+void Ellipsoid::ToGeodetic(const double *x, const double *y, const double *z,
+                           double *latitude, double *longitude,
+                           double *altitude, std::size_t n) const {
+  for (std::size_t i = 0; i < n; i++) {
+    double lat, lon, alt;
+    ToGeodetic(Vec3(x[i], y[i], z[i]), &lat, &lon, &alt);
+    latitude[i] = lat;
+    longitude[i] = lon;
+    altitude[i] = alt;
+  }
+}
+
+Ellipsoid::Ellipsoid(double a, double f)
+    : a_(a), f_(f), b_(a * (1.0 - f)), e2_(f * (2.0 - f)),
+      ep2_(e2_ / (1.0 - e2_)) {
+  assert(std::isfinite(a));
+  assert(a >= 0.0);
+  assert(std::isfinite(f));
+  assert(f >= 0.0 && f < 1.0);
+}
+
+Ellipsoid::Ellipsoid(const CelestialBody *body) : Ellipsoid(body->R_, 0.0) {}
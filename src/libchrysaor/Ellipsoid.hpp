@@ -0,0 +1,131 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief reference ellipsoid of a body, for the geodetic coordinates
+ *
+ * Oblate spheroid with equatorial radius \f$a\f$ and flattening \f$f\f$, or
+ * a sphere, if \f$f = 0\f$. Both of the conversions are closed-form, with no
+ * branches, and the same code handles both of the shapes.
+ *
+ * Geodetic to Cartesian is exact. Cartesian to geodetic is Bowring's
+ * method with a single iteration, which is accurate to a few
+ * micrometers for the Earth, from deep inside it to far beyond the Moon.
+ *
+ * The coordinates are body-fixed, the angles are in degrees.
+ *
+ * \see https://en.wikipedia.org/wiki/Geographic_coordinate_conversion
+ * \see B. R. Bowring, "The accuracy of geodetic latitude and height
+ * equations", Survey Review, 28:218, 1985
+ */
+class Ellipsoid {
+private:
+  /**
+   * @brief equatorial radius [m]
+   *
+   */
+  double a_;
+
+  /**
+   * @brief flattening
+   *
+   */
+  double f_;
+
+  /**
+   * @brief polar radius, \f$b = a(1 - f)\f$ [m]
+   *
+   */
+  double b_;
+
+  /**
+   * @brief first eccentricity squared, \f$e^2 = f(2 - f)\f$
+   *
+   */
+  double e2_;
+
+  /**
+   * @brief second eccentricity squared, \f$e'^2 = e^2/(1 - e^2)\f$
+   *
+   */
+  double ep2_;
+
+public:
+  double EquatorialRadius() const { return a_; }
+  double PolarRadius() const { return b_; }
+  double Flattening() const { return f_; }
+
+  /**
+   * @brief geodetic coordinates to the body-fixed position
+   *
+   * @param latitude geodetic latitude [deg]
+   * @param longitude longitude [deg]
+   * @param altitude height above the ellipsoid [m]
+   * @return Vec3 position, body-fixed [m]
+   */
+  Vec3 ToCartesian(double latitude, double longitude, double altitude) const;
+
+  /**
+   * @brief body-fixed position to the geodetic coordinates
+   *
+   * @param r position, body-fixed [m]
+   * @param latitude output geodetic latitude [deg]
+   * @param longitude output longitude [deg]
+   * @param altitude output height above the ellipsoid [m]
+   */
+  void ToGeodetic(Vec3 r, double *latitude, double *longitude,
+                  double *altitude) const;
+
+  /**
+   * @brief batched ToCartesian(), over SoA arrays
+   *
+   */
+  void ToCartesian(const double *latitude, const double *longitude,
+                   const double *altitude, double *x, double *y, double *z,
+                   std::size_t n) const;
+
+  /**
+   * @brief batched ToGeodetic(), over SoA arrays, e.g. for a ground track
+   *
+   */
+  void ToGeodetic(const double *x, const double *y, const double *z,
+                  double *latitude, double *longitude, double *altitude,
+                  std::size_t n) const;
+
+  /**
+   * @brief creates the ellipsoid
+   *
+   * @param a equatorial radius [m], 0 for a point
+   * @param f flattening, 0 for a sphere
+   */
+  Ellipsoid(double a, double f);
+
+  /**
+   * @brief creates the sphere, with the radius of the body
+   *
+   * @param body the body
+   */
+  explicit Ellipsoid(const CelestialBody *body);
+};
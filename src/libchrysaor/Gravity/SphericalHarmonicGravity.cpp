@@ -0,0 +1,415 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Gravity/SphericalHarmonicGravity.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <algorithm>         // for max, min
+#include <cassert>           // for assert
+#include <cmath>             // for sqrt, abs, isfinite, NAN
+#include <cstddef>           // for size_t
+#include <cstdio>            // for fopen, fread, ferror, fclose, FILE
+#include <cstdlib>           // for strtod
+#include <istream>           // for istream
+#include <iterator>          // for istreambuf_iterator
+#include <string>            // for string
+#include <vector>            // for vector
+
+constexpr int SphericalHarmonicGravity::MaxLoadedDegree;
+constexpr double SphericalHarmonicGravity::MatchTolerance;
+
+namespace {
+
+struct Term {
+  int n;
+  int m;
+  double C;
+  double S;
+};
+
+// the numbers of a line, false unless there are exactly count of them
+bool Numbers(const char *field, double *values, int count) {
+  for (int k = 0; k < count; k++) {
+    char *next = nullptr;
+    values[k] = std::strtod(field, &next);
+    if (next == field)
+      return false;
+    field = next;
+  }
+
+  for (; *field; field++)
+    if (*field != ' ' && *field != '\t' && *field != '\r')
+      return false;
+
+  return true;
+}
+
+bool Near(double a, double b) {
+  return std::abs(a - b) <=
+         SphericalHarmonicGravity::MatchTolerance * std::abs(b);
+}
+
+} // namespace
+
+bool SphericalHarmonicGravity::Parse(const std::string &text,
+                                     const CelestialBody *body) {
+  bool header = false;
+  double mu = 0.0;
+  double R = 0.0;
+  int degree = 0;
+  std::vector<Term> terms;
+
+  std::size_t begin = 0;
+  while (begin < text.size()) {
+    std::size_t end = text.find('\n', begin);
+    if (end == std::string::npos)
+      end = text.size();
+
+    const std::string line = text.substr(begin, end - begin);
+    begin = end + 1;
+
+    const std::size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#')
+      continue;
+
+    if (!header) {
+      double values[2];
+      if (!Numbers(line.c_str(), values, 2))
+        return false;
+
+      mu = values[0];
+      R = values[1];
+      header = true;
+      continue;
+    }
+
+    double values[4];
+    if (!Numbers(line.c_str(), values, 4))
+      return false;
+
+    // the degree and the order are integers, within the limits
+    if (!(values[0] >= 0.0 && values[0] <= MaxLoadedDegree) ||
+        !(values[1] >= 0.0 && values[1] <= values[0]) ||
+        values[0] != static_cast<int>(values[0]) ||
+        values[1] != static_cast<int>(values[1]))
+      return false;
+
+    if (!std::isfinite(values[2]) || !std::isfinite(values[3]))
+      return false;
+
+    const Term term = {static_cast<int>(values[0]),
+                       static_cast<int>(values[1]), values[2], values[3]};
+    terms.push_back(term);
+    degree = std::max(degree, term.n);
+  }
+
+  if (!header || !std::isfinite(mu) || !(mu > 0.0) || !std::isfinite(R) ||
+      !(R > 0.0))
+    return false;
+
+  if (body && !(Near(mu, body->mu_) && Near(R, body->R_)))
+    return false;
+
+  mu_ = mu;
+  R_ = R;
+  loadedDegree_ = degree;
+
+  const std::size_t size = Index(degree + 1, 0) + 1;
+  C_.assign(size, 0.0);
+  S_.assign(size, 0.0);
+  C_[Index(0, 0)] = 1.0;
+  for (const Term &term : terms) {
+    C_[Index(term.n, term.m)] = term.C;
+    S_[Index(term.n, term.m)] = term.S;
+  }
+
+  Build();
+  return true;
+}
+
+void SphericalHarmonicGravity::Build() {
+  const int N = loadedDegree_;
+
+  // one extra element, so that A(n, m+1) can be read without a branch even
+  // for m = n, where its weight d(n, n) is zero.
+  const std::size_t size = Index(N + 1, 0) + 1;
+
+  a_.assign(size, 0.0);
+  b_.assign(size, 0.0);
+  d_.assign(size, 0.0);
+  for (int n = 1; n <= N; n++) {
+    const double dn = n;
+
+    for (int m = 0; m < n; m++) {
+      const double dm = m;
+
+      a_[Index(n, m)] = std::sqrt(((2.0 * dn + 1.0) * (2.0 * dn - 1.0)) /
+                                  ((dn - dm) * (dn + dm)));
+
+      if (m <= n - 2) {
+        b_[Index(n, m)] = std::sqrt(
+            ((2.0 * dn + 1.0) * (dn + dm - 1.0) * (dn - dm - 1.0)) /
+            ((2.0 * dn - 3.0) * (dn - dm) * (dn + dm)));
+      }
+
+      d_[Index(n, m)] =
+          std::sqrt((m == 0 ? 0.5 : 1.0) * (dn + dm + 1.0) * (dn - dm));
+    }
+
+    // the sectoral ones, A(n, n) = a(n, n) * A(n-1, n-1)
+    a_[Index(n, n)] = (n == 1) ? std::sqrt(3.0)
+                               : std::sqrt((2.0 * dn + 1.0) / (2.0 * dn));
+  }
+
+  Truncate(N, N);
+}
+
+SphericalHarmonicGravity::Workspace::Workspace()
+    : A_(), re_(), im_(), u_(NAN), s_(NAN), t_(NAN), degree_(-1),
+      order_(-1) {}
+
+SphericalHarmonicGravity::Workspace *SphericalHarmonicGravity::Local() {
+  thread_local Workspace workspace;
+  return &workspace;
+}
+
+void SphericalHarmonicGravity::Update(double s, double t, double u,
+                                      Workspace *workspace) const {
+  Workspace &w = *workspace;
+
+  // grown for this model, the tables of the other degree are of no use
+  const std::size_t size = a_.size();
+  const std::size_t orders = static_cast<std::size_t>(loadedDegree_ + 1);
+  if (w.A_.size() < size || w.re_.size() < orders) {
+    w.A_.resize(std::max(w.A_.size(), size), 0.0);
+    w.re_.resize(std::max(w.re_.size(), orders), 0.0);
+    w.im_.resize(std::max(w.im_.size(), orders), 0.0);
+    w.degree_ = -1;
+  }
+  if (w.degree_ != maxDegree_ || w.order_ != maxOrder_) {
+    w.u_ = NAN;
+    w.s_ = NAN;
+    w.t_ = NAN;
+    w.degree_ = maxDegree_;
+    w.order_ = maxOrder_;
+  }
+
+  if (u != w.u_) {
+    const int M = maxOrder_ + 1;
+    double *A = w.A_.data();
+
+    // b(n, m) is zero whenever A(n-2, m) does not exist, and the index is
+    // still within the table, so no branch is needed there.
+    A[Index(0, 0)] = 1.0;
+    for (int n = 1; n <= maxDegree_; n++) {
+      const int last = std::min(n - 1, M);
+      for (int m = 0; m <= last; m++) {
+        const std::size_t i = Index(n, m);
+        A[i] = a_[i] * u * A[Index(n - 1, m)] -
+               b_[i] * A[Index(std::max(n - 2, 0), m)];
+      }
+
+      if (n <= M)
+        A[Index(n, n)] = a_[Index(n, n)] * A[Index(n - 1, n - 1)];
+    }
+
+    w.u_ = u;
+  }
+
+  if (s != w.s_ || t != w.t_) {
+    double *re = w.re_.data();
+    double *im = w.im_.data();
+
+    re[0] = 1.0;
+    im[0] = 0.0;
+    for (int m = 1; m <= maxOrder_; m++) {
+      re[m] = s * re[m - 1] - t * im[m - 1];
+      im[m] = s * im[m - 1] + t * re[m - 1];
+    }
+
+    w.s_ = s;
+    w.t_ = t;
+  }
+}
+
+double SphericalHarmonicGravity::C(int n, int m) const {
+  assert(n >= 0 && n <= loadedDegree_);
+  assert(m >= 0 && m <= n);
+
+  return C_[Index(n, m)];
+}
+
+double SphericalHarmonicGravity::S(int n, int m) const {
+  assert(n >= 0 && n <= loadedDegree_);
+  assert(m >= 0 && m <= n);
+
+  return S_[Index(n, m)];
+}
+
+void SphericalHarmonicGravity::Truncate(int maxDegree, int maxOrder) {
+  assert(maxDegree >= 0 && maxDegree <= loadedDegree_);
+  assert(maxOrder >= 0 && maxOrder <= maxDegree);
+
+  maxDegree_ = maxDegree;
+  maxOrder_ = maxOrder;
+}
+
+double SphericalHarmonicGravity::Potential(Vec3 r) const {
+  return Potential(r, Local());
+}
+
+double SphericalHarmonicGravity::Potential(Vec3 r,
+                                           Workspace *workspace) const {
+  assert(workspace);
+
+  const double ir = 1.0 / r.norm();
+
+  Update(r.x_ * ir, r.y_ * ir, r.z_ * ir, workspace);
+  const double *A_ = workspace->A_.data();
+  const double *re_ = workspace->re_.data();
+  const double *im_ = workspace->im_.data();
+
+  const double q = R_ * ir;
+  double rho = mu_ * ir;
+
+  double U = 0.0;
+  for (int n = 0; n <= maxDegree_; n++) {
+    const int M = std::min(n, maxOrder_);
+
+    double sum = 0.0;
+    for (int m = 0; m <= M; m++) {
+      const std::size_t i = Index(n, m);
+      sum += A_[i] * (C_[i] * re_[m] + S_[i] * im_[m]);
+    }
+
+    U += rho * sum;
+    rho *= q;
+  }
+
+  return U;
+}
+
+Vec3 SphericalHarmonicGravity::Acceleration(Vec3 r) const {
+  return Acceleration(r, Local());
+}
+
+Vec3 SphericalHarmonicGravity::Acceleration(Vec3 r,
+                                            Workspace *workspace) const {
+  assert(workspace);
+
+  const double ir = 1.0 / r.norm();
+
+  const double s = r.x_ * ir;
+  const double t = r.y_ * ir;
+  const double u = r.z_ * ir;
+
+  Update(s, t, u, workspace);
+  const double *A_ = workspace->A_.data();
+  const double *re_ = workspace->re_.data();
+  const double *im_ = workspace->im_.data();
+
+  const double q = R_ * ir;
+  double rho = mu_ * ir;
+
+  double a1 = 0.0;
+  double a2 = 0.0;
+  double a3 = 0.0;
+  double a4 = 0.0;
+
+  for (int n = 0; n <= maxDegree_; n++) {
+    const int M = std::min(n, maxOrder_);
+
+    // m = 0, with no sectoral terms
+    std::size_t i = Index(n, 0);
+    double D = C_[i];
+    double sumD = A_[i] * D;
+    double sum1 = 0.0;
+    double sum2 = 0.0;
+    double sum3 = d_[i] * A_[i + 1] * D;
+
+    for (int m = 1; m <= M; m++) {
+      i++;
+
+      const double C = C_[i];
+      const double S = S_[i];
+      const double A = A_[i];
+
+      D = C * re_[m] + S * im_[m];
+      const double E = C * re_[m - 1] + S * im_[m - 1];
+      const double F = S * re_[m - 1] - C * im_[m - 1];
+
+      sumD += A * D;
+      sum1 += m * A * E;
+      sum2 += m * A * F;
+      sum3 += d_[i] * A_[i + 1] * D;
+    }
+
+    a1 += rho * sum1;
+    a2 += rho * sum2;
+    a3 += rho * sum3;
+    a4 -= rho * (n + 1) * sumD;
+
+    rho *= q;
+  }
+
+  // the gradient over s, t, u, plus the radial part
+  const double radial = a4 - (s * a1 + t * a2 + u * a3);
+
+  return Vec3(a1 + radial * s, a2 + radial * t, a3 + radial * u) * ir;
+}
+
+bool SphericalHarmonicGravity::Matches(const CelestialBody &body) const {
+  return Near(mu_, body.mu_) && Near(R_, body.R_);
+}
+
+bool SphericalHarmonicGravity::Load(std::istream &in,
+                                    const CelestialBody *body) {
+  const std::string text((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+  if (in.bad())
+    return false;
+
+  return Parse(text, body);
+}
+
+bool SphericalHarmonicGravity::Load(const std::string &path,
+                                    const CelestialBody *body) {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file)
+    return false;
+
+  std::string text;
+  char chunk[128];
+  std::size_t size;
+  while ((size = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    text.append(chunk, size);
+
+  const bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  if (failed)
+    return false;
+
+  return Parse(text, body);
+}
+
+SphericalHarmonicGravity::SphericalHarmonicGravity()
+    : mu_(0), R_(0), loadedDegree_(0), maxDegree_(0), maxOrder_(0),
+      C_(Index(1, 0) + 1, 0.0), S_(Index(1, 0) + 1, 0.0), a_(), b_(), d_() {
+  C_[Index(0, 0)] = 1.0;
+  Build();
+}
@@ -0,0 +1,320 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <iosfwd>   // for istream
+#include <string>   // for string
+#include <vector>   // for vector
+
+class CelestialBody;
+
+/**
+ * @brief gravity field, as a spherical harmonics expansion
+ *
+ * \f$U = {\mu\over{r}}\sum_{n=0}^{N}\left({R\over{r}}\right)^n
+ * \sum_{m=0}^{n}\bar{P}_{nm}(\sin\phi)\left(\bar{C}_{nm}\cos{m\lambda} +
+ * \bar{S}_{nm}\sin{m\lambda}\right)\f$
+ *
+ * with fully normalized coefficients (geodesy convention, no Condon-Shortley
+ * phase), as in the EGM/ICGEM gravity models.
+ *
+ * The acceleration is evaluated in Pines' formulation, which has no
+ * singularity at the poles: the normalized derived Legendre functions
+ * \f$\bar{A}_{nm}(u)\f$ of \f$u = z/r\f$ are built with the stable
+ * column-wise recursion, and the \f$\cos^m\phi\cos{m\lambda}\f$,
+ * \f$\cos^m\phi\sin{m\lambda}\f$ multiples are built by complex
+ * multiplication from \f$x/r\f$, \f$y/r\f$, with no trigonometric calls.
+ * All the recursion coefficients are precomputed on load.
+ *
+ * The position is in the body-fixed frame.
+ *
+ * The Legendre table and the longitude multiples live in a Workspace, owned
+ * by the caller, or a thread-local one for the calls without it, so the
+ * model itself is immutable after the load, and one model serves any number
+ * of threads. The workspace grows once, to the largest model it has
+ * evaluated, and keeps the tables of the last direction: they are reused
+ * when only the radius changes, or when Potential() and Acceleration() are
+ * both taken at the same point. They are not reused for merely nearby
+ * directions, as in the successive integration steps: the Legendre functions
+ * of a different \f$u\f$ are a different table, and patching it would cost
+ * as much as the recursion itself.
+ *
+ * \see https://en.wikipedia.org/wiki/Geopotential_model
+ * \see S. Pines, "Uniform Representation of the Gravitational Potential and
+ * its Derivatives", AIAA Journal, Vol. 11, No. 11, 1973
+ */
+class SphericalHarmonicGravity {
+public:
+  /**
+   * @brief the scratch of the evaluation, and the cache of its last direction
+   *
+   * The tables depend on the direction, and on the evaluated degree and
+   * order, not on the coefficients, so one workspace serves any models. Not
+   * to be shared between the threads.
+   */
+  class Workspace {
+  public:
+    /**
+     * @brief normalized derived Legendre functions \f$\bar{A}_{nm}(u)\f$
+     *
+     */
+    std::vector<double> A_;
+
+    /**
+     * @brief \f$(s + it)^m\f$, real and imaginary parts
+     *
+     */
+    std::vector<double> re_;
+    std::vector<double> im_;
+
+    /**
+     * @brief the direction for which A_, re_ and im_ are valid
+     *
+     */
+    double u_;
+    double s_;
+    double t_;
+
+    /**
+     * @brief the degree and the order for which they are valid
+     *
+     */
+    int degree_;
+    int order_;
+
+    /**
+     * @brief empty workspace, it grows on the first evaluation
+     *
+     */
+    Workspace();
+  };
+
+  /**
+   * @brief the maximal degree that Load() accepts
+   *
+   */
+  static constexpr int MaxLoadedDegree = 6000;
+
+  /**
+   * @brief the relative difference of \f$\mu\f$ and of the radius that
+   * Matches() tolerates, between the different realizations of one body
+   *
+   */
+  static constexpr double MatchTolerance = 1e-4;
+
+private:
+  /**
+   * @brief standard gravitational parameter of the model [m^3/s^2]
+   *
+   */
+  double mu_;
+
+  /**
+   * @brief reference radius of the model [m]
+   *
+   */
+  double R_;
+
+  /**
+   * @brief maximal degree of the loaded coefficients
+   *
+   */
+  int loadedDegree_;
+
+  /**
+   * @brief maximal degree and order that are actually evaluated
+   *
+   */
+  int maxDegree_;
+  int maxOrder_;
+
+  /**
+   * @brief normalized coefficients, triangular, (n, m) at n(n+1)/2+m
+   *
+   */
+  std::vector<double> C_;
+  std::vector<double> S_;
+
+  /**
+   * @brief column recursion coefficients of the Legendre functions
+   *
+   * \f$\bar{A}_{nm} = a_{nm}u\bar{A}_{n-1,m} - b_{nm}\bar{A}_{n-2,m}\f$
+   */
+  std::vector<double> a_;
+  std::vector<double> b_;
+
+  /**
+   * @brief derivative ratio, \f$\sqrt{{2-\delta_{0m}}\over{2}(n+m+1)(n-m)}\f$
+   *
+   * \f$\bar{C}_{nm}\bar{A}_{n,m+1}d_{nm}\f$ is the \f$u\f$-derivative term
+   */
+  std::vector<double> d_;
+
+  static std::size_t Index(int n, int m) {
+    return static_cast<std::size_t>(n * (n + 1) / 2 + m);
+  }
+
+  /**
+   * @brief parses the text, and replaces the model with it
+   *
+   * @param text the coefficients
+   * @param body the body to match, or nullptr
+   * @return false, with the model unchanged, if the text is malformed
+   */
+  bool Parse(const std::string &text, const CelestialBody *body);
+
+  /**
+   * @brief the recursion coefficients, for the loaded degree
+   *
+   */
+  void Build();
+
+  /**
+   * @brief brings the workspace to the direction
+   *
+   */
+  void Update(double s, double t, double u, Workspace *workspace) const;
+
+  /**
+   * @brief the thread-local workspace, of the calls without one
+   *
+   */
+  static Workspace *Local();
+
+public:
+  /**
+   * @brief standard gravitational parameter of the model [m^3/s^2]
+   *
+   */
+  double mu() const { return mu_; }
+
+  /**
+   * @brief reference radius of the model [m]
+   *
+   */
+  double R() const { return R_; }
+
+  /**
+   * @brief maximal degree of the loaded coefficients
+   *
+   */
+  int LoadedDegree() const { return loadedDegree_; }
+
+  int MaxDegree() const { return maxDegree_; }
+  int MaxOrder() const { return maxOrder_; }
+
+  /**
+   * @brief normalized coefficient \f$\bar{C}_{nm}\f$
+   *
+   */
+  double C(int n, int m) const;
+
+  /**
+   * @brief normalized coefficient \f$\bar{S}_{nm}\f$
+   *
+   */
+  double S(int n, int m) const;
+
+  /**
+   * @brief limits the evaluated terms, trading accuracy for speed
+   *
+   * The per-call cost is roughly proportional to the number of (n, m) terms,
+   * i.e. to \f$N \cdot M\f$. Does not reallocate anything.
+   *
+   * @param maxDegree maximal degree N, up to LoadedDegree()
+   * @param maxOrder maximal order M, up to maxDegree
+   */
+  void Truncate(int maxDegree, int maxOrder);
+
+  /**
+   * @brief gravitational potential [m^2/s^2]
+   *
+   * @param r position, body-fixed [m]
+   */
+  double Potential(Vec3 r) const;
+
+  /**
+   * @brief Potential(), in the given workspace
+   *
+   * @param r position, body-fixed [m]
+   * @param workspace the scratch, of this thread
+   */
+  double Potential(Vec3 r, Workspace *workspace) const;
+
+  /**
+   * @brief gravitational acceleration vector, gradient of Potential() [m/s^2]
+   *
+   * @param r position, body-fixed [m]
+   * @return Vec3 acceleration, body-fixed [m/s^2]
+   */
+  Vec3 Acceleration(Vec3 r) const;
+
+  /**
+   * @brief Acceleration(), in the given workspace
+   *
+   * @param r position, body-fixed [m]
+   * @param workspace the scratch, of this thread
+   * @return Vec3 acceleration, body-fixed [m/s^2]
+   */
+  Vec3 Acceleration(Vec3 r, Workspace *workspace) const;
+
+  /**
+   * @brief whether the model is of the body, \f$\mu\f$ and the radius
+   * within MatchTolerance
+   *
+   * @param body the body
+   */
+  bool Matches(const CelestialBody &body) const;
+
+  /**
+   * @brief loads the model from a stream
+   *
+   * Plain-text format. Empty lines and lines starting with # are ignored.
+   * The first line has \f$\mu\f$ [m^3/s^2] and the reference radius [m],
+   * every following line is one "n m C S" coefficient. Missing coefficients
+   * are zero, except for \f$\bar{C}_{00}\f$, which defaults to 1.
+   *
+   * The file is the input, not a precondition: a missing header, a line
+   * that is not four numbers, a degree over MaxLoadedDegree, an order out of
+   * [0, n], a non-finite or non-positive \f$\mu\f$ or radius, or a model of
+   * another body fail the load, and leave the model as it was.
+   *
+   * @param in the stream
+   * @param body the body that the model is for, its \f$\mu\f$ and radius
+   * must match those of the file, or nullptr not to check
+   * @return bool whether the model was loaded
+   */
+  bool Load(std::istream &in, const CelestialBody *body = nullptr);
+
+  /**
+   * @brief loads the model from a file, see the stream Load()
+   *
+   * @param path path to the coefficients file
+   * @param body the body that the model is for, or nullptr not to check
+   * @return bool whether the file was read, and the model loaded
+   */
+  bool Load(const std::string &path, const CelestialBody *body = nullptr);
+
+  /**
+   * @brief the empty model, no field at all, until Load()
+   *
+   */
+  SphericalHarmonicGravity();
+};
@@ -0,0 +1,107 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Gravity/ZonalGravity.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <cassert>           // for assert
+#include <cmath>             // for isfinite, sqrt
+#include <cstddef>           // for size_t
+
+// Gradient of the potential, with t = (z/r)^2:
+//
+// a_x = -mu*x/r^3 * (1 - h)
+// a_y = -mu*y/r^3 * (1 - h)
+// a_z = -mu/r^3 * (z * (1 - h_z) - r * h_r)
+//
+// J2: h   = -3/2 J2 (R/r)^2 (1 - 5t)
+//     h_z = -3/2 J2 (R/r)^2 (3 - 5t)
+// J3: h   = -5/2 J3 (R/r)^3 (z/r) (3 - 7t)
+//     h_r = -5/2 J3 (R/r)^3 (6t - 7t^2 - 3/5)
+// J4: h   = 15/8 J4 (R/r)^4 (1 - 14t + 21t^2)
+//     h_z = 15/8 J4 (R/r)^4 (5 - 70/3 t + 21t^2)
+//
+// See Vallado, "Fundamentals of Astrodynamics and Applications", 8.7.1
+
+static inline void ZonalKernel(double mu, double R, double J2, double J3,
+                               double J4, double x, double y, double z,
+                               double *ax, double *ay, double *az) {
+  const double r2 = x * x + y * y + z * z;
+  const double ir2 = 1.0 / r2;
+  const double ir = std::sqrt(ir2);
+
+  const double k = -mu * ir2 * ir;
+
+  const double s = z * ir;
+  const double t = s * s;
+
+  const double q2 = R * R * ir2;
+  const double q3 = q2 * R * ir;
+  const double q4 = q2 * q2;
+
+  const double c2 = -1.5 * J2 * q2;
+  const double c3 = -2.5 * J3 * q3;
+  const double c4 = 1.875 * J4 * q4;
+
+  const double h =
+      c2 * (1.0 - 5.0 * t) + c3 * s * (3.0 - 7.0 * t) +
+      c4 * (1.0 - 14.0 * t + 21.0 * t * t);
+  const double hz =
+      c2 * (3.0 - 5.0 * t) + c4 * (5.0 - (70.0 / 3.0) * t + 21.0 * t * t);
+  const double hr = c3 * (6.0 * t - 7.0 * t * t - 0.6);
+
+  *ax = k * x * (1.0 - h);
+  *ay = k * y * (1.0 - h);
+  *az = k * (z * (1.0 - hz) - hr / ir);
+}
+
+Vec3 ZonalGravity::Acceleration(Vec3 r) const {
+  Vec3 a;
+  ZonalKernel(mu_, R_, J2_, J3_, J4_, r.x_, r.y_, r.z_, &a.x_, &a.y_, &a.z_);
+  return a;
+}
+
+void ZonalGravity::Acceleration(const double *x, const double *y,
+                                const double *z, double *ax, double *ay,
+                                double *az, std::size_t n) const {
+  const double mu = mu_;
+  const double R = R_;
+  const double J2 = J2_;
+  const double J3 = J3_;
+  const double J4 = J4_;
+
+  for (std::size_t i = 0; i < n; i++) {
+    double rx, ry, rz;
+    ZonalKernel(mu, R, J2, J3, J4, x[i], y[i], z[i], &rx, &ry, &rz);
+    ax[i] = rx;
+    ay[i] = ry;
+    az[i] = rz;
+  }
+}
+
+ZonalGravity::ZonalGravity(const CelestialBody *parentBody, double J2,
+                           double J3, double J4)
+    : mu_(0), R_(0), J2_(J2), J3_(J3), J4_(J4) {
+  assert(parentBody);
+  mu_ = parentBody->mu_;
+  R_ = parentBody->R_;
+
+  assert(std::isfinite(J2));
+  assert(std::isfinite(J3));
+  assert(std::isfinite(J4));
+}
@@ -0,0 +1,100 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief gravity of an axially symmetric (oblate) body
+ *
+ * Point mass, plus the zonal harmonics \f$J_2\f$, \f$J_3\f$ and \f$J_4\f$
+ * of the gravitational potential:
+ *
+ * \f$U = {\mu\over{r}}\left(1 - \sum_{n=2}^{4}J_n\left({R\over{r}}\right)^n
+ * P_n(\sin\phi)\right)\f$
+ *
+ * The position is in any frame with Z axis along the body's rotation axis;
+ * since zonal terms do not depend on the longitude, it does not matter
+ * whether it is inertial or body-fixed.
+ *
+ * All the terms are always evaluated, there are no branches on whether some
+ * coefficient is zero, so the batched loop stays branch-free, and costs
+ * just a few multiplications more than the point mass.
+ *
+ * \see https://en.wikipedia.org/wiki/Geopotential_model
+ */
+class ZonalGravity {
+private:
+  /**
+   * @brief standard gravitational parameter of the body [m^3/s^2]
+   *
+   */
+  double mu_;
+
+  /**
+   * @brief reference (equatorial) radius of the body [m]
+   *
+   */
+  double R_;
+
+  /**
+   * @brief zonal harmonics coefficients (unnormalized)
+   *
+   */
+  double J2_;
+  double J3_;
+  double J4_;
+
+public:
+  /**
+   * @brief gravitational acceleration vector [m/s^2]
+   *
+   * @param r position, relative to the center of the body [m]
+   * @return Vec3 acceleration [m/s^2]
+   */
+  Vec3 Acceleration(Vec3 r) const;
+
+  /**
+   * @brief batched Acceleration(Vec3), over SoA arrays
+   *
+   * @param x position x coordinates [m]
+   * @param y position y coordinates [m]
+   * @param z position z coordinates [m]
+   * @param ax output acceleration x components [m/s^2]
+   * @param ay output acceleration y components [m/s^2]
+   * @param az output acceleration z components [m/s^2]
+   * @param n number of positions
+   */
+  void Acceleration(const double *x, const double *y, const double *z,
+                    double *ax, double *ay, double *az, std::size_t n) const;
+
+  /**
+   * @brief creates zonal gravity model of given body
+   *
+   * @param parentBody the body, gives \f$\mu\f$ and \f$R\f$
+   * @param J2 second zonal harmonic, oblateness
+   * @param J3 third zonal harmonic, pear shape
+   * @param J4 fourth zonal harmonic
+   */
+  ZonalGravity(const CelestialBody *parentBody, double J2, double J3 = 0.0,
+               double J4 = 0.0);
+};
@@ -0,0 +1,288 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImpulsiveTransfer.hpp"
+#include "CelestialBody.hpp"                 // for CelestialBody
+#include "OrbitalElements/SemiMajorAxis.hpp" // for SemiMajorAxis
+#include "OrbitalElements/SpecificOrbitalEnergy.hpp" // for SpecificOrbitalEnergy
+#include "Simd.hpp"                          // for Simd
+#include "SimdMath.hpp"                      // for SimdSqrt
+#include <cassert>                           // for assert
+#include <cmath>                             // for sqrt, cos, sin, abs, M_PI
+#include <cstring>                           // for memcpy
+
+constexpr int ImpulsiveTransfer::MaxSplitSteps;
+
+namespace {
+
+// the step of the split below which the search stops
+const double SplitTolerance = 1e-14;
+
+typedef Simd<double>::type V;
+
+// the speed at r on the orbit of the given energy, vis-viva
+double Speed(SpecificOrbitalEnergy epsilon, double r, double mu) {
+  return std::sqrt(2.0 * (epsilon + mu / r));
+}
+
+double HalfPeriod(SemiMajorAxis a, double mu) {
+  return M_PI * std::sqrt(a * a * a / mu);
+}
+
+// the burn that turns va into vb, theta apart
+double Burn(double va, double vb, double theta) {
+  return std::sqrt(va * va + vb * vb - 2.0 * va * vb * std::cos(theta));
+}
+
+// the total of the two burns, with s of the plane change at the first one
+double Cost(double v1, double vp, double va, double v2, double di, double s) {
+  return Burn(v1, vp, s * di) + Burn(va, v2, (1.0 - s) * di);
+}
+
+// the split that minimizes Cost(), see ImpulsiveTransfer.hpp
+double BestSplit(double v1, double vp, double va, double v2, double di) {
+  const double A = v1 * vp;
+  const double C = va * v2;
+
+  // the derivative goes from negative at 0 to positive at 1
+  double lo = 0.0;
+  double hi = 1.0;
+  double s = 0.5;
+  for (int step = 0; step < ImpulsiveTransfer::MaxSplitSteps; step++) {
+    const double t1 = s * di;
+    const double t2 = (1.0 - s) * di;
+    const double d1 = Burn(v1, vp, t1);
+    const double d2 = Burn(va, v2, t2);
+    const double s1 = std::sin(t1), c1 = std::cos(t1);
+    const double s2 = std::sin(t2), c2 = std::cos(t2);
+
+    // the derivative over di, and the second derivative over di^2
+    const double g = A * s1 / d1 - C * s2 / d2;
+    const double gp = A * (c1 * d1 * d1 - A * s1 * s1) / (d1 * d1 * d1) +
+                      C * (c2 * d2 * d2 - C * s2 * s2) / (d2 * d2 * d2);
+
+    if (g < 0.0)
+      lo = s;
+    else
+      hi = s;
+
+    double next = s - g / (gp * di);
+    if (!(gp > 0.0) || !(next > lo && next < hi))
+      next = 0.5 * (lo + hi);
+
+    const double change = std::abs(next - s);
+    s = next;
+    if (change < SplitTolerance)
+      break;
+  }
+
+  // the stationary point may be a maximum, if there is no interior minimum
+  const double cost = Cost(v1, vp, va, v2, di, s);
+  if (Cost(v1, vp, va, v2, di, 0.0) < cost)
+    s = 0.0;
+  if (Cost(v1, vp, va, v2, di, 1.0) < Cost(v1, vp, va, v2, di, s))
+    s = 1.0;
+  return s;
+}
+
+// one block of the batched Hohmann transfers, call-free
+__attribute__((noinline)) void HohmannBlock(double mu, const double *r1,
+                                            const double *r2, double *dv,
+                                            double *tof) {
+  const V zero = {};
+
+  V ra, rb;
+  std::memcpy(&ra, r1, sizeof(V));
+  std::memcpy(&rb, r2, sizeof(V));
+
+  const V a = 0.5 * (ra + rb);
+  V v1, v2, vp, va, t;
+  SimdSqrt(mu / ra, &v1);
+  SimdSqrt(mu / rb, &v2);
+  SimdSqrt(mu * (2.0 / ra - 1.0 / a), &vp);
+  SimdSqrt(mu * (2.0 / rb - 1.0 / a), &va);
+  SimdSqrt(a * a * a / mu, &t);
+
+  const V d1 = vp - v1;
+  const V d2 = v2 - va;
+  const V total = (d1 < zero ? -d1 : d1) + (d2 < zero ? -d2 : d2);
+  t *= M_PI;
+
+  std::memcpy(dv, &total, sizeof(V));
+  std::memcpy(tof, &t, sizeof(V));
+}
+
+// one block of the batched bi-elliptic transfers, call-free
+__attribute__((noinline)) void BiEllipticBlock(double mu, const double *r1,
+                                               const double *r2,
+                                               const double *rb, double *dv,
+                                               double *tof) {
+  const V zero = {};
+
+  V ri, rf, rm;
+  std::memcpy(&ri, r1, sizeof(V));
+  std::memcpy(&rf, r2, sizeof(V));
+  std::memcpy(&rm, rb, sizeof(V));
+
+  const V a1 = 0.5 * (ri + rm);
+  const V a2 = 0.5 * (rf + rm);
+  V v1, v2, p1, b1, b2, p2, t1, t2;
+  SimdSqrt(mu / ri, &v1);
+  SimdSqrt(mu / rf, &v2);
+  SimdSqrt(mu * (2.0 / ri - 1.0 / a1), &p1);
+  SimdSqrt(mu * (2.0 / rm - 1.0 / a1), &b1);
+  SimdSqrt(mu * (2.0 / rm - 1.0 / a2), &b2);
+  SimdSqrt(mu * (2.0 / rf - 1.0 / a2), &p2);
+  SimdSqrt(a1 * a1 * a1 / mu, &t1);
+  SimdSqrt(a2 * a2 * a2 / mu, &t2);
+
+  const V d1 = p1 - v1;
+  const V d2 = b2 - b1;
+  const V d3 = v2 - p2;
+  const V total = (d1 < zero ? -d1 : d1) + (d2 < zero ? -d2 : d2) +
+                  (d3 < zero ? -d3 : d3);
+  const V t = M_PI * (t1 + t2);
+
+  std::memcpy(dv, &total, sizeof(V));
+  std::memcpy(tof, &t, sizeof(V));
+}
+
+} // namespace
+
+ImpulsiveTransfer ImpulsiveTransfer::Hohmann(double r1, double r2,
+                                             const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(parentBody->mu_ > 0.0);
+  assert(r1 > 0.0 && r2 > 0.0);
+
+  const double mu = parentBody->mu_;
+  const SemiMajorAxis a(r1, r2);
+  const SpecificOrbitalEnergy epsilon(a, parentBody);
+
+  ImpulsiveTransfer transfer;
+  transfer.dv1_ = std::abs(Speed(epsilon, r1, mu) - std::sqrt(mu / r1));
+  transfer.dv2_ = std::abs(std::sqrt(mu / r2) - Speed(epsilon, r2, mu));
+  transfer.dv_ = transfer.dv1_ + transfer.dv2_;
+  transfer.tof_ = HalfPeriod(a, mu);
+  return transfer;
+}
+
+ImpulsiveTransfer
+ImpulsiveTransfer::BiElliptic(double r1, double r2, double rb,
+                              const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(parentBody->mu_ > 0.0);
+  assert(r1 > 0.0 && r2 > 0.0);
+  assert(rb >= r1 && rb >= r2);
+
+  const double mu = parentBody->mu_;
+  const SemiMajorAxis a1(rb, r1);
+  const SemiMajorAxis a2(rb, r2);
+  const SpecificOrbitalEnergy epsilon1(a1, parentBody);
+  const SpecificOrbitalEnergy epsilon2(a2, parentBody);
+
+  ImpulsiveTransfer transfer;
+  transfer.dv1_ = std::abs(Speed(epsilon1, r1, mu) - std::sqrt(mu / r1));
+  transfer.dv2_ =
+      std::abs(Speed(epsilon2, rb, mu) - Speed(epsilon1, rb, mu));
+  transfer.dv3_ = std::abs(std::sqrt(mu / r2) - Speed(epsilon2, r2, mu));
+  transfer.dv_ = transfer.dv1_ + transfer.dv2_ + transfer.dv3_;
+  transfer.tof_ = HalfPeriod(a1, mu) + HalfPeriod(a2, mu);
+  return transfer;
+}
+
+ImpulsiveTransfer
+ImpulsiveTransfer::PlaneChange(double r1, double r2, double di,
+                               const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(parentBody->mu_ > 0.0);
+  assert(r1 > 0.0 && r2 > 0.0);
+  assert(di >= 0.0 && di <= M_PI);
+
+  const double mu = parentBody->mu_;
+  const SemiMajorAxis a(r1, r2);
+  const SpecificOrbitalEnergy epsilon(a, parentBody);
+
+  const double v1 = std::sqrt(mu / r1);
+  const double v2 = std::sqrt(mu / r2);
+  const double vp = Speed(epsilon, r1, mu);
+  const double va = Speed(epsilon, r2, mu);
+
+  ImpulsiveTransfer transfer;
+  // on the same orbit, it is just the one burn
+  if (di > 0.0 && r1 != r2)
+    transfer.split_ = BestSplit(v1, vp, va, v2, di);
+  else
+    transfer.split_ = 1.0;
+
+  transfer.dv1_ = Burn(v1, vp, transfer.split_ * di);
+  transfer.dv2_ = Burn(va, v2, (1.0 - transfer.split_) * di);
+  transfer.dv_ = transfer.dv1_ + transfer.dv2_;
+  transfer.tof_ = HalfPeriod(a, mu);
+  return transfer;
+}
+
+void ImpulsiveTransfer::Hohmann(const CelestialBody *parentBody,
+                                const double *r1, const double *r2,
+                                double *dv, double *tof, std::size_t n) {
+  assert(parentBody);
+
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    HohmannBlock(parentBody->mu_, r1 + i, r2 + i, dv + i, tof + i);
+
+  for (; i < n; i++) {
+    const ImpulsiveTransfer transfer = Hohmann(r1[i], r2[i], parentBody);
+    dv[i] = transfer.dv_;
+    tof[i] = transfer.tof_;
+  }
+}
+
+void ImpulsiveTransfer::BiElliptic(const CelestialBody *parentBody,
+                                   const double *r1, const double *r2,
+                                   const double *rb, double *dv, double *tof,
+                                   std::size_t n) {
+  assert(parentBody);
+
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    BiEllipticBlock(parentBody->mu_, r1 + i, r2 + i, rb + i, dv + i, tof + i);
+
+  for (; i < n; i++) {
+    const ImpulsiveTransfer transfer =
+        BiElliptic(r1[i], r2[i], rb[i], parentBody);
+    dv[i] = transfer.dv_;
+    tof[i] = transfer.tof_;
+  }
+}
+
+void ImpulsiveTransfer::PlaneChange(const CelestialBody *parentBody,
+                                    const double *r1, const double *r2,
+                                    const double *di, double *dv, double *tof,
+                                    std::size_t n) {
+  for (std::size_t i = 0; i < n; i++) {
+    const ImpulsiveTransfer transfer =
+        PlaneChange(r1[i], r2[i], di[i], parentBody);
+    dv[i] = transfer.dv_;
+    tof[i] = transfer.tof_;
+  }
+}
@@ -0,0 +1,187 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief an impulsive transfer between two circular orbits
+ *
+ * The burns are instantaneous, the speeds of the transfer ellipses are from
+ * the vis-viva equation, \f$v=\sqrt{2(\epsilon+{\mu\over{r}})}\f$ with
+ * \f$\epsilon=-{\mu\over{2a}}\f$, and the time of flight is the half
+ * periods, \f$\pi\sqrt{a^3\over\mu}\f$.
+ *
+ * - Hohmann: the ellipse tangent to both orbits, two burns.
+ * - Bi-elliptic: out to \f$r_b\f$ on one ellipse, and back on another one,
+ *   three burns. Cheaper than Hohmann for \f${r_2\over{r_1}}>11.94\f$,
+ *   given a large enough \f$r_b\f$, and always slower.
+ * - Combined plane change: Hohmann, with the change of the inclination
+ *   \f$\Delta{i}\f$ split between the two burns, each one then being
+ *   \f$\Delta{v}=\sqrt{v_a^2+v_b^2-2v_av_b\cos\theta}\f$. The split
+ *   \f$s\f$ (\f$s\Delta{i}\f$ at the first burn) that minimizes the total
+ *   has no closed form, it is found by Newton's method on
+ *   \f${d\Delta{v}}\over{ds}\f$, safeguarded by bisection, since the sign
+ *   of the derivative brackets the minimum in \f$[0, 1]\f$.
+ *
+ * All the \f$\Delta{v}\f$ are magnitudes, the transfer may go either way.
+ *
+ * \see https://en.wikipedia.org/wiki/Hohmann_transfer_orbit
+ * \see https://en.wikipedia.org/wiki/Bi-elliptic_transfer
+ */
+class ImpulsiveTransfer {
+public:
+  /**
+   * @brief the most steps of the search for the plane change split
+   *
+   */
+  static constexpr int MaxSplitSteps = 60;
+
+  /**
+   * @brief the first burn [m/s]
+   *
+   */
+  double dv1_ = 0.0;
+
+  /**
+   * @brief the second burn [m/s]
+   *
+   */
+  double dv2_ = 0.0;
+
+  /**
+   * @brief the third burn, bi-elliptic only [m/s]
+   *
+   */
+  double dv3_ = 0.0;
+
+  /**
+   * @brief the sum of the burns [m/s]
+   *
+   */
+  double dv_ = 0.0;
+
+  /**
+   * @brief the time of flight [s]
+   *
+   */
+  double tof_ = 0.0;
+
+  /**
+   * @brief the part of the plane change done at the first burn
+   *
+   */
+  double split_ = 0.0;
+
+  /**
+   * @brief dummy constructor.
+   *
+   */
+  ImpulsiveTransfer() = default;
+
+  /**
+   * @brief the Hohmann transfer
+   *
+   * @param r1 radius of the initial orbit [m]
+   * @param r2 radius of the target orbit [m]
+   * @param parentBody the parent body
+   * @return ImpulsiveTransfer
+   */
+  static ImpulsiveTransfer Hohmann(double r1, double r2,
+                                   const CelestialBody *parentBody);
+
+  /**
+   * @brief the bi-elliptic transfer
+   *
+   * @param r1 radius of the initial orbit [m]
+   * @param r2 radius of the target orbit [m]
+   * @param rb radius of the intermediate apoapsis, at least r1 and r2 [m]
+   * @param parentBody the parent body
+   * @return ImpulsiveTransfer
+   */
+  static ImpulsiveTransfer BiElliptic(double r1, double r2, double rb,
+                                      const CelestialBody *parentBody);
+
+  /**
+   * @brief the Hohmann transfer, with the optimally split plane change
+   *
+   * @param r1 radius of the initial orbit [m]
+   * @param r2 radius of the target orbit [m]
+   * @param di the change of the inclination, in \f$[0, \pi]\f$ [rad]
+   * @param parentBody the parent body
+   * @return ImpulsiveTransfer
+   */
+  static ImpulsiveTransfer PlaneChange(double r1, double r2, double di,
+                                       const CelestialBody *parentBody);
+
+  /**
+   * @brief the Hohmann transfers of n pairs of orbits, structure-of-arrays.
+   *
+   * Same as the scalar version, in SIMD lanes.
+   *
+   * @param parentBody the parent body
+   * @param r1 radii of the initial orbits [m]
+   * @param r2 radii of the target orbits [m]
+   * @param dv the total burns [m/s]
+   * @param tof the times of flight [s]
+   * @param n the number of the transfers
+   */
+  static void Hohmann(const CelestialBody *parentBody, const double *r1,
+                      const double *r2, double *dv, double *tof,
+                      std::size_t n);
+
+  /**
+   * @brief the bi-elliptic transfers of n pairs of orbits,
+   * structure-of-arrays.
+   *
+   * Same as the scalar version, in SIMD lanes.
+   *
+   * @param parentBody the parent body
+   * @param r1 radii of the initial orbits [m]
+   * @param r2 radii of the target orbits [m]
+   * @param rb radii of the intermediate apoapses [m]
+   * @param dv the total burns [m/s]
+   * @param tof the times of flight [s]
+   * @param n the number of the transfers
+   */
+  static void BiElliptic(const CelestialBody *parentBody, const double *r1,
+                         const double *r2, const double *rb, double *dv,
+                         double *tof, std::size_t n);
+
+  /**
+   * @brief the plane change transfers of n pairs of orbits,
+   * structure-of-arrays.
+   *
+   * The split is iterated per transfer, so this is the scalar version in a
+   * loop.
+   *
+   * @param parentBody the parent body
+   * @param r1 radii of the initial orbits [m]
+   * @param r2 radii of the target orbits [m]
+   * @param di the changes of the inclination [rad]
+   * @param dv the total burns [m/s]
+   * @param tof the times of flight [s]
+   * @param n the number of the transfers
+   */
+  static void PlaneChange(const CelestialBody *parentBody, const double *r1,
+                          const double *r2, const double *di, double *dv,
+                          double *tof, std::size_t n);
+};
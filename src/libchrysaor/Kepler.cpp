@@ -0,0 +1,218 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Kepler.hpp"
+#include "Simd.hpp"     // for Simd
+#include "SimdMath.hpp" // for SimdCbrt, SimdSinCos, SimdSqrt, SimdAtan2
+#include <algorithm>    // for max, min
+#include <cassert>      // for assert
+#include <cmath>        // for sin, cos, sinh, cosh, cbrt, atan2, rem...
+#include <cstring>      // for memcpy
+#include <limits>       // for numeric_limits
+
+namespace {
+
+const double TwoPi = 2.0 * M_PI;
+
+// 2pi in two parts, for the reduction of the batched mean anomalies
+const double TwoPiHi = 6.28318530717958623200;
+const double TwoPiLo = 2.44929359829470635445e-16;
+
+// the cap on the steps of the hyperbolic solver
+const int MaxHyperbolicSteps = 50;
+
+typedef Simd<double>::type V;
+
+// E - e sin(E) = M, for M in [-pi, pi], see Kepler.hpp
+double ReducedEccentricAnomaly(double M, double e) {
+  const double m = std::abs(M);
+
+  double E = std::max(m, std::min(m + e, std::cbrt(6.0 * m)));
+  for (int i = 0; i < KeplerHalleySteps; i++) {
+    const double s = e * std::sin(E);
+    const double c = 1.0 - e * std::cos(E);
+    const double f = E - s - m;
+    E -= f / (c - 0.5 * (f / c) * s);
+  }
+
+  return M < 0.0 ? -E : E;
+}
+
+// the true anomaly in [-pi, pi], from E in [-pi, pi]
+double EllipticTrueAnomaly(double E, double e) {
+  return 2.0 * std::atan2(std::sqrt(1.0 + e) * std::sin(0.5 * E),
+                          std::sqrt(1.0 - e) * std::cos(0.5 * E));
+}
+
+// D + D^3/3 = M
+double ParabolicAnomaly(double M) {
+  // D = B - 1/B, B^3 = 3M/2 + sqrt(1 + 9M^2/4), as D = 3M / (B^2 + 1 + 1/B^2)
+  // there is no cancellation of B - 1/B for small M
+  const double m = std::abs(M);
+  const double B = std::cbrt(1.5 * m + std::sqrt(1.0 + 2.25 * m * m));
+  const double D = 3.0 * m / (B * B + 1.0 + 1.0 / (B * B));
+  return M < 0.0 ? -D : D;
+}
+
+// [-pi, pi] -> [0, 2pi)
+double Wrap(double angle) { return angle < 0.0 ? angle + TwoPi : angle; }
+
+// One block of the batched elliptic solver: E in [-pi, pi], or in the
+// revolutions of M. Call-free, so the vectors stay in the registers.
+__attribute__((noinline)) void EccentricBlock(const double *M, const double *e,
+                                              double *E, bool revolution) {
+  const double Round = 6755399441055744.0;
+  const V zero = {};
+
+  V m, ecc;
+  std::memcpy(&m, M, sizeof(V));
+  std::memcpy(&ecc, e, sizeof(V));
+
+  // to [-pi, pi]
+  const V k = (m * (1.0 / TwoPi) + Round) - Round;
+  const V mr = (m - k * TwoPiHi) - k * TwoPiLo;
+  const V am = mr < zero ? -mr : mr;
+
+  V x, s, c;
+  SimdCbrt(6.0 * am, &x);
+  x = am + ecc < x ? am + ecc : x;
+  x = x < am ? am : x;
+
+  for (int i = 0; i < KeplerHalleySteps; i++) {
+    SimdSinCos(x, &s, &c);
+    s *= ecc;
+    c = 1.0 - ecc * c;
+    const V f = x - s - am;
+    x -= f / (c - 0.5 * (f / c) * s);
+  }
+
+  x = mr < zero ? -x : x;
+  if (revolution)
+    x += m - mr;
+  std::memcpy(E, &x, sizeof(V));
+}
+
+// in place, E in [-pi, pi] -> nu in [0, 2pi)
+__attribute__((noinline)) void TrueBlock(const double *e, double *nu) {
+  const V zero = {};
+
+  V x, ecc;
+  std::memcpy(&x, nu, sizeof(V));
+  std::memcpy(&ecc, e, sizeof(V));
+
+  V s, c, p, q;
+  SimdSinCos(0.5 * x, &s, &c);
+  SimdSqrt(1.0 + ecc, &p);
+  SimdSqrt(1.0 - ecc, &q);
+  SimdAtan2(p * s, q * c, &x);
+
+  x = 2.0 * x;
+  x = x < zero ? x + TwoPi : x;
+  std::memcpy(nu, &x, sizeof(V));
+}
+
+} // namespace
+
+double EccentricAnomaly(double M, double e) {
+  assert(std::isfinite(M));
+  assert(e >= 0.0 && e < 1.0);
+
+  const double Mr = std::remainder(M, TwoPi);
+  return ReducedEccentricAnomaly(Mr, e) + (M - Mr);
+}
+
+double HyperbolicAnomaly(double M, double e) {
+  assert(std::isfinite(M));
+  assert(e > 1.0);
+
+  const double m = std::abs(M);
+
+  double H = std::asinh(m / e);
+  for (int i = 0; i < MaxHyperbolicSteps; i++) {
+    const double s = e * std::sinh(H);
+    const double c = e * std::cosh(H) - 1.0;
+    const double f = s - H - m;
+    const double step = f / (c - 0.5 * (f / c) * s);
+    H -= step;
+    if (std::abs(step) <= 4.0 * std::numeric_limits<double>::epsilon() * H)
+      break;
+  }
+
+  return M < 0.0 ? -H : H;
+}
+
+double TrueAnomaly(double M, double e) {
+  assert(std::isfinite(M));
+  assert(e >= 0.0);
+
+  if (e < 1.0) {
+    const double E = ReducedEccentricAnomaly(std::remainder(M, TwoPi), e);
+    return Wrap(EllipticTrueAnomaly(E, e));
+  }
+
+  if (e == 1.0)
+    return 2.0 * std::atan(ParabolicAnomaly(M));
+
+  const double H = HyperbolicAnomaly(M, e);
+  return 2.0 * std::atan(std::sqrt((e + 1.0) / (e - 1.0)) * std::tanh(0.5 * H));
+}
+
+double MeanAnomaly(double nu, double e) {
+  assert(std::isfinite(nu));
+  assert(e >= 0.0);
+
+  const double t = std::tan(0.5 * nu);
+
+  if (e < 1.0) {
+    const double E =
+        2.0 * std::atan2(std::sqrt(1.0 - e) * std::sin(0.5 * nu),
+                         std::sqrt(1.0 + e) * std::cos(0.5 * nu));
+    return Wrap(std::remainder(E - e * std::sin(E), TwoPi));
+  }
+
+  if (e == 1.0)
+    return t + t * t * t / 3.0;
+
+  const double H = 2.0 * std::atanh(std::sqrt((e - 1.0) / (e + 1.0)) * t);
+  return e * std::sinh(H) - H;
+}
+
+void EccentricAnomaly(const double *M, const double *e, double *E,
+                      std::size_t n) {
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    EccentricBlock(M + i, e + i, E + i, true);
+
+  for (; i < n; i++)
+    E[i] = EccentricAnomaly(M[i], e[i]);
+}
+
+void TrueAnomaly(const double *M, const double *e, double *nu, std::size_t n) {
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W) {
+    EccentricBlock(M + i, e + i, nu + i, false);
+    TrueBlock(e + i, nu + i);
+  }
+
+  for (; i < n; i++)
+    nu[i] = TrueAnomaly(M[i], e[i]);
+}
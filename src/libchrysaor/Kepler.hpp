@@ -0,0 +1,121 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+/**
+ * @file
+ * @brief Kepler's equation: mean to eccentric (or hyperbolic) to true anomaly
+ *
+ * The elliptic equation \f$M=E-e\sin{E}\f$ is reduced to
+ * \f$M\in[0,\pi]\f$ by periodicity and symmetry, where
+ * \f$M\le{E}\le{M+e}\f$. The starter is \f$\min(M+e,\sqrt[3]{6M})\f$,
+ * the cube root being the root of the cubic expansion for \f$e\to1\f$,
+ * near periapsis, where \f$M+e\f$ alone is far off. From it, Halley's
+ * method converges to full precision in KeplerHalleySteps steps, for all
+ * \f$e<1\f$ (checked on a fine grid of \f$M\f$ and \f$e\le0.9999\f$),
+ * so there is no test for convergence; the batched solver relies on that.
+ *
+ * The hyperbolic equation \f$M=e\sinh{H}-H\f$ is started from
+ * \f$H=\operatorname{asinh}(M/e)\f$, which is below the root, and iterated
+ * until converged, which takes up to about 10 steps for large \f$M\f$.
+ *
+ * The parabolic orbit has Barker's equation, \f$M=D+{D^3\over3}\f$,
+ * \f$D=\tan{\nu\over2}\f$, which is solved in closed form.
+ *
+ * \see https://en.wikipedia.org/wiki/Kepler%27s_equation
+ * \see https://en.wikipedia.org/wiki/Parabolic_trajectory#Barker.27s_equation
+ */
+
+/**
+ * @brief the number of Halley steps of the elliptic solver
+ *
+ */
+constexpr int KeplerHalleySteps = 3;
+
+/**
+ * @brief solves the elliptic Kepler's equation
+ *
+ * @param M the mean anomaly, any revolution [rad]
+ * @param e the eccentricity, \f$0\le{e}<1\f$
+ * @return double the eccentric anomaly, in the revolution of M [rad]
+ */
+double EccentricAnomaly(double M, double e);
+
+/**
+ * @brief solves the hyperbolic Kepler's equation
+ *
+ * @param M the hyperbolic mean anomaly [rad]
+ * @param e the eccentricity, \f$e>1\f$
+ * @return double the hyperbolic anomaly
+ */
+double HyperbolicAnomaly(double M, double e);
+
+/**
+ * @brief the true anomaly from the mean anomaly, for any conic
+ *
+ * \f$\nu=2\operatorname{atan2}(\sqrt{1+e}\sin{E\over2},
+ * \sqrt{1-e}\cos{E\over2})\f$, the half-angle form has no cancellation near
+ * periapsis of the very eccentric orbits, unlike the one with
+ * \f$\cos{E}-e\f$. \f$\nu=2\operatorname{atan}(\sqrt{{e+1}\over{e-1}}
+ * \tanh{H\over2})\f$ for the hyperbola.
+ *
+ * @param M the mean anomaly [rad]
+ * @param e the eccentricity
+ * @return double the true anomaly [rad], in \f$[0,2\pi)\f$ for the ellipse,
+ * in \f$(-\pi,\pi)\f$ otherwise
+ */
+double TrueAnomaly(double M, double e);
+
+/**
+ * @brief the mean anomaly from the true anomaly, for any conic
+ *
+ * The inverse of TrueAnomaly().
+ *
+ * @param nu the true anomaly [rad]
+ * @param e the eccentricity
+ * @return double the mean anomaly [rad], in \f$[0,2\pi)\f$ for the ellipse
+ */
+double MeanAnomaly(double nu, double e);
+
+/**
+ * @brief solves the elliptic Kepler's equation for n orbits at once
+ *
+ * Fixed KeplerHalleySteps steps, in SIMD lanes, without branches.
+ *
+ * @param M the mean anomalies [rad]
+ * @param e the eccentricities, \f$0\le{e}<1\f$
+ * @param E the eccentric anomalies, in the revolutions of M [rad]
+ * @param n the number of the orbits
+ */
+void EccentricAnomaly(const double *M, const double *e, double *E,
+                      std::size_t n);
+
+/**
+ * @brief the true anomalies from the mean anomalies, for n elliptic orbits
+ *
+ * As EccentricAnomaly(), followed by the half-angle form of TrueAnomaly().
+ *
+ * @param M the mean anomalies [rad]
+ * @param e the eccentricities, \f$0\le{e}<1\f$
+ * @param nu the true anomalies, in \f$[0,2\pi)\f$ [rad]
+ * @param n the number of the orbits
+ */
+void TrueAnomaly(const double *M, const double *e, double *nu, std::size_t n);
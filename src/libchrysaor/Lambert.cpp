@@ -0,0 +1,265 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Lambert.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include <algorithm>         // for max
+#include <cassert>           // for assert
+#include <cmath>             // for sqrt, acos, asin, sin, log, pow, abs, isf...
+#include <limits>            // for numeric_limits
+
+namespace {
+
+// |x - 1| below which T(x) is Battin's series, and Lagrange's expression
+// (Lancaster's cancels there)
+const double BattinRange = 0.01;
+const double LagrangeRange = 0.2;
+
+// the hypergeometric series stops at the first term below this
+const double SeriesTolerance = 1e-16;
+const int MaxSeriesTerms = 64;
+
+// Householder's method on T(x) = T, and Halley's on T'(x) = 0, stop after
+// a step below the tolerance, or after that many steps
+const double HouseholderTolerance = 1e-12;
+const int MaxHouseholderSteps = 15;
+const double HalleyTolerance = 1e-13;
+const int MaxHalleySteps = 12;
+
+// Battin's 2F1(3, 1; 5/2; z)
+double Hypergeometric(double z) {
+  double term = 1.0;
+  double sum = 1.0;
+  for (int j = 0; j < MaxSeriesTerms; j++) {
+    term *= (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1.0);
+    sum += term;
+    if (std::abs(term) <= SeriesTolerance)
+      break;
+  }
+  return sum;
+}
+
+// Lagrange's T(x)
+double TimeOfFlightLagrange(double lambda, double x, int revolutions) {
+  const double a = 1.0 / (1.0 - x * x);
+  if (a > 0.0) {
+    const double alpha = 2.0 * std::acos(x);
+    double beta = 2.0 * std::asin(std::sqrt(lambda * lambda / a));
+    if (lambda < 0.0)
+      beta = -beta;
+    return a * std::sqrt(a) *
+           ((alpha - std::sin(alpha)) - (beta - std::sin(beta)) +
+            2.0 * M_PI * revolutions) /
+           2.0;
+  }
+
+  const double alpha = 2.0 * std::acosh(x);
+  double beta = 2.0 * std::asinh(std::sqrt(-lambda * lambda / a));
+  if (lambda < 0.0)
+    beta = -beta;
+  return -a * std::sqrt(-a) *
+         ((beta - std::sinh(beta)) - (alpha - std::sinh(alpha))) / 2.0;
+}
+
+// the nondimensional time of flight T(x) with N revolutions
+double TimeOfFlight(double lambda, double x, int revolutions) {
+  const double distance = std::abs(x - 1.0);
+  if (distance >= BattinRange && distance < LagrangeRange)
+    return TimeOfFlightLagrange(lambda, x, revolutions);
+
+  const double e = x * x - 1.0;
+  const double rho = std::abs(e);
+  const double z = std::sqrt(1.0 + lambda * lambda * e);
+
+  if (distance < BattinRange) {
+    const double eta = z - lambda * x;
+    const double s1 = 0.5 * (1.0 - lambda - x * eta);
+    const double q = 4.0 / 3.0 * Hypergeometric(s1);
+    return (eta * eta * eta * q + 4.0 * lambda * eta) / 2.0 +
+           revolutions * M_PI / std::pow(rho, 1.5);
+  }
+
+  const double y = std::sqrt(rho);
+  const double g = x * z - lambda * e;
+  double d;
+  if (e < 0.0)
+    d = revolutions * M_PI + std::acos(g);
+  else
+    d = std::log(y * (z - lambda * x) + g);
+  return (x - lambda * z - d / y) / e;
+}
+
+// the first three derivatives of T(x), T given
+void Derivatives(double lambda, double x, double t, double *d1, double *d2,
+                 double *d3) {
+  const double l2 = lambda * lambda;
+  const double l3 = l2 * lambda;
+  const double umx2 = 1.0 - x * x;
+  const double y = std::sqrt(1.0 - l2 * umx2);
+  const double y2 = y * y;
+  const double y3 = y2 * y;
+
+  *d1 = (3.0 * t * x - 2.0 + 2.0 * l3 * x / y) / umx2;
+  *d2 = (3.0 * t + 5.0 * x * *d1 + 2.0 * (1.0 - l2) * l3 / y3) / umx2;
+  *d3 = (7.0 * x * *d2 + 8.0 * *d1 -
+         6.0 * (1.0 - l2) * l2 * l3 * x / (y3 * y2)) /
+        umx2;
+}
+
+// solves T(x) = t from x
+double Householder(double lambda, double t, double x, int revolutions) {
+  for (int step = 0; step < MaxHouseholderSteps; step++) {
+    const double tof = TimeOfFlight(lambda, x, revolutions);
+    double d1, d2, d3;
+    Derivatives(lambda, x, tof, &d1, &d2, &d3);
+
+    const double delta = tof - t;
+    const double d12 = d1 * d1;
+    const double next =
+        x - delta * (d12 - delta * d2 / 2.0) /
+                (d1 * (d12 - delta * d2) + d3 * delta * delta / 6.0);
+    const double change = std::abs(next - x);
+    x = next;
+    if (change < HouseholderTolerance)
+      break;
+  }
+  return x;
+}
+
+// the minimum of T(x) with N revolutions, from x = 0
+double MinimumTime(double lambda, int revolutions, double t0) {
+  double x = 0.0;
+  double tmin = t0;
+  for (int step = 0; step < MaxHalleySteps; step++) {
+    double d1, d2, d3;
+    Derivatives(lambda, x, tmin, &d1, &d2, &d3);
+    if (d1 == 0.0)
+      break;
+
+    const double next = x - d1 * d2 / (d2 * d2 - d1 * d3 / 2.0);
+    const double change = std::abs(next - x);
+    x = next;
+    tmin = TimeOfFlight(lambda, x, revolutions);
+    if (change < HalleyTolerance)
+      break;
+  }
+  return tmin;
+}
+
+// Izzo's starter for 0 revolutions
+double SingleRevolutionGuess(double lambda, double t) {
+  const double l2 = lambda * lambda;
+  const double t00 = std::acos(lambda) + lambda * std::sqrt(1.0 - l2);
+  const double t1 = 2.0 / 3.0 * (1.0 - l2 * lambda);
+
+  if (t >= t00)
+    return -(t - t00) / (t - t00 + 4.0);
+  if (t <= t1)
+    return t1 * (t1 - t) / (0.4 * (1.0 - l2 * l2 * lambda) * t) + 1.0;
+  return std::pow(t / t00, std::log(2.0) / std::log(t1 / t00)) - 1.0;
+}
+
+// the solutions x of T(x) = t with N revolutions, out of line like
+// Velocities(), to keep the scalar iterations and the vectors of Solve() in
+// separate frames
+__attribute__((noinline)) std::size_t Solutions(double lambda, double t,
+                                                int revolutions, double *x) {
+  if (revolutions == 0) {
+    x[0] = Householder(lambda, t, SingleRevolutionGuess(lambda, t), 0);
+    return 1;
+  }
+
+  // T(0) is above the minimum, otherwise the minimum is needed
+  const double t0 = std::acos(lambda) +
+                    lambda * std::sqrt(1.0 - lambda * lambda) +
+                    revolutions * M_PI;
+  if (t < t0 && MinimumTime(lambda, revolutions, t0) > t)
+    return 0;
+
+  const double n = revolutions * M_PI;
+  const double left = std::pow((n + M_PI) / (8.0 * t), 2.0 / 3.0);
+  const double right = std::pow(8.0 * t / n, 2.0 / 3.0);
+
+  x[0] = Householder(lambda, t, (left - 1.0) / (left + 1.0), revolutions);
+  x[1] = Householder(lambda, t, (right - 1.0) / (right + 1.0), revolutions);
+  return 2;
+}
+
+// the terminal velocities from the solution x
+__attribute__((noinline)) void Velocities(const Vec3 &r1, const Vec3 &r2,
+                                          const Vec3 &h, double lambda,
+                                          double s, double c, double mu,
+                                          double x, Vec3 *v1, Vec3 *v2) {
+  const double r1n = r1.norm();
+  const double r2n = r2.norm();
+  const double gamma = std::sqrt(mu * s / 2.0);
+  const double rho = (r1n - r2n) / c;
+  const double sigma = std::sqrt(1.0 - rho * rho);
+  const double y = std::sqrt(1.0 - lambda * lambda * (1.0 - x * x));
+
+  const double radial = lambda * y - x;
+  const double other = lambda * y + x;
+  const double tangential = gamma * sigma * (y + lambda * x);
+
+  // h is along the motion, the tangentials are h x r
+  *v1 = r1 * (gamma * (radial - rho * other) / (r1n * r1n)) +
+        h.cross(r1) * (tangential / (r1n * r1n));
+  *v2 = r2 * (-gamma * (radial + rho * other) / (r2n * r2n)) +
+        h.cross(r2) * (tangential / (r2n * r2n));
+}
+
+} // namespace
+
+Lambert::Lambert(const CelestialBody *body) : body_(body) {
+  assert(body);
+  assert(std::isfinite(body->mu_));
+  assert(body->mu_ > 0.0);
+}
+
+std::size_t Lambert::Solve(Vec3 r1, Vec3 r2, double tof, int revolutions,
+                           bool retrograde, Vec3 *v1, Vec3 *v2) const {
+  assert(tof > 0.0);
+  assert(revolutions >= 0);
+  assert(v1);
+  assert(v2);
+
+  const double mu = body_->mu_;
+  const double c = (r2 - r1).norm();
+  const double s = (c + r1.norm() + r2.norm()) / 2.0;
+
+  Vec3 h = r1.cross(r2);
+  const double hn = h.norm();
+  if (!(hn > std::numeric_limits<double>::epsilon() * r1.norm() * r2.norm()))
+    return 0;
+  h /= hn;
+
+  // lambda is negative beyond 180 degrees, in the direction of the motion
+  double lambda = std::sqrt(std::max(0.0, 1.0 - c / s));
+  if ((h.z_ < 0.0) != retrograde) {
+    lambda = -lambda;
+    h = h * -1.0;
+  }
+
+  const double t = std::sqrt(2.0 * mu / (s * s * s)) * tof;
+
+  double x[2];
+  const std::size_t solutions = Solutions(lambda, t, revolutions, x);
+  for (std::size_t k = 0; k < solutions; k++)
+    Velocities(r1, r2, h, lambda, s, c, mu, x[k], &v1[k], &v2[k]);
+  return solutions;
+}
@@ -0,0 +1,92 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief the solver of Lambert's problem
+ *
+ * Finds the conic arc from \f$\vec{r_1}\f$ to \f$\vec{r_2}\f$ in the given
+ * time of flight, i.e. the velocities at both ends.
+ *
+ * Izzo's algorithm: the problem is reduced to the single parameter
+ * \f$\lambda^2=1-{c\over{s}}\f$ (the chord and the semi-perimeter of the
+ * triangle) and the nondimensional time of flight
+ * \f$T=\sqrt{2\mu\over{s^3}}\Delta{t}\f$, and \f$T(x)=T\f$ is solved for
+ * the free variable \f$x\f$ by Householder's (4th order) method, from
+ * Izzo's starters, which are close enough for two or three steps. \f$T(x)\f$
+ * is Lancaster's expression, Lagrange's near \f$x=1\f$ where it cancels, and
+ * Battin's hypergeometric series closest to it.
+ *
+ * With \f$N\ge1\f$ full revolutions, there are two solutions, the left
+ * and the right branch of \f$T(x)\f$, if the time of flight is above the
+ * minimum for that \f$N\f$, found by Halley's method on \f$T'(x)=0\f$.
+ *
+ * The transfers of exactly 0 or 180 degrees, where the plane of the transfer
+ * is undefined, have no solution.
+ *
+ * \see Izzo, Revisiting Lambert's problem, 2015
+ */
+class Lambert {
+private:
+  /**
+   * @brief the parent body
+   *
+   */
+  const CelestialBody *body_;
+
+public:
+  /**
+   * @brief the solver around the given body
+   *
+   * @param body the parent body
+   */
+  explicit Lambert(const CelestialBody *body);
+
+  /**
+   * @brief the parent body
+   *
+   * @return const CelestialBody*
+   */
+  const CelestialBody *Body() const { return body_; }
+
+  /**
+   * @brief solves for the transfer with the given number of full revolutions
+   *
+   * The plane and the direction of the transfer is the one of
+   * \f$\vec{r_1}\times\vec{r_2}\f$, its Z component positive (prograde), or
+   * negative if retrograde.
+   *
+   * @param r1 the initial position [m]
+   * @param r2 the final position [m]
+   * @param tof the time of flight [s]
+   * @param revolutions the number of the full revolutions, 0 or more
+   * @param retrograde whether the transfer is retrograde
+   * @param v1 the initial velocities [m/s], room for 2
+   * @param v2 the final velocities [m/s], room for 2
+   * @return std::size_t the number of the solutions: 0 or 1 for 0
+   * revolutions, 0 or 2 (the left, then the right branch) otherwise
+   */
+  std::size_t Solve(Vec3 r1, Vec3 r2, double tof, int revolutions,
+                    bool retrograde, Vec3 *v1, Vec3 *v2) const;
+};
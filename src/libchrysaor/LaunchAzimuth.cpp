@@ -0,0 +1,150 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LaunchAzimuth.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "LaunchSite.hpp"    // for LaunchSite
+#include "Simd.hpp"          // for Simd
+#include "SimdMath.hpp"      // for SimdSinCos, SimdAtan2, SimdSqrt
+#include "Vec3.hpp"          // for Vec3
+#include <algorithm>         // for min, max
+#include <cassert>           // for assert
+#include <cmath>             // for cos, sqrt, atan2, isfinite, M_PI
+#include <cstddef>           // for size_t
+#include <cstring>           // for memcpy
+
+namespace {
+
+const double DegToRad = M_PI / 180.0;
+const double RadToDeg = 180.0 / M_PI;
+
+// the body, checked before the initializers dereference it
+const CelestialBody *Checked(const CelestialBody *body) {
+  assert(body);
+  return body;
+}
+
+} // namespace
+
+AzimuthSolution LaunchAzimuth::Solve(double cosLatitude, double cosInclination,
+                                     double equatorialSpeed) const {
+  const double v = orbitalSpeed_;
+
+  // sin, cos of the inertial azimuth
+  const double s =
+      std::min(1.0, std::max(-1.0, cosInclination / cosLatitude));
+  const double c = std::sqrt(1.0 - s * s);
+
+  const double east = v * s - equatorialSpeed * cosLatitude;
+  const double north = v * c;
+
+  AzimuthSolution solution;
+  solution.inertial = std::atan2(s, c) * RadToDeg;
+  solution.rotating = std::atan2(east, north) * RadToDeg;
+  if (solution.inertial < 0.0)
+    solution.inertial += 360.0;
+  if (solution.rotating < 0.0)
+    solution.rotating += 360.0;
+  solution.speed = std::sqrt(east * east + north * north);
+  solution.gain = v - solution.speed;
+  return solution;
+}
+
+AzimuthSolution LaunchAzimuth::Solve(double latitude,
+                                     double inclination) const {
+  assert(std::isfinite(latitude));
+  assert((latitude >= -90.0) && (latitude <= 90.0));
+  assert(std::isfinite(inclination));
+
+  return Solve(std::cos(latitude * DegToRad), std::cos(inclination * DegToRad),
+               body_->EquatorialSpeed());
+}
+
+AzimuthSolution LaunchAzimuth::Solve(const LaunchSite &site,
+                                     double inclination) const {
+  assert(site.Body() == body_);
+  assert(std::isfinite(inclination));
+
+  // the speed of the site, as if it were at the equator
+  const double cosLatitude = std::cos(site.Latitude() * DegToRad);
+  return Solve(cosLatitude, std::cos(inclination * DegToRad),
+               site.RotationalVelocity().norm() / cosLatitude);
+}
+
+void LaunchAzimuth::Solve(const double *latitude, const double *inclination,
+                          double *inertial, double *rotating, double *gain,
+                          std::size_t n) const {
+  typedef Simd<double>::type V;
+  const std::size_t W = Simd<double>::width;
+
+  const double v = orbitalSpeed_;
+  const double vrot = body_->EquatorialSpeed();
+  const V zero = {};
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W) {
+    V lat, incl;
+    std::memcpy(&lat, latitude + i, sizeof(V));
+    std::memcpy(&incl, inclination + i, sizeof(V));
+
+    V sinLat, cosLat, sinIncl, cosIncl;
+    SimdSinCos(lat * DegToRad, &sinLat, &cosLat);
+    SimdSinCos(incl * DegToRad, &sinIncl, &cosIncl);
+
+    // at the poles cosLat can be exactly 0, and for a polar orbit, 0/0;
+    // the scalar path divides the equal cosines there, and gets 1
+    V s = cosIncl / cosLat;
+    s = s != s ? zero + 1.0 : s;
+    s = s > 1.0 ? zero + 1.0 : s;
+    s = s < -1.0 ? zero - 1.0 : s;
+    V c;
+    SimdSqrt(1.0 - s * s, &c);
+
+    const V east = v * s - vrot * cosLat;
+    const V north = v * c;
+
+    V a, b, speed;
+    SimdAtan2(s, c, &a);
+    SimdAtan2(east, north, &b);
+    SimdSqrt(east * east + north * north, &speed);
+
+    a *= RadToDeg;
+    b *= RadToDeg;
+    a = a < zero ? a + 360.0 : a;
+    b = b < zero ? b + 360.0 : b;
+    const V g = v - speed;
+
+    std::memcpy(inertial + i, &a, sizeof(V));
+    std::memcpy(rotating + i, &b, sizeof(V));
+    std::memcpy(gain + i, &g, sizeof(V));
+  }
+
+  for (; i < n; i++) {
+    const AzimuthSolution solution = Solve(latitude[i], inclination[i]);
+    inertial[i] = solution.inertial;
+    rotating[i] = solution.rotating;
+    gain[i] = solution.gain;
+  }
+}
+
+LaunchAzimuth::LaunchAzimuth(const CelestialBody *body, double altitude)
+    : body_(Checked(body)),
+      orbitalSpeed_(std::sqrt(body_->mu_ / (body_->R_ + altitude))) {
+  assert(std::isfinite(altitude));
+  assert(body->R_ + altitude > 0.0);
+}
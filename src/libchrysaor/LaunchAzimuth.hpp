@@ -0,0 +1,145 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+class CelestialBody;
+class LaunchSite;
+
+/**
+ * @brief the launch azimuth into the orbit of the given inclination
+ *
+ */
+struct AzimuthSolution {
+  /**
+   * @brief azimuth of the orbital velocity, inertial, clockwise from
+   * north [deg]
+   *
+   */
+  double inertial;
+
+  /**
+   * @brief azimuth to launch at, relative to the rotating surface [deg]
+   *
+   */
+  double rotating;
+
+  /**
+   * @brief speed to gain, relative to the rotating surface [m/s]
+   *
+   */
+  double speed;
+
+  /**
+   * @brief the gain from the rotation of the body, orbital speed minus
+   * speed, negative for the retrograde orbits [m/s]
+   *
+   */
+  double gain;
+};
+
+/**
+ * @brief solves for the launch azimuth and the velocity gain from the
+ * rotation of the body
+ *
+ * The orbital velocity at the site has the inertial azimuth
+ * \f$\sin\beta_I = \cos{i} / \cos\phi\f$, and the surface already moves
+ * east at \f$v_{rot}\cos\phi\f$, so the velocity to gain is
+ * \f$(v\sin\beta_I - v_{rot}\cos\phi, v\cos\beta_I)\f$ (east, north), and
+ * its direction is the rotating azimuth. If the inclination is below the
+ * latitude, the launch is due east (or west), into the nearest plane.
+ *
+ * The solutions are for the northerly launch, the southerly one is the
+ * mirror image, at 180 minus the azimuth, with the same gain.
+ *
+ * The batched Solve() is a SIMD kernel, over SoA arrays of the (latitude,
+ * inclination) pairs, see SimdMath.hpp.
+ */
+class LaunchAzimuth {
+private:
+  /**
+   * @brief the body
+   *
+   */
+  const CelestialBody *body_;
+
+  /**
+   * @brief circular orbital speed at the target altitude [m/s]
+   *
+   */
+  double orbitalSpeed_;
+
+  /**
+   * @brief the solution, for the given cos of the latitude and of the
+   * inclination, and the rotational speed at the equator
+   *
+   */
+  AzimuthSolution Solve(double cosLatitude, double cosInclination,
+                        double equatorialSpeed) const;
+
+public:
+  /**
+   * @brief circular orbital speed at the target altitude [m/s]
+   *
+   */
+  double OrbitalSpeed() const { return orbitalSpeed_; }
+
+  /**
+   * @brief the solution at the latitude
+   *
+   * @param latitude latitude of the site [deg]
+   * @param inclination target inclination [deg]
+   * @return AzimuthSolution
+   */
+  AzimuthSolution Solve(double latitude, double inclination) const;
+
+  /**
+   * @brief the solution at the launch site
+   *
+   * Uses the actual rotational speed of the site, with its altitude.
+   *
+   * @param site the launch site, on the body
+   * @param inclination target inclination [deg]
+   * @return AzimuthSolution
+   */
+  AzimuthSolution Solve(const LaunchSite &site, double inclination) const;
+
+  /**
+   * @brief batched Solve(), over SoA arrays
+   *
+   * @param latitude latitudes of the sites [deg]
+   * @param inclination target inclinations [deg]
+   * @param inertial output inertial azimuths [deg]
+   * @param rotating output rotating azimuths [deg]
+   * @param gain output velocity gains [m/s]
+   * @param n number of the pairs
+   */
+  void Solve(const double *latitude, const double *inclination,
+             double *inertial, double *rotating, double *gain,
+             std::size_t n) const;
+
+  /**
+   * @brief creates the solver, for the circular orbit at the altitude
+   *
+   * @param body the body
+   * @param altitude altitude of the target orbit [m]
+   */
+  LaunchAzimuth(const CelestialBody *body, double altitude);
+};
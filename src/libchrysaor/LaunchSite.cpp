@@ -17,8 +17,12 @@
  */
 
 #include "LaunchSite.hpp"
-#include <cassert> // for assert
-#include <cstddef>
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Ellipsoid.hpp"     // for Ellipsoid
+#include "RotatingFrame.hpp" // for RotatingFrame
+#include "Vec3.hpp"          // for Vec3
+#include <cassert>           // for assert
+#include <cstddef>           // for size_t
 
 CelestialBody *LaunchSite::Body() const { return body_; }
 
@@ -28,6 +32,22 @@ double LaunchSite::Longitude() const { return longitude_; }
 
 std::size_t LaunchSite::Altitude() const { return altitude_; }
 
+Vec3 LaunchSite::InertialPosition(const RotatingFrame &frame) const {
+  return frame.ToInertial(position_);
+}
+
+Vec3 LaunchSite::InertialVelocity(const RotatingFrame &frame) const {
+  return frame.ToInertial(rotationalVelocity_);
+}
+
+void LaunchSite::Precompute(const Ellipsoid &ellipsoid) {
+  position_ = ellipsoid.ToCartesian(latitude_, longitude_, altitude_);
+
+  const double omega = body_->omega_;
+  rotationalVelocity_ =
+      Vec3(-omega * position_.y_, omega * position_.x_, 0.0);
+}
+
 LaunchSite::LaunchSite(double latitude, double longitude, std::size_t altitude)
     : latitude_(latitude), longitude_(longitude), altitude_(altitude) {}
 
@@ -36,4 +56,15 @@ LaunchSite::LaunchSite(CelestialBody *parentBody, double latitude,
     : body_(parentBody), latitude_(latitude), longitude_(longitude),
       altitude_(altitude) {
   assert(parentBody);
+
+  Precompute(Ellipsoid(parentBody));
+}
+
+LaunchSite::LaunchSite(CelestialBody *parentBody, const Ellipsoid &ellipsoid,
+                       double latitude, double longitude, std::size_t altitude)
+    : body_(parentBody), latitude_(latitude), longitude_(longitude),
+      altitude_(altitude) {
+  assert(parentBody);
+
+  Precompute(ellipsoid);
 }
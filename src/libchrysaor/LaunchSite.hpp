@@ -18,8 +18,12 @@
 
 #pragma once
 
-#include <cstddef>
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
 class CelestialBody;
+class Ellipsoid;
+class RotatingFrame;
 
 class LaunchSite {
 private:
@@ -44,6 +48,22 @@ private:
   */
   std::size_t altitude_;
 
+  /**
+   * @brief position of the launch site, body-fixed [m]
+   *
+   * Zero, if there is no body.
+   */
+  Vec3 position_;
+
+  /**
+   * @brief velocity of the launch site due to the body rotation,
+   * \f$\omega \times r\f$, in the body-fixed axes [m/s]
+   *
+   */
+  Vec3 rotationalVelocity_;
+
+  void Precompute(const Ellipsoid &ellipsoid);
+
 public:
   /**
    * @brief returns pointer to the body on which this lauchsite is located
@@ -73,7 +93,50 @@ public:
    */
   std::size_t Altitude() const;
 
+  /**
+   * @brief returns the position of the launch site, body-fixed [m]
+   *
+   * @return Vec3 position
+   */
+  Vec3 Position() const { return position_; }
+
+  /**
+   * @brief returns the velocity of the launch site due to the body rotation,
+   * in the body-fixed axes [m/s]
+   *
+   * @return Vec3 velocity
+   */
+  Vec3 RotationalVelocity() const { return rotationalVelocity_; }
+
+  /**
+   * @brief returns the position of the launch site, inertial [m]
+   *
+   * @param frame the rotating frame of the body, at the wanted time
+   * @return Vec3 position
+   */
+  Vec3 InertialPosition(const RotatingFrame &frame) const;
+
+  /**
+   * @brief returns the inertial velocity of the launch site [m/s]
+   *
+   * @param frame the rotating frame of the body, at the wanted time
+   * @return Vec3 velocity
+   */
+  Vec3 InertialVelocity(const RotatingFrame &frame) const;
+
   LaunchSite(double latitude, double longitude, std::size_t altitude);
   LaunchSite(CelestialBody *parentBody, double latitude, double longitude,
              std::size_t altitude);
+
+  /**
+   * @brief creates the launch site on the body of the given shape
+   *
+   * @param parentBody the body
+   * @param ellipsoid reference ellipsoid of the body
+   * @param latitude geodetic latitude [deg]
+   * @param longitude longitude [deg]
+   * @param altitude altitude above the ellipsoid [m]
+   */
+  LaunchSite(CelestialBody *parentBody, const Ellipsoid &ellipsoid,
+             double latitude, double longitude, std::size_t altitude);
 };
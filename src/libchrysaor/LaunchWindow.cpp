@@ -0,0 +1,342 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LaunchWindow.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "LaunchSite.hpp"    // for LaunchSite
+#include "Parallel.hpp"      // for ParallelFor
+#include "Simd.hpp"          // for Simd
+#include "Vec3.hpp"          // for Vec3
+#include <algorithm>         // for min
+#include <cassert>           // for assert
+#include <cmath>             // for cos, sin, sqrt, atan2, asin, fabs, floor
+#include <cstddef>           // for size_t
+#include <cstring>           // for memcpy
+#include <vector>            // for vector
+
+namespace {
+
+const double DegToRad = M_PI / 180.0;
+const double RadToDeg = 180.0 / M_PI;
+
+// the body, checked before the initializers dereference it
+const CelestialBody *Checked(const CelestialBody *body) {
+  assert(body);
+  return body;
+}
+
+/**
+ * @brief samples swept at once, bounds the memory of the long sweeps
+ *
+ */
+const std::size_t Chunk = 4096;
+static_assert(Chunk % Simd<double>::width == 0, "");
+
+/**
+ * @brief vector steps between the exact recomputations of the rotation
+ *
+ */
+const std::size_t ResyncSteps = 64;
+
+/**
+ * @brief the sign of \f$g\dot{g}\f$ at n consecutive samples
+ *
+ * The block of ResyncSteps vector steps begins with cos, sin of the angles
+ * of its first lanes, in seeds, the rest of the angles are reached by
+ * rotating by the angle of W samples. There are no calls in the loops,
+ * so the vectors stay in the registers, as long as this is not inlined
+ * into the loop that computes the seeds. h is written in whole vectors, it
+ * must have room for n rounded up to W.
+ */
+__attribute__((noinline)) void
+SweepKernel(double A, double B, double C, double omega, double dtheta,
+            const double *seeds, double *h, std::size_t n) {
+  typedef Simd<double>::type V;
+  const std::size_t W = Simd<double>::width;
+
+  const double dc = std::cos(W * dtheta);
+  const double ds = std::sin(W * dtheta);
+
+  for (std::size_t k0 = 0; k0 < n; k0 += W * ResyncSteps) {
+    V c, s;
+    std::memcpy(&c, seeds, sizeof(c));
+    std::memcpy(&s, seeds + W, sizeof(s));
+    seeds += 2 * W;
+
+    const std::size_t end = std::min(n, k0 + W * ResyncSteps);
+    for (std::size_t k = k0; k < end; k += W) {
+      const V g = A * c + B * s + C;
+      const V v = g * (omega * (B * c - A * s));
+
+      std::memcpy(h + k, &v, sizeof(v));
+
+      const V cn = c * dc - s * ds;
+      s = s * dc + c * ds;
+      c = cn;
+    }
+  }
+}
+
+/**
+ * @brief cos, sin of the first W angles of every block of n samples
+ *
+ */
+void Seeds(double theta, double dtheta, std::size_t n, double *seeds) {
+  const std::size_t W = Simd<double>::width;
+  const std::size_t block = W * ResyncSteps;
+
+  for (std::size_t k = 0; k < n; k += block) {
+    for (std::size_t j = 0; j < W; j++) {
+      seeds[j] = std::cos(theta + (k + j) * dtheta);
+      seeds[W + j] = std::sin(theta + (k + j) * dtheta);
+    }
+    seeds += 2 * W;
+  }
+}
+
+/**
+ * @brief unit normal of the plane
+ *
+ */
+Vec3 Normal(const TargetPlane &plane) {
+  const double i = plane.inclination * DegToRad;
+  const double raan = plane.raan * DegToRad;
+  return Vec3(std::sin(i) * std::sin(raan), -std::sin(i) * std::cos(raan),
+              std::cos(i));
+}
+
+/**
+ * @brief unit direction to the site, body-fixed
+ *
+ */
+Vec3 Direction(const LaunchSite &site) {
+  const Vec3 r = site.Position();
+  const double norm = r.norm();
+  assert(norm > 0.0);
+  return r / norm;
+}
+
+/**
+ * @brief \f$g = A\cos\theta + B\sin\theta + C\f$, for the site and the
+ * plane
+ *
+ */
+void Coefficients(const LaunchSite &site, const TargetPlane &plane,
+                  double *A, double *B, double *C) {
+  const Vec3 u = Direction(site);
+  const Vec3 n = Normal(plane);
+  *A = n.x_ * u.x_ + n.y_ * u.y_;
+  *B = n.y_ * u.x_ - n.x_ * u.y_;
+  *C = n.z_ * u.z_;
+}
+
+} // namespace
+
+void LaunchWindowScanner::Sweep(double A, double B, double C, double t0,
+                                double t1,
+                                std::vector<double> *brackets) const {
+  const std::size_t n =
+      static_cast<std::size_t>(std::floor((t1 - t0) / step_)) + 1;
+
+  const std::size_t W = Simd<double>::width;
+  const double dtheta = omega_ * step_;
+
+  // the samples, then the seeds of their blocks
+  std::vector<double> h(Chunk + 2 * W * (Chunk / (W * ResyncSteps) + 1));
+  double *seeds = h.data() + Chunk;
+
+  double prev = 0.0;
+  for (std::size_t k0 = 0; k0 < n; k0 += Chunk) {
+    const std::size_t m = std::min(Chunk, n - k0);
+
+    Seeds(theta0_ + omega_ * (t0 + k0 * step_), dtheta, m, seeds);
+    SweepKernel(A, B, C, omega_, dtheta, seeds, h.data(), m);
+
+    for (std::size_t j = 0; j < m; j++) {
+      const std::size_t k = k0 + j;
+      if (k > 0 && prev < 0.0 && h[j] >= 0.0)
+        brackets->push_back(t0 + (k - 1) * step_);
+      prev = h[j];
+    }
+  }
+}
+
+double LaunchWindowScanner::Refine(double A, double B, double C,
+                                   double t) const {
+  double lo = t;
+  double hi = t + step_;
+
+  // the site passes through the plane, or only comes closest to it
+  const double gLo = A * std::cos(theta0_ + omega_ * lo) +
+                     B * std::sin(theta0_ + omega_ * lo) + C;
+  const double gHi = A * std::cos(theta0_ + omega_ * hi) +
+                     B * std::sin(theta0_ + omega_ * hi) + C;
+  const bool crossing = (gLo < 0.0) != (gHi < 0.0);
+
+  // f = g, or f = dg/dtheta, and its derivative w.r.t. the time
+  auto F = [A, B, C, this, crossing](double x, double *df) {
+    const double c = std::cos(theta0_ + omega_ * x);
+    const double s = std::sin(theta0_ + omega_ * x);
+    if (crossing) {
+      *df = omega_ * (B * c - A * s);
+      return A * c + B * s + C;
+    }
+    *df = -omega_ * (A * c + B * s);
+    return B * c - A * s;
+  };
+
+  // safeguarded Newton, bisection whenever the step leaves the bracket
+  double df;
+  const double fLo = F(lo, &df);
+
+  double x = 0.5 * (lo + hi);
+  for (int i = 0; i < 64; i++) {
+    const double f = F(x, &df);
+    if ((f < 0.0) == (fLo < 0.0))
+      lo = x;
+    else
+      hi = x;
+
+    double next = x - f / df;
+    if (!(next > lo && next < hi))
+      next = 0.5 * (lo + hi);
+
+    const double dx = std::fabs(next - x);
+    x = next;
+    if (dx < 1e-6)
+      break;
+  }
+
+  return x;
+}
+
+LaunchWindow LaunchWindowScanner::Window(const LaunchSite &site,
+                                         const TargetPlane &plane,
+                                         double time) const {
+  const Vec3 u = Direction(site);
+  const Vec3 n = Normal(plane);
+
+  const double c = std::cos(theta0_ + omega_ * time);
+  const double s = std::sin(theta0_ + omega_ * time);
+  const double x = c * u.x_ - s * u.y_;
+  const double y = s * u.x_ + c * u.y_;
+  const double z = u.z_;
+
+  const double g = n.x_ * x + n.y_ * y + n.z_ * z;
+
+  // the direction of flight, n x r, is the same in the nearest plane
+  // through the site, only shorter
+  const double dx = n.y_ * z - n.z_ * y;
+  const double dy = n.z_ * x - n.x_ * z;
+  const double dz = n.x_ * y - n.y_ * x;
+
+  // its east and north components, both times the distance from the axis
+  const double east = x * dy - y * dx;
+  const double north = (x * x + y * y) * dz - z * (x * dx + y * dy);
+
+  double azimuth = std::atan2(east, north) * RadToDeg;
+  if (azimuth < 0.0)
+    azimuth += 360.0;
+
+  const double planeChange = std::asin(std::min(1.0, std::fabs(g)));
+
+  LaunchWindow window;
+  window.site = 0;
+  window.plane = 0;
+  window.time = time;
+  window.azimuth = azimuth;
+  window.planeChange = planeChange * RadToDeg;
+  window.deltaV = 2.0 * parkingSpeed_ * std::sin(0.5 * planeChange);
+  return window;
+}
+
+void LaunchWindowScanner::Scan(const LaunchSite &site,
+                               const TargetPlane &plane, double t0, double t1,
+                               std::vector<LaunchWindow> *windows) const {
+  double A, B, C;
+  Coefficients(site, plane, &A, &B, &C);
+
+  std::vector<double> brackets;
+  Sweep(A, B, C, t0, t1, &brackets);
+
+  for (double t : brackets)
+    windows->push_back(Window(site, plane, Refine(A, B, C, t)));
+}
+
+std::vector<LaunchWindow>
+LaunchWindowScanner::Scan(const LaunchSite &site, const TargetPlane &plane,
+                          double t0, double t1) const {
+  assert(site.Body() == body_);
+  assert(t0 <= t1);
+
+  double A, B, C;
+  Coefficients(site, plane, &A, &B, &C);
+
+  std::vector<double> brackets;
+  Sweep(A, B, C, t0, t1, &brackets);
+
+  std::vector<LaunchWindow> windows(brackets.size());
+  ParallelFor(brackets.size(),
+              [this, &site, &plane, A, B, C, &brackets,
+               &windows](std::size_t i) {
+                windows[i] = Window(site, plane, Refine(A, B, C, brackets[i]));
+              },
+              16);
+
+  return windows;
+}
+
+std::vector<LaunchWindow>
+LaunchWindowScanner::Scan(const LaunchSite *sites, std::size_t nSites,
+                          const TargetPlane *planes, std::size_t nPlanes,
+                          double t0, double t1) const {
+  assert(sites || !nSites);
+  assert(planes || !nPlanes);
+  assert(t0 <= t1);
+
+  std::vector<std::vector<LaunchWindow>> pairs(nSites * nPlanes);
+  ParallelFor(pairs.size(), [this, sites, planes, nPlanes, t0, t1,
+                             &pairs](std::size_t i) {
+    assert(sites[i / nPlanes].Body() == body_);
+    Scan(sites[i / nPlanes], planes[i % nPlanes], t0, t1, &pairs[i]);
+  });
+
+  std::vector<LaunchWindow> windows;
+  for (std::size_t i = 0; i < pairs.size(); i++) {
+    for (LaunchWindow window : pairs[i]) {
+      window.site = i / nPlanes;
+      window.plane = i % nPlanes;
+      windows.push_back(window);
+    }
+  }
+
+  return windows;
+}
+
+LaunchWindowScanner::LaunchWindowScanner(const CelestialBody *body,
+                                         double step, double parkingAltitude,
+                                         double theta0)
+    : body_(Checked(body)), omega_(body_->omega_), theta0_(theta0),
+      step_(step),
+      parkingSpeed_(std::sqrt(body_->mu_ / (body_->R_ + parkingAltitude))) {
+  assert(omega_ != 0.0);
+  assert(std::isfinite(step) && step > 0.0);
+  assert(std::fabs(omega_) * step < 0.25 * M_PI);
+  assert(std::isfinite(parkingAltitude));
+  assert(std::isfinite(theta0));
+}
@@ -0,0 +1,206 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+#include <vector>  // for vector
+
+class CelestialBody;
+class LaunchSite;
+
+/**
+ * @brief target orbital plane, inertial, w.r.t. the body equator
+ *
+ */
+struct TargetPlane {
+  /**
+   * @brief inclination [deg]
+   *
+   */
+  double inclination;
+
+  /**
+   * @brief longitude of the ascending node [deg]
+   *
+   */
+  double raan;
+};
+
+/**
+ * @brief one launch window, the best moment to launch into the plane
+ *
+ */
+struct LaunchWindow {
+  /**
+   * @brief index of the launch site, and of the target plane
+   *
+   */
+  std::size_t site;
+  std::size_t plane;
+
+  /**
+   * @brief time of the window [s]
+   *
+   */
+  double time;
+
+  /**
+   * @brief inertial launch azimuth, clockwise from north [deg]
+   *
+   */
+  double azimuth;
+
+  /**
+   * @brief the remaining plane change, 0 if the site passes through the
+   * plane [deg]
+   *
+   */
+  double planeChange;
+
+  /**
+   * @brief delta-v of that plane change, in the parking orbit [m/s]
+   *
+   */
+  double deltaV;
+};
+
+/**
+ * @brief finds the launch windows from the launch sites into the planes
+ *
+ * The window is the moment when the site, carried by the rotation of the
+ * body, passes through the target plane, or, if its latitude is too high
+ * for that, when it comes closest to the plane. Both are the local minima
+ * of \f$|g(t)|\f$, with \f$g = \hat{n} \cdot \hat{r}(t)\f$, the sine of the
+ * angle between the plane and the site. For the body rotating about z,
+ * \f$g = A\cos\theta + B\sin\theta + C\f$.
+ *
+ * The time span is swept with the fixed step, several samples at once, in
+ * SIMD lanes, with the rotation advanced by complex multiplication, as in
+ * RotatingFrame. The steps where \f$g\dot{g}\f$ turns from negative to
+ * positive bracket the windows, and the brackets are refined in parallel,
+ * by the safeguarded Newton iteration on \f$g\f$, or on \f$\dot{g}\f$.
+ *
+ * The equatorial planes have no windows, every moment is the same.
+ */
+class LaunchWindowScanner {
+private:
+  /**
+   * @brief the body of the launch sites
+   *
+   */
+  const CelestialBody *body_;
+
+  /**
+   * @brief angular velocity of the body [rad/s]
+   *
+   */
+  double omega_;
+
+  /**
+   * @brief rotation angle at t = 0 [rad]
+   *
+   */
+  double theta0_;
+
+  /**
+   * @brief the step of the sweep [s]
+   *
+   */
+  double step_;
+
+  /**
+   * @brief circular speed in the parking orbit [m/s]
+   *
+   */
+  double parkingSpeed_;
+
+  /**
+   * @brief finds the brackets, [t, t + step], of the windows, for
+   * \f$g = A\cos\theta + B\sin\theta + C\f$
+   *
+   */
+  void Sweep(double A, double B, double C, double t0, double t1,
+             std::vector<double> *brackets) const;
+
+  /**
+   * @brief the time of the window in the bracket [t, t + step]
+   *
+   * The root of g, if the site passes through the plane, or of its
+   * derivative, if it only comes closest to it.
+   */
+  double Refine(double A, double B, double C, double t) const;
+
+  /**
+   * @brief the window, for the site and the plane, at the time
+   *
+   */
+  LaunchWindow Window(const LaunchSite &site, const TargetPlane &plane,
+                      double time) const;
+
+  /**
+   * @brief all of the windows, for one pair, without the parallelism
+   *
+   */
+  void Scan(const LaunchSite &site, const TargetPlane &plane, double t0,
+            double t1, std::vector<LaunchWindow> *windows) const;
+
+public:
+  /**
+   * @brief the windows of one site, for one plane, in time order
+   *
+   * @param site the launch site, on the body
+   * @param plane the target plane
+   * @param t0 start of the search [s]
+   * @param t1 end of the search [s]
+   * @return std::vector<LaunchWindow> windows, with site and plane of 0
+   */
+  std::vector<LaunchWindow> Scan(const LaunchSite &site,
+                                 const TargetPlane &plane, double t0,
+                                 double t1) const;
+
+  /**
+   * @brief the windows of every site, for every plane, in parallel
+   *
+   * @param sites the launch sites, on the body
+   * @param nSites number of the sites
+   * @param planes the target planes
+   * @param nPlanes number of the planes
+   * @param t0 start of the search [s]
+   * @param t1 end of the search [s]
+   * @return std::vector<LaunchWindow> windows, ordered by the site, then by
+   * the plane, then by the time
+   */
+  std::vector<LaunchWindow> Scan(const LaunchSite *sites, std::size_t nSites,
+                                 const TargetPlane *planes,
+                                 std::size_t nPlanes, double t0,
+                                 double t1) const;
+
+  /**
+   * @brief creates the scanner
+   *
+   * @param body the rotating body
+   * @param step the step of the sweep, well below a quarter of the rotation
+   * period [s]
+   * @param parkingAltitude altitude of the parking orbit, for the plane
+   * change cost [m]
+   * @param theta0 rotation angle at t = 0, as in RotatingFrame [rad]
+   */
+  LaunchWindowScanner(const CelestialBody *body, double step,
+                      double parkingAltitude, double theta0 = 0.0);
+};
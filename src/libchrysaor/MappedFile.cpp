@@ -0,0 +1,54 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MappedFile.hpp"
+#include <cstddef>    // for size_t
+#include <fcntl.h>    // for open, O_RDONLY
+#include <string>     // for string
+#include <sys/mman.h> // for mmap, munmap, MAP_FAILED, MAP_SHARED, PROT_READ
+#include <sys/stat.h> // for fstat, stat
+#include <unistd.h>   // for close
+
+MappedFile::MappedFile(const std::string &path) : data_(nullptr), size_(0) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return;
+  }
+
+  const std::size_t size = static_cast<std::size_t>(st.st_size);
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+
+  // the mapping keeps the file alive
+  close(fd);
+
+  if (data == MAP_FAILED)
+    return;
+
+  data_ = data;
+  size_ = size;
+}
+
+MappedFile::~MappedFile() {
+  if (data_)
+    munmap(data_, size_);
+}
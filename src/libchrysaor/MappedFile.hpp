@@ -0,0 +1,78 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+#include <string>  // for string
+
+/**
+ * @brief read-only memory mapping of a whole file
+ *
+ * The pages are shared with the page cache, so many processes (and all the
+ * threads) using the same file share one copy of it, and nothing is read
+ * until it is touched.
+ */
+class MappedFile {
+private:
+  /**
+   * @brief the mapping
+   *
+   */
+  void *data_;
+
+  /**
+   * @brief size of the file [bytes]
+   *
+   */
+  std::size_t size_;
+
+public:
+  /**
+   * @brief the contents of the file
+   *
+   */
+  const void *data() const { return data_; }
+
+  /**
+   * @brief size of the file [bytes]
+   *
+   */
+  std::size_t size() const { return size_; }
+
+  /**
+   * @brief whether the file was mapped
+   *
+   */
+  bool valid() const { return data_ != nullptr; }
+
+  /**
+   * @brief maps the whole file
+   *
+   * A file that cannot be opened, is empty, or cannot be mapped leaves the
+   * mapping empty: not valid(), with no data and size 0.
+   *
+   * @param path path to the file
+   */
+  explicit MappedFile(const std::string &path);
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  ~MappedFile();
+};
@@ -0,0 +1,86 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Mat3.hpp"
+#include "Simd.hpp" // for Simd
+#include <cstddef>  // for size_t
+#include <cstring>  // for memcpy
+#include <iostream>
+
+template <typename T>
+static void ApplySimd(const T (&m)[3][3], const T *x, const T *y, const T *z,
+                      T *ox, T *oy, T *oz, std::size_t n) {
+  typedef typename Simd<T>::type V;
+  const std::size_t W = Simd<T>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W) {
+    V vx, vy, vz;
+    std::memcpy(&vx, x + i, sizeof(V));
+    std::memcpy(&vy, y + i, sizeof(V));
+    std::memcpy(&vz, z + i, sizeof(V));
+
+    const V rx = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz;
+    const V ry = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz;
+    const V rz = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz;
+
+    std::memcpy(ox + i, &rx, sizeof(V));
+    std::memcpy(oy + i, &ry, sizeof(V));
+    std::memcpy(oz + i, &rz, sizeof(V));
+  }
+
+  for (; i < n; i++) {
+    const T vx = x[i];
+    const T vy = y[i];
+    const T vz = z[i];
+
+    ox[i] = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz;
+    oy[i] = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz;
+    oz[i] = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz;
+  }
+}
+
+template <>
+void BasicMat3<float>::apply(const float *x, const float *y, const float *z,
+                             float *ox, float *oy, float *oz,
+                             std::size_t n) const {
+  ApplySimd(m_, x, y, z, ox, oy, oz, n);
+}
+
+template <>
+void BasicMat3<double>::apply(const double *x, const double *y,
+                              const double *z, double *ox, double *oy,
+                              double *oz, std::size_t n) const {
+  ApplySimd(m_, x, y, z, ox, oy, oz, n);
+}
+
+template <typename T>
+::std::ostream &operator<<(::std::ostream &os, const BasicMat3<T> &bar) {
+  return os << "((" << bar.m_[0][0] << "; " << bar.m_[0][1] << "; "
+            << bar.m_[0][2] << "); (" << bar.m_[1][0] << "; " << bar.m_[1][1]
+            << "; " << bar.m_[1][2] << "); (" << bar.m_[2][0] << "; "
+            << bar.m_[2][1] << "; " << bar.m_[2][2] << "))";
+}
+
+template class BasicMat3<float>;
+template class BasicMat3<double>;
+
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicMat3<float> &bar);
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicMat3<double> &bar);
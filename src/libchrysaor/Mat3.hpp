@@ -0,0 +1,203 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for BasicVec3
+#include <cmath>    // for cos, sin
+#include <cstddef>  // for size_t
+#include <iostream> // for ostream
+
+/**
+ * @brief 3x3 matrix, row-major
+ *
+ * Mostly used as a rotation matrix, for frame transformations.
+ *
+ * Follows the Vec3 conventions: everything is constexpr and inline,
+ * and the scalar type is a template parameter.
+ *
+ * @tparam T scalar type
+ */
+template <typename T> class BasicMat3 {
+public:
+  /**
+   * @brief the elements, m_[row][column]
+   *
+   */
+  T m_[3][3];
+
+  constexpr bool operator==(const BasicMat3 &rhs) const {
+    return (m_[0][0] == rhs.m_[0][0] && m_[0][1] == rhs.m_[0][1] &&
+            m_[0][2] == rhs.m_[0][2] && m_[1][0] == rhs.m_[1][0] &&
+            m_[1][1] == rhs.m_[1][1] && m_[1][2] == rhs.m_[1][2] &&
+            m_[2][0] == rhs.m_[2][0] && m_[2][1] == rhs.m_[2][1] &&
+            m_[2][2] == rhs.m_[2][2]);
+  }
+
+  /**
+   * @brief matrix-vector product
+   *
+   * @return BasicVec3<T>
+   */
+  constexpr BasicVec3<T> operator*(BasicVec3<T> v) const {
+    return BasicVec3<T>(m_[0][0] * v.x_ + m_[0][1] * v.y_ + m_[0][2] * v.z_,
+                        m_[1][0] * v.x_ + m_[1][1] * v.y_ + m_[1][2] * v.z_,
+                        m_[2][0] * v.x_ + m_[2][1] * v.y_ + m_[2][2] * v.z_);
+  }
+
+  /**
+   * @brief matrix-matrix product, i.e. composition of transformations
+   *
+   * (A * B) * v == A * (B * v)
+   *
+   * @return BasicMat3
+   */
+  constexpr BasicMat3 operator*(const BasicMat3 &rhs) const {
+    BasicMat3 res;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        res.m_[i][j] = m_[i][0] * rhs.m_[0][j] + m_[i][1] * rhs.m_[1][j] +
+                       m_[i][2] * rhs.m_[2][j];
+      }
+    }
+    return res;
+  }
+
+  /**
+   * @brief transposed matrix. For a rotation matrix, it is the inverse.
+   *
+   * @return BasicMat3
+   */
+  constexpr BasicMat3 transpose() const {
+    return BasicMat3(m_[0][0], m_[1][0], m_[2][0], m_[0][1], m_[1][1],
+                     m_[2][1], m_[0][2], m_[1][2], m_[2][2]);
+  }
+
+  /**
+   * @brief determinant. For a rotation matrix, it is 1.
+   *
+   * @return T
+   */
+  constexpr T determinant() const {
+    return m_[0][0] * (m_[1][1] * m_[2][2] - m_[1][2] * m_[2][1]) -
+           m_[0][1] * (m_[1][0] * m_[2][2] - m_[1][2] * m_[2][0]) +
+           m_[0][2] * (m_[1][0] * m_[2][1] - m_[1][1] * m_[2][0]);
+  }
+
+  /**
+   * @brief batched matrix-vector product, over SoA arrays
+   *
+   * \f$(ox_i, oy_i, oz_i) = M (x_i, y_i, z_i)\f$, for i in [0, n)
+   *
+   * Output arrays may be the same as the input ones.
+   * For float and double, it is an explicit SIMD kernel, see Simd.hpp
+   *
+   * @param x input x coordinates
+   * @param y input y coordinates
+   * @param z input z coordinates
+   * @param ox output x coordinates
+   * @param oy output y coordinates
+   * @param oz output z coordinates
+   * @param n number of vectors
+   */
+  void apply(const T *x, const T *y, const T *z, T *ox, T *oy, T *oz,
+             std::size_t n) const;
+
+  /**
+   * @brief identity matrix
+   *
+   * @return BasicMat3
+   */
+  static constexpr BasicMat3 Identity() {
+    return BasicMat3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+  }
+
+  /**
+   * @brief rotation matrix, around Z axis, from pre-computed sin and cos
+   *
+   * Rotates the vector counter-clockwise by the angle, when looking from +Z.
+   *
+   * @param c cos of the angle
+   * @param s sin of the angle
+   * @return BasicMat3
+   */
+  static constexpr BasicMat3 RotationZ(T c, T s) {
+    return BasicMat3(c, -s, 0.0, s, c, 0.0, 0.0, 0.0, 1.0);
+  }
+
+  /**
+   * @brief rotation matrix, around Z axis
+   *
+   * @param angle rotation angle [rad]
+   * @return BasicMat3
+   */
+  static BasicMat3 RotationZ(T angle) {
+    using std::cos;
+    using std::sin;
+    return RotationZ(cos(angle), sin(angle));
+  }
+
+  constexpr BasicMat3()
+      : m_{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}} {}
+  constexpr BasicMat3(T m00, T m01, T m02, T m10, T m11, T m12, T m20, T m21,
+                      T m22)
+      : m_{{m00, m01, m02}, {m10, m11, m12}, {m20, m21, m22}} {}
+
+  /**
+   * @brief creates matrix from it's rows
+   *
+   */
+  constexpr BasicMat3(BasicVec3<T> r0, BasicVec3<T> r1, BasicVec3<T> r2)
+      : m_{{r0.x_, r0.y_, r0.z_},
+           {r1.x_, r1.y_, r1.z_},
+           {r2.x_, r2.y_, r2.z_}} {}
+};
+
+template <typename T>
+void BasicMat3<T>::apply(const T *x, const T *y, const T *z, T *ox, T *oy,
+                         T *oz, std::size_t n) const {
+  for (std::size_t i = 0; i < n; i++) {
+    const BasicVec3<T> v = *this * BasicVec3<T>(x[i], y[i], z[i]);
+    ox[i] = v.x_;
+    oy[i] = v.y_;
+    oz[i] = v.z_;
+  }
+}
+
+template <>
+void BasicMat3<float>::apply(const float *x, const float *y, const float *z,
+                             float *ox, float *oy, float *oz,
+                             std::size_t n) const;
+template <>
+void BasicMat3<double>::apply(const double *x, const double *y,
+                              const double *z, double *ox, double *oy,
+                              double *oz, std::size_t n) const;
+
+template <typename T>
+std::ostream &operator<<(::std::ostream &os, const BasicMat3<T> &bar);
+
+extern template class BasicMat3<float>;
+extern template class BasicMat3<double>;
+
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicMat3<float> &bar);
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicMat3<double> &bar);
+
+using Mat3f = BasicMat3<float>;
+using Mat3 = BasicMat3<double>;
@@ -0,0 +1,241 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumericalPropagator.hpp"
+#include "Gravity/ZonalGravity.hpp" // for ZonalGravity
+#include <algorithm>                // for max
+#include <cassert>                  // for assert
+#include <cmath>                    // for ceil, abs, sqrt, isfinite
+
+constexpr int NumericalPropagator::States;
+constexpr int NumericalPropagator::Points;
+constexpr double NumericalPropagator::GradientStep;
+constexpr int NumericalPropagator::BatchScratch;
+
+void NumericalPropagator::Rates(const double *y, double *dy, int size) {
+  px_[0] = y[0];
+  py_[0] = y[1];
+  pz_[0] = y[2];
+
+  const bool matrix = size == States;
+  double h = 0.0;
+  if (matrix) {
+    h = GradientStep * std::sqrt(y[0] * y[0] + y[1] * y[1] + y[2] * y[2]);
+    for (int k = 0; k < 3; k++) {
+      for (int s = 0; s < 2; s++) {
+        const int i = 1 + 2 * k + s;
+        const double d = s == 0 ? -h : h;
+        px_[i] = y[0] + (k == 0 ? d : 0.0);
+        py_[i] = y[1] + (k == 1 ? d : 0.0);
+        pz_[i] = y[2] + (k == 2 ? d : 0.0);
+      }
+    }
+  }
+
+  gravity_->Acceleration(px_, py_, pz_, ax_, ay_, az_, matrix ? Points : 1);
+
+  dy[0] = y[3];
+  dy[1] = y[4];
+  dy[2] = y[5];
+  dy[3] = ax_[0];
+  dy[4] = ay_[0];
+  dy[5] = az_[0];
+
+  if (!matrix)
+    return;
+
+  // the gravity gradient, G[i][k] = da_i/dr_k
+  const double ih = 0.5 / h;
+  double G[3][3];
+  for (int k = 0; k < 3; k++) {
+    G[0][k] = (ax_[2 + 2 * k] - ax_[1 + 2 * k]) * ih;
+    G[1][k] = (ay_[2 + 2 * k] - ay_[1 + 2 * k]) * ih;
+    G[2][k] = (az_[2 + 2 * k] - az_[1 + 2 * k]) * ih;
+  }
+
+  // the position rows move with the velocity rows, and those with G times
+  // the position rows
+  const double *phi = y + 6;
+  double *dphi = dy + 6;
+  for (int j = 0; j < 6; j++) {
+    for (int i = 0; i < 3; i++) {
+      dphi[6 * i + j] = phi[6 * (3 + i) + j];
+      dphi[6 * (3 + i) + j] = G[i][0] * phi[j] + G[i][1] * phi[6 + j] +
+                              G[i][2] * phi[12 + j];
+    }
+  }
+}
+
+namespace {
+
+// sum += w*rate and stage = state + o*rate, over the batch, out of line, not
+// unrolled into the frame of the batched Propagate()
+__attribute__((noinline)) void Accumulate(const double *state,
+                                          std::size_t stride,
+                                          const double *rate, std::size_t n,
+                                          double w, double o, double *sum,
+                                          double *stage) {
+  for (int k = 0; k < 6; k++) {
+    const double *r = rate + k * n;
+    for (std::size_t i = 0; i < n; i++) {
+      sum[k * n + i] += w * r[i];
+      stage[k * n + i] = state[k * stride + i] + o * r[i];
+    }
+  }
+}
+
+} // namespace
+
+int NumericalPropagator::Steps(double dt) const {
+  return std::max(1, static_cast<int>(std::ceil(std::abs(dt) / step_)));
+}
+
+void NumericalPropagator::Rates(const double *y, std::size_t stride,
+                                double *dy, std::size_t n) const {
+  for (int k = 0; k < 3; k++)
+    for (std::size_t i = 0; i < n; i++)
+      dy[k * n + i] = y[(3 + k) * stride + i];
+
+  gravity_->Acceleration(y, y + stride, y + 2 * stride, dy + 3 * n,
+                         dy + 4 * n, dy + 5 * n, n);
+}
+
+void NumericalPropagator::Integrate(double dt, int size) {
+  const int steps = Steps(dt);
+  const double h = dt / steps;
+
+  // the weights of the rates in the new state, and the offsets of the next
+  // stage
+  const double weight[4] = {h / 6.0, h / 3.0, h / 3.0, h / 6.0};
+  const double offset[4] = {0.5 * h, 0.5 * h, h, 0.0};
+
+  for (int step = 0; step < steps; step++) {
+    for (int i = 0; i < size; i++)
+      sum_[i] = state_[i];
+
+    const double *y = state_;
+    for (int stage = 0; stage < 4; stage++) {
+      Rates(y, rate_, size);
+      for (int i = 0; i < size; i++) {
+        sum_[i] += weight[stage] * rate_[i];
+        stage_[i] = state_[i] + offset[stage] * rate_[i];
+      }
+      y = stage_;
+    }
+
+    for (int i = 0; i < size; i++)
+      state_[i] = sum_[i];
+  }
+}
+
+NumericalPropagator::NumericalPropagator(const ZonalGravity *gravity,
+                                         double step)
+    : gravity_(gravity), step_(step), state_(), sum_(), stage_(), rate_(),
+      px_(), py_(), pz_(), ax_(), ay_(), az_() {
+  assert(gravity);
+  assert(std::isfinite(step));
+  assert(step > 0.0);
+}
+
+void NumericalPropagator::Propagate(Vec3 position, Vec3 velocity, double dt,
+                                    Vec3 *newPosition, Vec3 *newVelocity) {
+  assert(newPosition);
+  assert(newVelocity);
+  assert(std::isfinite(dt));
+
+  state_[0] = position.x_;
+  state_[1] = position.y_;
+  state_[2] = position.z_;
+  state_[3] = velocity.x_;
+  state_[4] = velocity.y_;
+  state_[5] = velocity.z_;
+
+  if (dt != 0.0)
+    Integrate(dt, 6);
+
+  *newPosition = Vec3(state_[0], state_[1], state_[2]);
+  *newVelocity = Vec3(state_[3], state_[4], state_[5]);
+}
+
+void NumericalPropagator::Propagate(Vec3 position, Vec3 velocity, double dt,
+                                    Vec3 *newPosition, Vec3 *newVelocity,
+                                    double *stm) {
+  assert(newPosition);
+  assert(newVelocity);
+  assert(stm);
+  assert(std::isfinite(dt));
+
+  state_[0] = position.x_;
+  state_[1] = position.y_;
+  state_[2] = position.z_;
+  state_[3] = velocity.x_;
+  state_[4] = velocity.y_;
+  state_[5] = velocity.z_;
+  for (int i = 0; i < 36; i++)
+    state_[6 + i] = i % 7 == 0 ? 1.0 : 0.0;
+
+  if (dt != 0.0)
+    Integrate(dt, States);
+
+  *newPosition = Vec3(state_[0], state_[1], state_[2]);
+  *newVelocity = Vec3(state_[3], state_[4], state_[5]);
+  for (int i = 0; i < 36; i++)
+    stm[i] = state_[6 + i];
+}
+
+void NumericalPropagator::Propagate(double *state, std::size_t stride,
+                                    std::size_t n, double dt,
+                                    double *scratch) const {
+  assert(state);
+  assert(scratch);
+  assert(stride >= n);
+  assert(std::isfinite(dt));
+
+  if (dt == 0.0 || n == 0)
+    return;
+
+  double *sum = scratch;
+  double *stage = scratch + 6 * n;
+  double *rate = scratch + 12 * n;
+
+  const int steps = Steps(dt);
+  const double h = dt / steps;
+
+  // as in Integrate()
+  const double weight[4] = {h / 6.0, h / 3.0, h / 3.0, h / 6.0};
+  const double offset[4] = {0.5 * h, 0.5 * h, h, 0.0};
+
+  for (int step = 0; step < steps; step++) {
+    for (int k = 0; k < 6; k++)
+      for (std::size_t i = 0; i < n; i++)
+        sum[k * n + i] = state[k * stride + i];
+
+    const double *y = state;
+    std::size_t ys = stride;
+    for (int s = 0; s < 4; s++) {
+      Rates(y, ys, rate, n);
+      Accumulate(state, stride, rate, n, weight[s], offset[s], sum, stage);
+      y = stage;
+      ys = n;
+    }
+
+    for (int k = 0; k < 6; k++)
+      for (std::size_t i = 0; i < n; i++)
+        state[k * stride + i] = sum[k * n + i];
+  }
+}
@@ -0,0 +1,218 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class ZonalGravity;
+
+/**
+ * @brief the numerical propagator, in the zonal gravity field
+ *
+ * The equations of the motion are integrated by the classic fixed-step
+ * Runge-Kutta method of the 4th order, with the step of at most the given
+ * one, evenly dividing the time of flight.
+ *
+ * With the state transition matrix, the variational equations
+ *
+ * \f$\dot\Phi=\left(\begin{array}{cc}0&I\\G&0\end{array}\right)\Phi\f$,
+ * \f$G={{\partial\vec{a}}\over{\partial\vec{r}}}\f$
+ *
+ * are integrated along, by the same steps. The gravity gradient
+ * \f$G\f$ is the central differences of the force model itself, taken in
+ * one call of its batched evaluation, together with the acceleration: 7
+ * positions, instead of the 6 to 12 extra propagations of the finite
+ * differences of the whole trajectory.
+ *
+ * The integration state lives in the propagator, so no call allocates.
+ * A propagator is stateful, one per thread.
+ *
+ * \see Montenbruck, Gill, Satellite Orbits, 7.1
+ */
+class NumericalPropagator {
+public:
+  /**
+   * @brief the size of the integrated state, position, velocity, and the
+   * state transition matrix
+   *
+   */
+  static constexpr int States = 42;
+
+  /**
+   * @brief the number of the force model evaluations per rate
+   *
+   */
+  static constexpr int Points = 7;
+
+  /**
+   * @brief the step of the central differences, relative to the radius
+   *
+   */
+  static constexpr double GradientStep = 1e-5;
+
+  /**
+   * @brief the scratch of the batched Propagate(), the doubles per state
+   *
+   */
+  static constexpr int BatchScratch = 18;
+
+private:
+  /**
+   * @brief the force model
+   *
+   */
+  const ZonalGravity *gravity_;
+
+  /**
+   * @brief the maximal step [s]
+   *
+   */
+  double step_;
+
+  /**
+   * @brief the state, position, velocity, then the row-major matrix
+   *
+   */
+  double state_[States];
+
+  /**
+   * @brief the Runge-Kutta scratch: the new state, the stage state and
+   * the rate
+   *
+   */
+  double sum_[States];
+  double stage_[States];
+  double rate_[States];
+
+  /**
+   * @brief the positions of the force model evaluations, the point, then
+   * the pairs of the differences along x, y and z [m]
+   *
+   */
+  double px_[Points];
+  double py_[Points];
+  double pz_[Points];
+
+  /**
+   * @brief the accelerations at those [m/s^2]
+   *
+   */
+  double ax_[Points];
+  double ay_[Points];
+  double az_[Points];
+
+  /**
+   * @brief the rate of the state
+   *
+   * @param y the state
+   * @param dy the rate
+   * @param size 6, or States with the matrix
+   */
+  void Rates(const double *y, double *dy, int size);
+
+  /**
+   * @brief integrates state_ by the time of flight
+   *
+   * @param dt the time of flight [s]
+   * @param size 6, or States with the matrix
+   */
+  void Integrate(double dt, int size);
+
+  /**
+   * @brief the number of the steps for the time of flight
+   *
+   * @param dt the time of flight [s]
+   * @return int
+   */
+  int Steps(double dt) const;
+
+  /**
+   * @brief the rates of a batch of the states, SoA
+   *
+   * @param y the states, the arrays stride apart
+   * @param stride the distance of the arrays of y
+   * @param dy the rates, the arrays n apart
+   * @param n the number of the states
+   */
+  void Rates(const double *y, std::size_t stride, double *dy,
+             std::size_t n) const;
+
+public:
+  /**
+   * @brief the propagator in the given field
+   *
+   * @param gravity the force model
+   * @param step the maximal step [s]
+   */
+  NumericalPropagator(const ZonalGravity *gravity, double step);
+
+  /**
+   * @brief propagates the state by the given time of flight
+   *
+   * @param position the initial position, relative to the body [m]
+   * @param velocity the initial velocity, relative to the body [m/s]
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param newPosition the position after dt [m]
+   * @param newVelocity the velocity after dt [m/s]
+   */
+  void Propagate(Vec3 position, Vec3 velocity, double dt, Vec3 *newPosition,
+                 Vec3 *newVelocity);
+
+  /**
+   * @brief propagates the state, and its state transition matrix
+   *
+   * @param position the initial position, relative to the body [m]
+   * @param velocity the initial velocity, relative to the body [m/s]
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param newPosition the position after dt [m]
+   * @param newVelocity the velocity after dt [m/s]
+   * @param stm the state transition matrix, row-major 6x6, as in
+   * TwoBodyPropagator
+   */
+  void Propagate(Vec3 position, Vec3 velocity, double dt, Vec3 *newPosition,
+                 Vec3 *newVelocity, double *stm);
+
+  /**
+   * @brief propagates a batch of the states in place, without the matrix
+   *
+   * The states are SoA, x, y, z, vx, vy and vz of the state i are
+   * state[i], state[stride + i], ..., state[5 * stride + i]. Each stage is
+   * one batched call of the force model over all of them.
+   *
+   * The scratch is the caller's, so the call does not allocate and does not
+   * touch the propagator: one propagator serves any number of threads, each
+   * with its own scratch.
+   *
+   * @param state the states [m], [m/s]
+   * @param stride the distance of the arrays of state, at least n
+   * @param n the number of the states
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param scratch BatchScratch * n doubles
+   */
+  void Propagate(double *state, std::size_t stride, std::size_t n, double dt,
+                 double *scratch) const;
+
+  /**
+   * @brief the maximal step [s]
+   *
+   * @return double
+   */
+  double Step() const { return step_; }
+};
@@ -0,0 +1,111 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Orbit.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include <cassert>           // for assert
+#include <cmath>             // for sqrt, hypot, isfinite
+
+namespace {
+
+// the bits of Orbit::known_
+enum : unsigned {
+  KnownSma = 1U << 0,
+  KnownEcc = 1U << 1,
+  KnownEpsilon = 1U << 2,
+};
+
+} // namespace
+
+Orbit::Orbit(double Vx, double Vy, double altitude,
+             const CelestialBody *parentBody)
+    : parentBody_(parentBody), r_(0), vr_(Vy), vh_(Vx), known_(0), sma_(0),
+      ecc_(0), epsilon_(0) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->mu_));
+  assert(parentBody->mu_ > 0);
+  assert(std::isfinite(parentBody->R_));
+  assert(parentBody->R_ >= 0.0);
+
+  assert(std::isfinite(Vx));
+  assert(std::isfinite(Vy));
+  assert(std::isfinite(altitude));
+
+  // all math assumes the radius to be from the center of parent body.
+  r_ = altitude + parentBody->R_;
+
+  assert(r_ > 0.0);
+}
+
+Orbit::Orbit(Vec3 position, Vec3 velocity, const CelestialBody *parentBody)
+    : parentBody_(parentBody), r_(position.norm()), vr_(0), vh_(0), known_(0),
+      sma_(0), ecc_(0), epsilon_(0) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->mu_));
+  assert(parentBody->mu_ > 0);
+
+  assert(std::isfinite(r_));
+  assert(r_ > 0.0);
+
+  vr_ = position.dot(velocity) / r_;
+  vh_ = position.cross(velocity).norm() / r_;
+
+  assert(std::isfinite(vr_));
+  assert(std::isfinite(vh_));
+}
+
+double Orbit::Speed() const { return std::hypot(vr_, vh_); }
+
+SpecificOrbitalEnergy Orbit::Epsilon() const {
+  if (!(known_ & KnownEpsilon)) {
+    epsilon_ = 0.5 * (vr_ * vr_ + vh_ * vh_) - parentBody_->mu_ / r_;
+    known_ |= KnownEpsilon;
+  }
+
+  return SpecificOrbitalEnergy(epsilon_);
+}
+
+SemiMajorAxis Orbit::Sma() const {
+  if (!(known_ & KnownSma)) {
+    const double v2 = vr_ * vr_ + vh_ * vh_;
+    sma_ = r_ / (2.0 - r_ * v2 / parentBody_->mu_);
+    known_ |= KnownSma;
+  }
+
+  return SemiMajorAxis(sma_);
+}
+
+OrbitalEccentricity Orbit::Ecc() const {
+  if (!(known_ & KnownEcc)) {
+    const double k = r_ * vh_ / parentBody_->mu_;
+    ecc_ = std::hypot(k * vh_ - 1.0, k * vr_);
+    known_ |= KnownEcc;
+  }
+
+  return OrbitalEccentricity(ecc_);
+}
+
+SpecificRelativeAngularMomentum Orbit::Srh() const {
+  return SpecificRelativeAngularMomentum(r_ * (vh_ < 0.0 ? -vh_ : vh_));
+}
+
+// from the angular momentum, not the semi-major axis, which the parabolic
+// orbits do not have
+Apoapsis Orbit::Ap() const { return Apoapsis(Ecc(), Srh(), parentBody_); }
+
+Periapsis Orbit::Pe() const { return Periapsis(Ecc(), Srh(), parentBody_); }
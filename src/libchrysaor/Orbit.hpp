@@ -0,0 +1,201 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "OrbitalElements/Apoapsis.hpp"              // for Apoapsis
+#include "OrbitalElements/OrbitalEccentricity.hpp"   // for OrbitalEccentricity
+#include "OrbitalElements/Periapsis.hpp"             // for Periapsis
+#include "OrbitalElements/SemiMajorAxis.hpp"         // for SemiMajorAxis
+#include "OrbitalElements/SpecificOrbitalEnergy.hpp" // for SpecificOrbitalEnergy
+#include "SpecificRelativeAngularMomentum.hpp"       // for SpecificRelativeAngularMomentum
+#include "Vec3.hpp"                                  // for Vec3
+
+class CelestialBody;
+
+/**
+ * @brief an orbit, with all its elements
+ *
+ * Constructing the element classes one by one, e.g.
+ * SemiMajorAxis(Vx, Vy, altitude, body), OrbitalEccentricity(Vx, Vy,
+ * altitude, body), Apoapsis(sma, ecc, body), redoes the same work in each of
+ * them. Instead, this reduces the state to the radius \f$r\f$ and the
+ * radial and the horizontal velocity components \f$v_r\f$, \f$v_h\f$ once,
+ * and each element is derived from them on the first access only, and then
+ * remembered. So the elements that are never asked for are never computed.
+ *
+ * The memoization is not synchronized, an Orbit must not be shared between
+ * the threads without a lock.
+ */
+class Orbit {
+private:
+  /**
+   * @brief the parent body
+   *
+   */
+  const CelestialBody *parentBody_;
+
+  /**
+   * @brief the radius [m]
+   *
+   */
+  double r_;
+
+  /**
+   * @brief the radial (vertical) velocity [m/s]
+   *
+   */
+  double vr_;
+
+  /**
+   * @brief the horizontal velocity [m/s]
+   *
+   */
+  double vh_;
+
+  /**
+   * @brief the bits of the already computed elements
+   *
+   */
+  mutable unsigned known_;
+
+  /**
+   * @brief the memoized semi-major axis [m]
+   *
+   */
+  mutable double sma_;
+
+  /**
+   * @brief the memoized eccentricity
+   *
+   */
+  mutable double ecc_;
+
+  /**
+   * @brief the memoized specific orbital energy [m^2/s^2]
+   *
+   */
+  mutable double epsilon_;
+
+public:
+  /**
+   * @brief the orbit from the velocity and the altitude
+   *
+   * The same arguments as the ones of the element classes.
+   *
+   * @param Vx horizontal velocity [m/s]
+   * @param Vy vertical velocity [m/s]
+   * @param altitude altitude, from the surface of the parent body [m]
+   * @param parentBody the parent body
+   */
+  Orbit(double Vx, double Vy, double altitude,
+        const CelestialBody *parentBody);
+
+  /**
+   * @brief the orbit from the state vector
+   *
+   * \f$v_r={{\vec{r}\cdot\vec{v}}\over{r}}\f$ and
+   * \f$v_h={{|\vec{r}\times\vec{v}|}\over{r}}\f$.
+   *
+   * @param position the position, relative to the parent body [m]
+   * @param velocity the velocity, relative to the parent body [m/s]
+   * @param parentBody the parent body
+   */
+  Orbit(Vec3 position, Vec3 velocity, const CelestialBody *parentBody);
+
+  /**
+   * @brief the parent body
+   *
+   * @return const CelestialBody*
+   */
+  const CelestialBody *ParentBody() const { return parentBody_; }
+
+  /**
+   * @brief the radius [m]
+   *
+   * @return double
+   */
+  double Radius() const { return r_; }
+
+  /**
+   * @brief the speed [m/s]
+   *
+   * @return double
+   */
+  double Speed() const;
+
+  /**
+   * @brief the specific orbital energy
+   *
+   * \f$\epsilon={{v^2}\over{2}}-{{\mu}\over{r}}\f$
+   *
+   * @return SpecificOrbitalEnergy
+   */
+  SpecificOrbitalEnergy Epsilon() const;
+
+  /**
+   * @brief the semi-major axis
+   *
+   * \f$a={r\over{2-{{rv^2}\over{\mu}}}}\f$, the same form as in
+   * SemiMajorAxis(Vx, Vy, altitude, parentBody).
+   *
+   * @return SemiMajorAxis
+   */
+  SemiMajorAxis Sma() const;
+
+  /**
+   * @brief the eccentricity
+   *
+   * The eccentricity vector
+   * \f$\vec{e}={{(v^2-{\mu\over{r}})\vec{r}-(\vec{r}\cdot\vec{v})\vec{v}}
+   * \over{\mu}}\f$,
+   * in the radial and the horizontal directions, is
+   * \f$\left({{rv_h^2}\over{\mu}}-1, -{{rv_rv_h}\over{\mu}}\right)\f$.
+   * Its length needs no subtraction of the nearly equal squares, unlike
+   * \f$\sqrt{1+{{2\epsilon h^2}\over{\mu^2}}}\f$, which loses all the
+   * precision for the nearly circular orbits.
+   *
+   * @return OrbitalEccentricity
+   */
+  OrbitalEccentricity Ecc() const;
+
+  /**
+   * @brief the specific relative angular momentum
+   *
+   * \f$h=rv_h\f$, this is not memoized, it is just a multiplication.
+   *
+   * @return SpecificRelativeAngularMomentum
+   */
+  SpecificRelativeAngularMomentum Srh() const;
+
+  /**
+   * @brief the apoapsis
+   *
+   * At infinity, for the parabolic and the hyperbolic orbits.
+   *
+   * @return Apoapsis
+   */
+  Apoapsis Ap() const;
+
+  /**
+   * @brief the periapsis
+   *
+   * @return Periapsis
+   */
+  Periapsis Pe() const;
+};
@@ -0,0 +1,103 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitInsertion.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Simd.hpp"          // for Simd
+#include "SimdMath.hpp"      // for SimdSqrt, SimdAtan2
+#include <cassert>           // for assert
+#include <cmath>             // for sqrt, atan2, isfinite
+#include <cstring>           // for memcpy
+
+namespace {
+
+typedef Simd<double>::type V;
+
+// one block of the batch, call-free
+__attribute__((noinline)) void Block(double mu, double R,
+                                     const double *altitude,
+                                     const double *ApA, const double *PeA,
+                                     double *Vx, double *Vy, double *gamma) {
+  V r, ra, rp;
+  std::memcpy(&r, altitude, sizeof(V));
+  std::memcpy(&ra, ApA, sizeof(V));
+  std::memcpy(&rp, PeA, sizeof(V));
+  r += R;
+  ra += R;
+  rp += R;
+
+  const V k = 2.0 * mu / (ra + rp);
+  V x, y, g;
+  SimdSqrt(k * ra * rp, &x);
+  SimdSqrt(k * (r - rp) * (ra - r), &y);
+  x /= r;
+  y /= r;
+  SimdAtan2(y, x, &g);
+
+  std::memcpy(Vx, &x, sizeof(V));
+  std::memcpy(Vy, &y, sizeof(V));
+  std::memcpy(gamma, &g, sizeof(V));
+}
+
+} // namespace
+
+OrbitInsertion::OrbitInsertion(double altitude, double ApA, double PeA,
+                               const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->mu_));
+  assert(parentBody->mu_ > 0);
+  assert(std::isfinite(parentBody->R_));
+  assert(parentBody->R_ >= 0.0);
+
+  assert(std::isfinite(altitude));
+  assert(std::isfinite(ApA));
+  assert(std::isfinite(PeA));
+  assert(PeA <= altitude && altitude <= ApA);
+
+  // all math assumes the radius to be from the center of parent body.
+  const double r = altitude + parentBody->R_;
+  const double ra = ApA + parentBody->R_;
+  const double rp = PeA + parentBody->R_;
+  assert(rp > 0.0);
+
+  const double k = 2.0 * parentBody->mu_ / (ra + rp);
+  Vx_ = std::sqrt(k * ra * rp) / r;
+  Vy_ = std::sqrt(k * (r - rp) * (ra - r)) / r;
+  gamma_ = std::atan2(Vy_, Vx_);
+}
+
+void OrbitInsertion::Solve(const CelestialBody *parentBody,
+                           const double *altitude, const double *ApA,
+                           const double *PeA, double *Vx, double *Vy,
+                           double *gamma, std::size_t n) {
+  assert(parentBody);
+
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    Block(parentBody->mu_, parentBody->R_, altitude + i, ApA + i, PeA + i,
+          Vx + i, Vy + i, gamma + i);
+
+  for (; i < n; i++) {
+    const OrbitInsertion insertion(altitude[i], ApA[i], PeA[i], parentBody);
+    Vx[i] = insertion.Vx_;
+    Vy[i] = insertion.Vy_;
+    gamma[i] = insertion.gamma_;
+  }
+}
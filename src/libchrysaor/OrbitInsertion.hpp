@@ -0,0 +1,106 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief the burnout state that inserts into the given orbit
+ *
+ * The inverse of SemiMajorAxis(Vx, Vy, altitude, body) and
+ * OrbitalEccentricity(Vx, Vy, altitude, body): from the burnout altitude and
+ * the target apoapsis and periapsis, the horizontal and the vertical
+ * velocity, and the flight-path angle.
+ *
+ * The target fixes the specific orbital energy,
+ * \f$\epsilon=-{\mu\over{r_a+r_p}}\f$, and the angular momentum,
+ * \f$h^2=\mu{a}(1-e^2)={{2\mu{r_a}{r_p}}\over{r_a+r_p}}\f$, so there is a
+ * closed form, no iteration:
+ *
+ * \f$V_x={h\over{r}}={1\over{r}}\sqrt{{2\mu{r_a}{r_p}}\over{r_a+r_p}}\f$
+ *
+ * \f$V_y=\sqrt{v^2-V_x^2}={1\over{r}}
+ * \sqrt{{2\mu(r-r_p)(r_a-r)}\over{r_a+r_p}}\f$
+ *
+ * The factored \f$V_y\f$ does not cancel when the burnout is near an apsis,
+ * unlike \f$v^2-V_x^2\f$, which is the difference of two nearly equal
+ * speeds there.
+ *
+ * The burnout altitude must be between the periapsis and the apoapsis. The
+ * vertical velocity is the one of the ascending (towards the apoapsis)
+ * burnout, the descending one is \f$-V_y\f$.
+ */
+class OrbitInsertion {
+public:
+  /**
+   * @brief the horizontal velocity [m/s]
+   *
+   */
+  double Vx_ = 0.0;
+
+  /**
+   * @brief the vertical velocity [m/s]
+   *
+   */
+  double Vy_ = 0.0;
+
+  /**
+   * @brief the flight-path angle, above the local horizon [rad]
+   *
+   */
+  double gamma_ = 0.0;
+
+  /**
+   * @brief dummy constructor.
+   *
+   */
+  OrbitInsertion() = default;
+
+  /**
+   * @brief solves for the burnout velocity
+   *
+   * @param altitude the burnout altitude, from the surface of the parent
+   * body [m]
+   * @param ApA the target apoapsis altitude [m]
+   * @param PeA the target periapsis altitude [m]
+   * @param parentBody the parent body
+   */
+  OrbitInsertion(double altitude, double ApA, double PeA,
+                 const CelestialBody *parentBody);
+
+  /**
+   * @brief solves for n burnout velocities, structure-of-arrays.
+   *
+   * Same as the constructor, in SIMD lanes.
+   *
+   * @param parentBody the parent body
+   * @param altitude the burnout altitudes [m]
+   * @param ApA the target apoapsis altitudes [m]
+   * @param PeA the target periapsis altitudes [m]
+   * @param Vx the horizontal velocities [m/s]
+   * @param Vy the vertical velocities [m/s]
+   * @param gamma the flight-path angles [rad]
+   * @param n the number of the targets
+   */
+  static void Solve(const CelestialBody *parentBody, const double *altitude,
+                    const double *ApA, const double *PeA, double *Vx,
+                    double *Vy, double *gamma, std::size_t n);
+};
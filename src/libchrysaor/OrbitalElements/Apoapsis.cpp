@@ -20,9 +20,20 @@
 #include "OrbitalElements/Apsis.hpp"               // for Apsis
 #include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
 #include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp" // for SpecificRelativeAngularMomentum
+#include <limits>                              // for numeric_limits
 
-Apoapsis::operator double() const { return (sma_ * (1.0 + ecc_)); }
+Apoapsis::operator double() const {
+  if (ecc_ < 1.0)
+    return (periapsis_ * (1.0 + ecc_) / (1.0 - ecc_));
+
+  return std::numeric_limits<double>::infinity();
+}
 
 Apoapsis::Apoapsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
                    const CelestialBody *parentBody)
     : Apsis(sma, ecc, parentBody) {}
+
+Apoapsis::Apoapsis(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+                   const CelestialBody *parentBody)
+    : Apsis(ecc, srh, parentBody) {}
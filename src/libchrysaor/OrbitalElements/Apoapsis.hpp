@@ -23,12 +23,16 @@
 class CelestialBody;
 class SemiMajorAxis;
 class OrbitalEccentricity;
+class SpecificRelativeAngularMomentum;
 
 /**
  * @brief apoapsis class
  *
  * Extreme point of orbit, the orbit's farthest point
  *
+ * \f$r_a=r_p{{1+e}\over{1-e}}\f$, which is \f$a(1+e)\f$; the parabolic and
+ * the hyperbolic orbits never turn back, their apoapsis is at infinity.
+ *
  * \see https://en.wikipedia.org/wiki/Apsis
  */
 class Apoapsis : public Apsis {
@@ -48,4 +52,16 @@ public:
    */
   Apoapsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
            const CelestialBody *parentBody);
+
+  /**
+   * @brief creates Apoapsis object from passed characteristics
+   *
+   * This 'creates' orbit's farthest point, of any orbit
+   *
+   * @param ecc eccentricity of the orbit
+   * @param srh specific relative angular momentum [m^2/s]
+   * @param parentBody the parent body
+   */
+  Apoapsis(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+           const CelestialBody *parentBody);
 };
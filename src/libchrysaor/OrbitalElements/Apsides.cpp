@@ -0,0 +1,116 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/Apsides.hpp"
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "Simd.hpp"                                // for Simd
+#include "SpecificRelativeAngularMomentum.hpp" // for SpecificRelativeAngularMomentum
+#include <cassert>                             // for assert
+#include <cmath>                               // for isfinite
+#include <cstring>                             // for memcpy
+#include <limits>                              // for numeric_limits
+
+namespace {
+
+typedef Simd<double>::type V;
+
+const double Infinity = std::numeric_limits<double>::infinity();
+
+// one block of the batch, call-free
+__attribute__((noinline)) void Block(double R, const double *a,
+                                     const double *e, double *periapsis,
+                                     double *apoapsis,
+                                     double *periapsisAltitude,
+                                     double *apoapsisAltitude) {
+  V sma, ecc;
+  std::memcpy(&sma, a, sizeof(V));
+  std::memcpy(&ecc, e, sizeof(V));
+
+  const V one = V{} + 1.0;
+  const V infinity = V{} + Infinity;
+
+  const V rp = sma * (1.0 - ecc);
+  const V ra = ecc < one ? sma * (1.0 + ecc) : infinity;
+
+  const V hp = rp - R;
+  const V ha = ra - R;
+  std::memcpy(periapsis, &rp, sizeof(V));
+  std::memcpy(apoapsis, &ra, sizeof(V));
+  std::memcpy(periapsisAltitude, &hp, sizeof(V));
+  std::memcpy(apoapsisAltitude, &ha, sizeof(V));
+}
+
+} // namespace
+
+Apsides::Apsides(SemiMajorAxis sma, OrbitalEccentricity ecc,
+                 const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->R_));
+
+  // the semi-major axis and 1 - e are of the same sign
+  assert((sma > 0.0) == (ecc < 1.0));
+  assert(ecc != 1.0);
+
+  periapsis_ = sma * (1.0 - ecc);
+  apoapsis_ = ecc < 1.0 ? sma * (1.0 + ecc) : Infinity;
+  periapsisAltitude_ = periapsis_ - parentBody->R_;
+  apoapsisAltitude_ = apoapsis_ - parentBody->R_;
+}
+
+Apsides::Apsides(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+                 const CelestialBody *parentBody) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->mu_));
+  assert(parentBody->mu_ > 0);
+  assert(std::isfinite(parentBody->R_));
+
+  assert(std::isfinite(srh));
+
+  const double p = srh * srh / parentBody->mu_;
+  periapsis_ = p / (1.0 + ecc);
+  apoapsis_ = ecc < 1.0 ? p / (1.0 - ecc) : Infinity;
+  periapsisAltitude_ = periapsis_ - parentBody->R_;
+  apoapsisAltitude_ = apoapsis_ - parentBody->R_;
+}
+
+void Apsides::FromElements(const CelestialBody *parentBody, const double *a,
+                           const double *e, double *periapsis,
+                           double *apoapsis, double *periapsisAltitude,
+                           double *apoapsisAltitude, std::size_t n) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->R_));
+
+  const double R = parentBody->R_;
+  const std::size_t W = Simd<double>::width;
+
+  std::size_t i = 0;
+  for (; i + W <= n; i += W)
+    Block(R, a + i, e + i, periapsis + i, apoapsis + i, periapsisAltitude + i,
+          apoapsisAltitude + i);
+
+  for (; i < n; i++) {
+    const double rp = a[i] * (1.0 - e[i]);
+    const double ra = e[i] < 1.0 ? a[i] * (1.0 + e[i]) : Infinity;
+    periapsis[i] = rp;
+    apoapsis[i] = ra;
+    periapsisAltitude[i] = rp - R;
+    apoapsisAltitude[i] = ra - R;
+  }
+}
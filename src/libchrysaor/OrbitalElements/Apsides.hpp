@@ -0,0 +1,119 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+class CelestialBody;
+class OrbitalEccentricity;
+class SemiMajorAxis;
+class SpecificRelativeAngularMomentum;
+
+/**
+ * @brief both apsides of an orbit, as a plain value
+ *
+ * The same radii as Periapsis and Apoapsis, but both at once, without the
+ * virtual dispatch, and without keeping the elements around: the whole
+ * object is the four numbers.
+ *
+ * \f$r_p=a(1-e)\f$, \f$r_a=a(1+e)\f$, and for the parabolic and the
+ * hyperbolic orbits, which never turn back, \f$r_a=\infty\f$.
+ *
+ * \see https://en.wikipedia.org/wiki/Apsis
+ */
+class Apsides {
+public:
+  /**
+   * @brief radius of the orbit, at the periapsis [m]
+   *
+   */
+  double periapsis_ = 0.0;
+
+  /**
+   * @brief radius of the orbit, at the apoapsis [m]
+   *
+   */
+  double apoapsis_ = 0.0;
+
+  /**
+   * @brief altitude, from the surface of the parent body, at the periapsis
+   * [m]
+   *
+   */
+  double periapsisAltitude_ = 0.0;
+
+  /**
+   * @brief altitude, from the surface of the parent body, at the apoapsis
+   * [m]
+   *
+   */
+  double apoapsisAltitude_ = 0.0;
+
+  /**
+   * @brief dummy constructor.
+   *
+   */
+  Apsides() = default;
+
+  /**
+   * @brief calculates both apsides from the elements
+   *
+   * Either elliptic, \f$a>0\f$ and \f$e<1\f$, or hyperbolic, \f$a<0\f$
+   * and \f$e>1\f$.
+   *
+   * @param sma semi-major axis of the orbit [m]
+   * @param ecc eccentricity of the orbit
+   * @param parentBody the parent body
+   */
+  Apsides(SemiMajorAxis sma, OrbitalEccentricity ecc,
+          const CelestialBody *parentBody);
+
+  /**
+   * @brief calculates both apsides from the eccentricity and the angular
+   * momentum
+   *
+   * \f$r_p={h^2\over{\mu(1+e)}}\f$ and \f$r_a={h^2\over{\mu(1-e)}}\f$, any
+   * orbit, the parabolic ones too.
+   *
+   * @param ecc eccentricity of the orbit
+   * @param srh specific relative angular momentum [m^2/s]
+   * @param parentBody the parent body
+   */
+  Apsides(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+          const CelestialBody *parentBody);
+
+  /**
+   * @brief calculates the apsides of n orbits, structure-of-arrays.
+   *
+   * Same as the constructor, in SIMD lanes, without branches.
+   *
+   * @param parentBody the parent body
+   * @param a the semi-major axes [m]
+   * @param e the eccentricities
+   * @param periapsis the radii at the periapsis [m]
+   * @param apoapsis the radii at the apoapsis [m]
+   * @param periapsisAltitude the altitudes at the periapsis [m]
+   * @param apoapsisAltitude the altitudes at the apoapsis [m]
+   * @param n the number of the orbits
+   */
+  static void FromElements(const CelestialBody *parentBody, const double *a,
+                           const double *e, double *periapsis,
+                           double *apoapsis, double *periapsisAltitude,
+                           double *apoapsisAltitude, std::size_t n);
+};
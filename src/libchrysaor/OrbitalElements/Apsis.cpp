@@ -17,9 +17,42 @@
  */
 
 #include "OrbitalElements/Apsis.hpp"
-#include "CelestialBody.hpp" // for CelestialBody
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp" // for SpecificRelativeAngularMomentum
+#include <cassert>                             // for assert
+#include <cmath>                               // for isfinite
 
 double Apsis::Radius() const { return static_cast<double>(*this); }
 double Apsis::Altitude() const {
   return ((static_cast<double>(*this)) - (parentBody_->R_));
 }
+
+Apsis::Apsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
+             const CelestialBody *parentBody)
+    : parentBody_(parentBody), periapsis_(0), ecc_(ecc) {
+  // the semi-major axis and 1 - e are of the same sign
+  assert((sma > 0.0) == (ecc < 1.0));
+  assert(ecc != 1.0);
+
+  periapsis_ = sma * (1.0 - ecc);
+
+  assert(std::isfinite(periapsis_));
+  assert(periapsis_ >= 0.0);
+}
+
+Apsis::Apsis(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+             const CelestialBody *parentBody)
+    : parentBody_(parentBody), periapsis_(0), ecc_(ecc) {
+  assert(parentBody);
+  assert(std::isfinite(parentBody->mu_));
+  assert(parentBody->mu_ > 0);
+
+  assert(std::isfinite(srh));
+
+  periapsis_ = srh * srh / (parentBody->mu_ * (1.0 + ecc));
+
+  assert(std::isfinite(periapsis_));
+  assert(periapsis_ >= 0.0);
+}
@@ -22,12 +22,24 @@
 #include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
 
 class CelestialBody;
+class SpecificRelativeAngularMomentum;
 
 /**
  * @brief apsis class
  *
  * Extreme point of orbit
  *
+ * Any conic section is described by its periapsis radius \f$r_p\f$ and
+ * eccentricity, and, unlike the semi-major axis, \f$r_p\f$ is finite for
+ * the parabolic orbits too. For the elliptic (\f$e<1\f$) and the
+ * hyperbolic (\f$e>1\f$) orbits, \f$r_p=a(1-e)\f$, with the usual sign
+ * convention that \f$a<0\f$ for the hyperbolic ones; for all of them,
+ * \f$r_p={p\over{1+e}}\f$, where \f$p={h^2\over\mu}\f$ is the
+ * semi-latus rectum.
+ *
+ * Apsides has both of them at once, as a plain value, without the virtual
+ * dispatch.
+ *
  * \see https://en.wikipedia.org/wiki/Apsis
  */
 class Apsis {
@@ -39,10 +51,10 @@ protected:
   const CelestialBody *parentBody_;
 
   /**
-   * @brief semi-major axis of the orbit [m]
+   * @brief radius of the orbit, at the periapsis [m]
    *
    */
-  SemiMajorAxis sma_;
+  double periapsis_;
 
   /**
    * @brief eccentricity of the orbit
@@ -77,11 +89,25 @@ public:
   /**
    * @brief creates Apsis object from passed characteristics
    *
+   * Either elliptic, \f$a>0\f$ and \f$e<1\f$, or hyperbolic, \f$a<0\f$
+   * and \f$e>1\f$; the parabolic orbits have no semi-major axis.
+   *
    * @param sma semi-major axis of the orbit [m]
    * @param ecc eccentricity of the orbit
    * @param parentBody the parent body
    */
   Apsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
-        const CelestialBody *parentBody)
-      : parentBody_(parentBody), sma_(sma), ecc_(ecc) {}
+        const CelestialBody *parentBody);
+
+  /**
+   * @brief creates Apsis object from passed characteristics
+   *
+   * \f$r_p={h^2\over{\mu(1+e)}}\f$, any orbit, the parabolic ones too.
+   *
+   * @param ecc eccentricity of the orbit
+   * @param srh specific relative angular momentum [m^2/s]
+   * @param parentBody the parent body
+   */
+  Apsis(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+        const CelestialBody *parentBody);
 };
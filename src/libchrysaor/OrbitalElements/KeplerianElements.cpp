@@ -0,0 +1,232 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/KeplerianElements.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Simd.hpp"          // for Simd
+#include "SimdMath.hpp"      // for SimdSqrt, SimdAtan2
+#include <cassert>           // for assert
+#include <cmath>             // for atan2, sqrt, isfinite, M_PI
+#include <cstring>           // for memcpy
+#include <memory>            // for unique_ptr
+
+constexpr double KeplerianElements::Tolerance;
+
+namespace {
+
+const double TwoPi = 2.0 * M_PI;
+
+// [-pi, pi] -> [0, 2pi)
+double Wrap(double angle) { return angle < 0.0 ? angle + TwoPi : angle; }
+
+typedef Simd<double>::type V;
+
+// the arrays of the batch conversion, and the scratch for one SIMD block:
+// the angular momentum and the eccentricity vectors
+struct Block {
+  const double *x, *y, *z, *vx, *vy, *vz;
+  double *a, *e, *i, *raan, *argp, *nu;
+  double *scratch;
+  double mu;
+};
+
+// The conversion of a block is split in two passes, that communicate through
+// the scratch, so that neither has more live vectors than there are
+// registers.
+
+// h, e vector, and a, e
+__attribute__((noinline)) void Vectors(const Block &b, std::size_t k) {
+  V rx, ry, rz, ux, uy, uz;
+  std::memcpy(&rx, b.x + k, sizeof(V));
+  std::memcpy(&ry, b.y + k, sizeof(V));
+  std::memcpy(&rz, b.z + k, sizeof(V));
+  std::memcpy(&ux, b.vx + k, sizeof(V));
+  std::memcpy(&uy, b.vy + k, sizeof(V));
+  std::memcpy(&uz, b.vz + k, sizeof(V));
+
+  V rn;
+  SimdSqrt(rx * rx + ry * ry + rz * rz, &rn);
+  const V v2 = ux * ux + uy * uy + uz * uz;
+  const V rv = rx * ux + ry * uy + rz * uz;
+
+  const std::size_t W = Simd<double>::width;
+  const V hx = ry * uz - rz * uy;
+  const V hy = rz * ux - rx * uz;
+  const V hz = rx * uy - ry * ux;
+  std::memcpy(b.scratch, &hx, sizeof(V));
+  std::memcpy(b.scratch + W, &hy, sizeof(V));
+  std::memcpy(b.scratch + 2 * W, &hz, sizeof(V));
+
+  const V c = v2 - b.mu / rn;
+  const V ex = (c * rx - rv * ux) / b.mu;
+  const V ey = (c * ry - rv * uy) / b.mu;
+  const V ez = (c * rz - rv * uz) / b.mu;
+  std::memcpy(b.scratch + 3 * W, &ex, sizeof(V));
+  std::memcpy(b.scratch + 4 * W, &ey, sizeof(V));
+  std::memcpy(b.scratch + 5 * W, &ez, sizeof(V));
+
+  V en;
+  SimdSqrt(ex * ex + ey * ey + ez * ez, &en);
+  const V sma = rn / (2.0 - rn * v2 / b.mu);
+
+  std::memcpy(b.a + k, &sma, sizeof(V));
+  std::memcpy(b.e + k, &en, sizeof(V));
+}
+
+// i, raan, argp, nu
+__attribute__((noinline)) void Angles(const Block &b, std::size_t k) {
+  const std::size_t W = Simd<double>::width;
+  const V zero = {};
+
+  V hx, hy, hz, ex, ey, ez, en;
+  std::memcpy(&hx, b.scratch, sizeof(V));
+  std::memcpy(&hy, b.scratch + W, sizeof(V));
+  std::memcpy(&hz, b.scratch + 2 * W, sizeof(V));
+  std::memcpy(&ex, b.scratch + 3 * W, sizeof(V));
+  std::memcpy(&ey, b.scratch + 4 * W, sizeof(V));
+  std::memcpy(&ez, b.scratch + 5 * W, sizeof(V));
+  std::memcpy(&en, b.e + k, sizeof(V));
+
+  V nn, hn;
+  SimdSqrt(hx * hx + hy * hy, &nn);
+  SimdSqrt(hx * hx + hy * hy + hz * hz, &hn);
+
+  V incl;
+  SimdAtan2(nn, hz, &incl);
+  std::memcpy(b.i + k, &incl, sizeof(V));
+
+  // the reference direction: the node, or the X axis (no Z component)
+  const Simd<double>::mask equatorial =
+      nn <= KeplerianElements::Tolerance * hn;
+  const V nx = equatorial ? zero + 1.0 : -hy / nn;
+  const V ny = equatorial ? zero : hx / nn;
+  V node;
+  SimdAtan2(hx, -hy, &node);
+  node = equatorial ? zero : node;
+  node = node < zero ? node + TwoPi : node;
+  std::memcpy(b.raan + k, &node, sizeof(V));
+
+  // the direction to periapsis, or the reference direction
+  const Simd<double>::mask circular = en <= KeplerianElements::Tolerance;
+  const V px = circular ? nx : ex / en;
+  const V py = circular ? ny : ey / en;
+  const V pz = circular ? zero : ez / en;
+
+  // sin, cos of the angle from the reference to periapsis, times |h|
+  V peri;
+  const V sp = hx * ny * pz - hy * nx * pz + hz * (nx * py - ny * px);
+  SimdAtan2(sp, hn * (nx * px + ny * py), &peri);
+  peri = circular ? zero : peri;
+  peri = peri < zero ? peri + TwoPi : peri;
+  std::memcpy(b.argp + k, &peri, sizeof(V));
+
+  // sin, cos of the angle from periapsis to the position, times |h|
+  V rx, ry, rz;
+  std::memcpy(&rx, b.x + k, sizeof(V));
+  std::memcpy(&ry, b.y + k, sizeof(V));
+  std::memcpy(&rz, b.z + k, sizeof(V));
+
+  V anomaly;
+  const V sa = hx * (py * rz - pz * ry) + hy * (pz * rx - px * rz) +
+               hz * (px * ry - py * rx);
+  SimdAtan2(sa, hn * (px * rx + py * ry + pz * rz), &anomaly);
+  anomaly = anomaly < zero ? anomaly + TwoPi : anomaly;
+  std::memcpy(b.nu + k, &anomaly, sizeof(V));
+}
+
+// the scalar tail
+__attribute__((noinline)) void Single(const Block &b,
+                                      const CelestialBody *parentBody,
+                                      std::size_t k) {
+  const KeplerianElements elements(Vec3(b.x[k], b.y[k], b.z[k]),
+                                   Vec3(b.vx[k], b.vy[k], b.vz[k]),
+                                   parentBody);
+  b.a[k] = elements.a_;
+  b.e[k] = elements.e_;
+  b.i[k] = elements.i_;
+  b.raan[k] = elements.raan_;
+  b.argp[k] = elements.argp_;
+  b.nu[k] = elements.nu_;
+}
+
+} // namespace
+
+KeplerianElements::KeplerianElements(Vec3 position, Vec3 velocity,
+                                     const CelestialBody *parentBody) {
+  assert(parentBody);
+
+  const double mu = parentBody->mu_;
+  const Vec3 &r = position;
+  const Vec3 &v = velocity;
+
+  const double rn = r.norm();
+  const double v2 = v.dot(v);
+  const double rv = r.dot(v);
+  const Vec3 h = r.cross(v);
+  const double hn = h.norm();
+  assert(rn > 0.0);
+  assert(hn > 0.0 && "rectilinear orbit");
+
+  const Vec3 ev = (r * (v2 - mu / rn) - v * rv) / mu;
+  const double nn = std::sqrt(h.x_ * h.x_ + h.y_ * h.y_);
+  const Vec3 w = h / hn;
+
+  a_ = rn / (2.0 - rn * v2 / mu);
+  e_ = ev.norm();
+  i_ = std::atan2(nn, h.z_);
+
+  // the reference direction in the orbital plane: the ascending node, or the
+  // X axis if there is no node
+  Vec3 node(1.0, 0.0, 0.0);
+  if (nn > Tolerance * hn) {
+    node = Vec3(-h.y_, h.x_, 0.0) / nn;
+    raan_ = Wrap(std::atan2(h.x_, -h.y_));
+  }
+
+  // the direction to periapsis, or the node if there is no periapsis
+  Vec3 periapsis = node;
+  if (e_ > Tolerance) {
+    periapsis = ev / e_;
+    argp_ = Wrap(std::atan2(w.dot(node.cross(periapsis)), node.dot(periapsis)));
+  }
+
+  nu_ = Wrap(std::atan2(w.dot(periapsis.cross(r)), periapsis.dot(r)));
+}
+
+void KeplerianElements::FromStateVectors(
+    const CelestialBody *parentBody, const double *x, const double *y,
+    const double *z, const double *vx, const double *vy, const double *vz,
+    double *a, double *e, double *i, double *raan, double *argp, double *nu,
+    std::size_t n) {
+  assert(parentBody);
+
+  const std::size_t W = Simd<double>::width;
+
+  std::unique_ptr<double[]> scratch(new double[6 * W]);
+  const Block block = {x, y,  z,    vx,   vy, vz, a, e, i, raan, argp, nu,
+                       scratch.get(), parentBody->mu_};
+
+  std::size_t k = 0;
+  for (; k + W <= n; k += W) {
+    Vectors(block, k);
+    Angles(block, k);
+  }
+
+  for (; k < n; k++)
+    Single(block, parentBody, k);
+}
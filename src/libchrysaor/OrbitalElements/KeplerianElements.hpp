@@ -0,0 +1,151 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief the complete set of the classical (Keplerian) orbital elements
+ *
+ * Unlike the per-element classes (SemiMajorAxis, OrbitalEccentricity, ...),
+ * which each recompute the radius, the speed and the angular momentum from
+ * scratch, this computes \f$r\f$, \f$v^2\f$, \f$\vec{h}=\vec{r}\times\vec{v}\f$
+ * and the eccentricity vector
+ * \f$\vec{e}={{(v^2-{\mu\over{r}})\vec{r}-(\vec{r}\cdot\vec{v})\vec{v}}
+ * \over{\mu}}\f$
+ * exactly once, and derives all six elements from them.
+ *
+ * The position and the velocity are in the inertial frame of the parent body,
+ * with the Z axis along the body's rotation axis, the same frame that
+ * RotatingFrame::ToInertial() produces.
+ *
+ * All the angles are in radians, in \f$[0, 2\pi)\f$; the inclination is in
+ * \f$[0, \pi]\f$.
+ *
+ * The degenerate cases are resolved the usual way:
+ * - equatorial orbit (\f$i = 0\f$ or \f$i = \pi\f$): the node is undefined,
+ *   \f$\Omega = 0\f$, and \f$\omega\f$ is measured from the X axis, i.e. it is
+ *   the longitude of periapsis;
+ * - circular orbit (\f$e = 0\f$): the periapsis is undefined, \f$\omega = 0\f$,
+ *   and \f$\nu\f$ is measured from the node, i.e. it is the argument of
+ *   latitude (or the true longitude, if the orbit is also equatorial).
+ *
+ * \see https://en.wikipedia.org/wiki/Orbital_elements
+ * \see https://en.wikipedia.org/wiki/Eccentricity_vector
+ */
+class KeplerianElements {
+public:
+  /**
+   * @brief the relative tolerance below which the eccentricity is considered
+   * zero, and the orbit is considered equatorial
+   *
+   */
+  static constexpr double Tolerance = 1e-11;
+
+  /**
+   * @brief the semi-major axis [m], negative for hyperbolic orbits
+   *
+   */
+  double a_ = 0.0;
+
+  /**
+   * @brief the eccentricity
+   *
+   */
+  double e_ = 0.0;
+
+  /**
+   * @brief the inclination [rad]
+   *
+   */
+  double i_ = 0.0;
+
+  /**
+   * @brief the longitude of the ascending node \f$\Omega\f$ [rad]
+   *
+   */
+  double raan_ = 0.0;
+
+  /**
+   * @brief the argument of periapsis \f$\omega\f$ [rad]
+   *
+   */
+  double argp_ = 0.0;
+
+  /**
+   * @brief the true anomaly \f$\nu\f$ [rad]
+   *
+   */
+  double nu_ = 0.0;
+
+  /**
+   * @brief dummy constructor.
+   *
+   */
+  KeplerianElements() = default;
+
+  /**
+   * @brief calculates the elements from the state vector
+   *
+   * The semi-major axis is the vis-viva
+   * \f$a={r\over{2-{{rv^2}\over{\mu}}}}\f$, as in SemiMajorAxis.
+   *
+   * The node vector is \f$\vec{n}=\hat{z}\times\vec{h}\f$, so
+   * \f$i=\operatorname{atan2}(|\vec{n}|,h_z)\f$ and
+   * \f$\Omega=\operatorname{atan2}(h_x,-h_y)\f$.
+   *
+   * \f$\omega\f$ and \f$\nu\f$ are the signed angles, around \f$\hat{h}\f$,
+   * from \f$\vec{n}\f$ to \f$\vec{e}\f$ and from \f$\vec{e}\f$ to
+   * \f$\vec{r}\f$; using atan2 of the sine and the cosine avoids both the
+   * quadrant checks and the precision loss of acos near 0 and \f$\pi\f$.
+   *
+   * @param position the position, relative to the parent body [m]
+   * @param velocity the velocity, relative to the parent body [m/s]
+   * @param parentBody the parent body
+   */
+  KeplerianElements(Vec3 position, Vec3 velocity,
+                    const CelestialBody *parentBody);
+
+  /**
+   * @brief calculates the elements of n state vectors, structure-of-arrays.
+   *
+   * Same as the constructor, but the bulk is computed for several state
+   * vectors at once, in SIMD lanes.
+   *
+   * @param parentBody the parent body
+   * @param x, y, z the positions [m]
+   * @param vx, vy, vz the velocities [m/s]
+   * @param a the semi-major axes [m]
+   * @param e the eccentricities
+   * @param i the inclinations [rad]
+   * @param raan the longitudes of the ascending node [rad]
+   * @param argp the arguments of periapsis [rad]
+   * @param nu the true anomalies [rad]
+   * @param n the number of the state vectors
+   */
+  static void FromStateVectors(const CelestialBody *parentBody,
+                               const double *x, const double *y,
+                               const double *z, const double *vx,
+                               const double *vy, const double *vz, double *a,
+                               double *e, double *i, double *raan,
+                               double *argp, double *nu, std::size_t n);
+};
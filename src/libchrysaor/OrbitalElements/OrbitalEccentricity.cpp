@@ -22,7 +22,7 @@
 #include "OrbitalElements/SpecificOrbitalEnergy.hpp" // for SpecificOrbitalEnergy
 #include "SpecificRelativeAngularMomentum.hpp" // for SpecificRelativeAngularMomentum
 #include <cassert>                             // for assert
-#include <cmath>                               // for pow, isfinite, fmax, sqrt
+#include <cmath>                               // for hypot, pow, isfinite, f...
 
 OrbitalEccentricity::operator double() const {
   assert(std::isfinite(value_));
@@ -143,11 +143,8 @@ OrbitalEccentricity::OrbitalEccentricity(double Vx, double Vy, double altitude,
 
   assert(std::isfinite(Vx));
   assert(Vx >= 0.0);
-  assert(Vx <= 11000.0);
 
   assert(std::isfinite(Vy));
-  assert(Vy >= -1000.0);
-  assert(Vy <= 1000.0);
 
   assert(std::isfinite(parentBody->R_));
   assert(parentBody->R_ >= 0.0);
@@ -165,26 +162,10 @@ OrbitalEccentricity::OrbitalEccentricity(double Vx, double Vy, double altitude,
   assert(std::isfinite(std::pow(parentBody->mu_, 2.0)));
   assert((std::pow(parentBody->mu_, 2.0)) != 0.0);
 
-  // FIXME: awful precision due to fp
-  // sqrt(alt^2*Vx^4 + alt^2*Vx^2*Vy^2 + mu^2 - 2*alt*mu*Vx^2) / mu
-  // std::sqrt(((std::pow(altitude, 2.0))*(std::pow(Vx, 4.0)) +
-  // (std::pow(altitude, 2.0))*(std::pow(Vx, 2.0))*(std::pow(Vy, 2.0)) +
-  // (std::pow(parentBody->mu_, 2.0)) -
-  // 2.0*altitude*(parentBody->mu_)*(std::pow(Vx, 2.0))) /
-  // (std::pow(parentBody->mu_, 2.0)))
-
-  // sqrt(mu^2 + alt^2*Vx^4 + alt^2*Vx^2*Vy^2 - 2*alt*mu*Vx^2) / mu
-  //
-
-  value_ = std::sqrt(
-      ((std::pow(altitude, 2.0)) * (std::pow(Vx, 4.0)) +
-       (std::pow(altitude, 2.0)) * (std::pow(Vx, 2.0)) * (std::pow(Vy, 2.0)) +
-       (std::pow(parentBody->mu_, 2.0)) -
-       2.0 * altitude * (parentBody->mu_) * (std::pow(Vx, 2.0))) /
-      (std::pow(parentBody->mu_, 2.0)));
-
-  // FIXME: !!!!!
-  value_ = std::fmax(value_, 0.0);
+  // the components of the eccentricity vector, along the radius and along
+  // the horizontal velocity
+  const double k = altitude * Vx / (parentBody->mu_);
+  value_ = std::hypot(k * Vx - 1.0, k * Vy);
 
   assert(std::isfinite(value_));
   assert(value_ >= 0.0);
@@ -159,9 +159,19 @@ public:
    * By definition, given 2 velocity's components, \f$V_x\f$ and \f$V_y\f$,
    * the velocity magnitude is: \f$v = \sqrt{V_x^2+V_y^2}\f$.
    *
-   * FIXME
-   *
-   * See math/orbit/ecc.sage and math/orbit/ecc.rkt
+   * The eccentricity vector
+   * \f$\vec{e}={{\vec{v}\times\vec{h}}\over\mu}-{\vec{r}\over{r}}\f$,
+   * along the radius and along the horizontal velocity, is
+   * \f$\left({{rV_x^2}\over\mu}-1, -{{rV_xV_y}\over\mu}\right)\f$, so
+   * with \f$k={{rV_x}\over\mu}\f$:
+   *
+   * \f$e=\sqrt{(kV_x-1)^2+(kV_y)^2}\f$
+   *
+   * Unlike the expanded
+   * \f$e={\sqrt{r^2V_x^4+r^2V_x^2V_y^2+\mu^2-2r\mu{V_x^2}}\over\mu}\f$
+   * (see math/orbit/ecc.sage and math/orbit/ecc.rkt), there is no
+   * cancellation near \f$e=0\f$, and it holds for any speed, the
+   * parabolic (\f$e=1\f$) and the hyperbolic (\f$e>1\f$) orbits too.
    *
    * \see https://en.wikipedia.org/wiki/Orbital_eccentricity
    *
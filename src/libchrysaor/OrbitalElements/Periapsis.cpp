@@ -20,9 +20,15 @@
 #include "OrbitalElements/Apsis.hpp"               // for Apsis
 #include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
 #include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp" // for SpecificRelativeAngularMomentum
 
-Periapsis::operator double() const { return (sma_ * (1.0 - ecc_)); }
+Periapsis::operator double() const { return periapsis_; }
 
 Periapsis::Periapsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
                      const CelestialBody *parentBody)
     : Apsis(sma, ecc, parentBody) {}
+
+Periapsis::Periapsis(OrbitalEccentricity ecc,
+                     SpecificRelativeAngularMomentum srh,
+                     const CelestialBody *parentBody)
+    : Apsis(ecc, srh, parentBody) {}
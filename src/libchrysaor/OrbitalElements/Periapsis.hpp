@@ -23,12 +23,15 @@
 class CelestialBody;
 class SemiMajorAxis;
 class OrbitalEccentricity;
+class SpecificRelativeAngularMomentum;
 
 /**
  * @brief apoapsis class
  *
  * Extreme point of orbit, the orbit's nearest point
  *
+ * \f$r_p=a(1-e)\f$, or \f$r_p={h^2\over{\mu(1+e)}}\f$ for any orbit.
+ *
  * \see https://en.wikipedia.org/wiki/Apsis
  */
 class Periapsis : public Apsis {
@@ -48,4 +51,16 @@ public:
    */
   Periapsis(SemiMajorAxis sma, OrbitalEccentricity ecc,
             const CelestialBody *parentBody);
+
+  /**
+   * @brief creates Periapsis object from passed characteristics
+   *
+   * This 'creates' orbit's nearest point, of any orbit
+   *
+   * @param ecc eccentricity of the orbit
+   * @param srh specific relative angular momentum [m^2/s]
+   * @param parentBody the parent body
+   */
+  Periapsis(OrbitalEccentricity ecc, SpecificRelativeAngularMomentum srh,
+            const CelestialBody *parentBody);
 };
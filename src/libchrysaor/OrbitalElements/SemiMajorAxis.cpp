@@ -118,11 +118,8 @@ SemiMajorAxis::SemiMajorAxis(double Vx, double Vy, double altitude,
 
   assert(std::isfinite(Vx));
   assert(Vx >= 0.0);
-  assert(Vx <= 11000.0);
 
   assert(std::isfinite(Vy));
-  assert(Vy >= -1000.0);
-  assert(Vy <= 1000.0);
 
   assert(std::isfinite(parentBody->R_));
   assert(parentBody->R_ >= 0.0);
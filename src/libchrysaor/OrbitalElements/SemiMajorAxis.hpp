@@ -37,6 +37,11 @@ class SpecificRelativeAngularMomentum;
  * In special case of circle (orbit with eccentricity of 0), the
  * semi-major axis is the radius.
  *
+ * For the hyperbolic orbits (\f$e>1\f$), the semi-major axis is negative,
+ * so that the vis-viva equation, \f$\epsilon=-{\mu\over{2a}}\f$ and
+ * \f$r_p=a(1-e)\f$ hold as they are. The parabolic orbits (\f$e=1\f$)
+ * have none, \f$a\f$ is infinite.
+ *
  * \see https://en.wikipedia.org/wiki/Semi-major_and_semi-minor_axes
  */
 class SemiMajorAxis {
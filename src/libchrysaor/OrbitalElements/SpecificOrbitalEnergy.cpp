@@ -116,11 +116,8 @@ SpecificOrbitalEnergy::SpecificOrbitalEnergy(double Vx, double Vy,
 
   assert(std::isfinite(Vx));
   assert(Vx >= 0.0);
-  assert(Vx <= 11000.0);
 
   assert(std::isfinite(Vy));
-  assert(Vy >= -1000.0);
-  assert(Vy <= 1000.0);
 
   assert(std::isfinite(parentBody->R_));
   assert(parentBody->R_ >= 0.0);
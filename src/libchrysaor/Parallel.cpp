@@ -0,0 +1,243 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Parallel.hpp"
+#include <algorithm>          // for min, max
+#include <atomic>             // for atomic
+#include <cassert>            // for assert
+#include <condition_variable> // for condition_variable
+#include <cstddef>            // for size_t
+#include <cstdint>            // for uint64_t
+#include <memory>             // for unique_ptr
+#include <mutex>              // for mutex, lock_guard, unique_lock
+#include <thread>             // for thread
+#include <vector>             // for vector
+
+namespace {
+
+// the chunks [begin, end) that one thread still owns, packed in one word,
+// so that the owner and the thieves take from them with a single CAS
+struct Range {
+  std::atomic<std::uint64_t> packed;
+  // one per cache line, the owner is the one that touches it the most
+  char padding[64 - sizeof(std::atomic<std::uint64_t>)];
+};
+
+std::uint64_t Pack(std::uint64_t begin, std::uint64_t end) {
+  return begin << 32 | end;
+}
+std::uint64_t Begin(std::uint64_t packed) { return packed >> 32; }
+std::uint64_t End(std::uint64_t packed) { return packed & 0xFFFFFFFFU; }
+
+// takes the first chunk of the own range
+bool Pop(Range *own, std::size_t *chunk) {
+  std::uint64_t packed = own->packed.load(std::memory_order_relaxed);
+  for (;;) {
+    const std::uint64_t begin = Begin(packed);
+    const std::uint64_t end = End(packed);
+    if (begin >= end)
+      return false;
+    if (own->packed.compare_exchange_weak(packed, Pack(begin + 1, end),
+                                          std::memory_order_relaxed)) {
+      *chunk = begin;
+      return true;
+    }
+  }
+}
+
+// moves the back half of the first nonempty range after the own one to the
+// own range, which is empty
+bool Steal(Range *ranges, std::size_t threads, std::size_t self) {
+  for (std::size_t k = 1; k < threads; k++) {
+    Range *victim = &ranges[(self + k) % threads];
+    std::uint64_t packed = victim->packed.load(std::memory_order_relaxed);
+    for (;;) {
+      const std::uint64_t begin = Begin(packed);
+      const std::uint64_t end = End(packed);
+      if (begin >= end)
+        break;
+
+      const std::uint64_t middle = end - (end - begin + 1) / 2;
+      if (victim->packed.compare_exchange_weak(packed, Pack(begin, middle),
+                                               std::memory_order_relaxed)) {
+        ranges[self].packed.store(Pack(middle, end),
+                                  std::memory_order_relaxed);
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// one ParallelRun() in flight
+struct Job {
+  std::size_t n;
+  std::size_t grain;
+  std::size_t threads;
+  void (*fn)(const void *context, std::size_t i);
+  const void *context;
+  Range *ranges;
+};
+
+// whether this thread is inside of a job, a nested ParallelRun() is serial
+thread_local bool Running = false;
+
+// the share of the job of the thread self, and then the stolen ones
+void Work(const Job &job, std::size_t self) {
+  Running = true;
+  Range *own = &job.ranges[self];
+  do {
+    std::size_t chunk;
+    while (Pop(own, &chunk)) {
+      const std::size_t begin = chunk * job.grain;
+      const std::size_t end = std::min(job.n, begin + job.grain);
+      for (std::size_t i = begin; i < end; i++)
+        job.fn(job.context, i);
+    }
+  } while (Steal(job.ranges, job.threads, self));
+  Running = false;
+}
+
+// the worker threads, started by the first parallel run and kept for the
+// life of the process, so the thread-local state of the work survives from
+// one run to the next
+class Pool {
+private:
+  // one run at a time, the others go serial
+  std::mutex busy_;
+
+  // guards all of the below
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const Job *job_;
+  std::uint64_t generation_;
+  std::size_t pending_;
+  bool stop_;
+
+  std::vector<std::thread> workers_;
+
+  void Loop(std::size_t self) {
+    std::uint64_t seen = 0;
+    for (;;) {
+      const Job *job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+        if (stop_)
+          return;
+        seen = generation_;
+        job = job_;
+      }
+
+      if (self < job->threads)
+        Work(*job, self);
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--pending_ == 0)
+        done_.notify_one();
+    }
+  }
+
+public:
+  Pool() : job_(nullptr), generation_(0), pending_(0), stop_(false) {
+    const std::size_t threads =
+        std::max(1U, std::thread::hardware_concurrency());
+    workers_.reserve(threads - 1);
+    for (std::size_t t = 1; t < threads; t++)
+      workers_.emplace_back(&Pool::Loop, this, t);
+  }
+
+  ~Pool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_)
+      worker.join();
+  }
+
+  Pool(const Pool &) = delete;
+  Pool &operator=(const Pool &) = delete;
+
+  static Pool &Instance() {
+    static Pool pool;
+    return pool;
+  }
+
+  // the threads of a run, the calling one too
+  std::size_t Threads() const { return workers_.size() + 1; }
+
+  // runs the job on the workers and the calling thread, false if the pool
+  // is taken by another thread
+  bool Run(const Job &job) {
+    std::unique_lock<std::mutex> busy(busy_, std::try_to_lock);
+    if (!busy.owns_lock())
+      return false;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = &job;
+      generation_++;
+      pending_ = workers_.size();
+    }
+    wake_.notify_all();
+
+    Work(job, 0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    return true;
+  }
+};
+
+} // namespace
+
+void ParallelRun(std::size_t n, std::size_t grain,
+                 void (*fn)(const void *context, std::size_t i),
+                 const void *context) {
+  if (grain == 0)
+    grain = 1;
+
+  const std::size_t chunks = (n + grain - 1) / grain;
+  const std::size_t threads =
+      Running ? 1 : std::min(Pool::Instance().Threads(), chunks);
+
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < n; i++)
+      fn(context, i);
+    return;
+  }
+
+  // the chunk indices are packed in 32 bits
+  assert(chunks <= 0xFFFFFFFFU);
+
+  // every thread starts with an even share of the chunks
+  std::unique_ptr<Range[]> ranges(new Range[threads]);
+  for (std::size_t t = 0; t < threads; t++)
+    ranges[t].packed.store(
+        Pack(chunks * t / threads, chunks * (t + 1) / threads),
+        std::memory_order_relaxed);
+
+  const Job job = {n, grain, threads, fn, context, ranges.get()};
+
+  // with the pool taken, this thread steals all of the shares itself
+  if (!Pool::Instance().Run(job))
+    Work(job, 0);
+}
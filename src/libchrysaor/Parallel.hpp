@@ -0,0 +1,67 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+/**
+ * @brief runs fn(context, i) for every i in [0, n), on all of the hardware
+ * threads
+ *
+ * The type-erased core of ParallelFor(), the thread management is compiled
+ * once, not in every caller.
+ *
+ * The threads are a pool, started by the first call and kept until the
+ * exit, so a call costs a wake-up rather than the thread creation, and the
+ * thread_local state of the work, e.g. its scratch, is kept from one call
+ * to the next. The pool runs one call at a time: a call made while another
+ * thread has the pool, or from inside of the work itself, runs on the
+ * calling thread alone.
+ *
+ * @param n number of the items
+ * @param grain number of the items taken at once
+ * @param fn the work
+ * @param context passed through to fn
+ */
+void ParallelRun(std::size_t n, std::size_t grain,
+                 void (*fn)(const void *context, std::size_t i),
+                 const void *context);
+
+/**
+ * @brief runs f(i) for every i in [0, n), on all of the hardware threads
+ *
+ * Every thread starts with an even share of the chunks of grain indices,
+ * and works through it from the front. The one that runs out steals the
+ * back half of another thread's remaining share, so the threads that got
+ * the cheap items simply take more of them, without contending on a shared
+ * counter. The calling thread works too. The order of the calls is unspecified,
+ * f must be safe to call concurrently for the different indices.
+ *
+ * @param n number of the items
+ * @param f the work, callable as f(std::size_t)
+ * @param grain number of the items taken at once
+ */
+template <typename F>
+void ParallelFor(std::size_t n, const F &f, std::size_t grain = 1) {
+  ParallelRun(n, grain,
+              [](const void *context, std::size_t i) {
+                (*static_cast<const F *>(context))(i);
+              },
+              &f);
+}
@@ -0,0 +1,147 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Porkchop.hpp"
+#include "Parallel.hpp" // for ParallelFor
+#include <algorithm>    // for min, max
+#include <cassert>      // for assert
+#include <cstdint>      // for uint64_t
+#include <cstdio>       // for fopen, fseek, fwrite, fclose, FILE
+#include <cstring>      // for memcpy
+#include <limits>       // for numeric_limits
+#include <vector>       // for vector
+
+constexpr std::size_t Porkchop::BlockCells;
+
+namespace {
+
+// the file starts with this, and then has the epochs and the columns, all
+// doubles
+struct Header {
+  char magic[8];
+  std::uint64_t departures;
+  std::uint64_t arrivals;
+  std::uint64_t columns;
+  std::uint64_t reserved[4];
+};
+
+static_assert(sizeof(Header) == 64, "the header must have no padding");
+
+const char Magic[8] = {'C', 'H', 'R', 'Y', 'P', 'R', 'K', '1'};
+
+// cells taken at once by one thread, a few Lambert solutions each
+const std::size_t Grain = 16;
+
+} // namespace
+
+Porkchop::Porkchop(const CelestialBody *body, int maxRevolutions)
+    : lambert_(body), maxRevolutions_(maxRevolutions) {
+  assert(maxRevolutions >= 0);
+}
+
+void Porkchop::Evaluate(Vec3 departurePosition, Vec3 departureVelocity,
+                        Vec3 arrivalPosition, Vec3 arrivalVelocity,
+                        double tof, double *cell) const {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  cell[DepartureExcess] = nan;
+  cell[ArrivalExcess] = nan;
+  cell[Revolutions] = nan;
+  if (!(tof > 0.0))
+    return;
+
+  double best = std::numeric_limits<double>::infinity();
+  for (int revolutions = 0; revolutions <= maxRevolutions_; revolutions++) {
+    Vec3 v1[2], v2[2];
+    const std::size_t solutions =
+        lambert_.Solve(departurePosition, arrivalPosition, tof, revolutions,
+                       false, v1, v2);
+
+    for (std::size_t k = 0; k < solutions; k++) {
+      const double departure = (v1[k] - departureVelocity).norm();
+      const double arrival = (arrivalVelocity - v2[k]).norm();
+      if (departure + arrival < best) {
+        best = departure + arrival;
+        cell[DepartureExcess] = departure;
+        cell[ArrivalExcess] = arrival;
+        cell[Revolutions] = revolutions;
+      }
+    }
+  }
+}
+
+bool Porkchop::Write(const std::string &path, const PorkchopAxis &departure,
+                     const PorkchopAxis &arrival) const {
+  const std::size_t cells = departure.n * arrival.n;
+  assert(cells > 0);
+
+  Header header;
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.departures = departure.n;
+  header.arrivals = arrival.n;
+  header.columns = Columns;
+  std::fill(header.reserved, header.reserved + 4, 0);
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+
+  std::size_t written = std::fwrite(&header, sizeof(header), 1, file);
+  written += std::fwrite(departure.t, sizeof(double), departure.n, file);
+  written += std::fwrite(arrival.t, sizeof(double), arrival.n, file);
+  bool ok = written == 1 + departure.n + arrival.n;
+
+  const std::size_t offset =
+      sizeof(header) + (departure.n + arrival.n) * sizeof(double);
+
+  // whole rows at once, each column of the block is contiguous, to be
+  // written in one go
+  const std::size_t rows = std::max<std::size_t>(1, BlockCells / arrival.n);
+  std::vector<double> block(rows * arrival.n * Columns);
+
+  // no point in evaluating the rest once the file has failed
+  for (std::size_t row = 0; ok && row < departure.n; row += rows) {
+    const std::size_t count = std::min(rows, departure.n - row) * arrival.n;
+    const std::size_t first = row * arrival.n;
+    double *values = block.data();
+
+    ParallelFor(count,
+                [this, &departure, &arrival, first, count,
+                 values](std::size_t k) {
+                  const std::size_t i = (first + k) / arrival.n;
+                  const std::size_t j = (first + k) % arrival.n;
+                  double cell[Columns];
+                  Evaluate(departure.position[i], departure.velocity[i],
+                           arrival.position[j], arrival.velocity[j],
+                           arrival.t[j] - departure.t[i], cell);
+                  for (std::size_t c = 0; c < Columns; c++)
+                    values[c * count + k] = cell[c];
+                },
+                Grain);
+
+    for (std::size_t c = 0; ok && c < Columns; c++) {
+      const std::size_t at = offset + (c * cells + first) * sizeof(double);
+      ok = std::fseek(file, static_cast<long>(at), SEEK_SET) == 0 &&
+           std::fwrite(values + c * count, sizeof(double), count, file) ==
+               count;
+    }
+  }
+
+  // the buffered tail is only written by fclose
+  const bool closed = std::fclose(file) == 0;
+  return ok && closed;
+}
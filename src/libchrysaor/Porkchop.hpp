@@ -0,0 +1,139 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Lambert.hpp" // for Lambert
+#include "Vec3.hpp"    // for Vec3
+#include <cstddef>     // for size_t
+#include <string>      // for string
+
+class CelestialBody;
+
+/**
+ * @brief the states along one axis of a porkchop plot, one per epoch
+ *
+ * The states are in the frame of the central body, e.g. sampled from an
+ * ephemeris by the caller.
+ */
+struct PorkchopAxis {
+  /**
+   * @brief the epochs [s], ascending
+   *
+   */
+  const double *t;
+
+  /**
+   * @brief the positions at the epochs [m]
+   *
+   */
+  const Vec3 *position;
+
+  /**
+   * @brief the velocities at the epochs [m/s]
+   *
+   */
+  const Vec3 *velocity;
+
+  /**
+   * @brief number of the epochs
+   *
+   */
+  std::size_t n;
+};
+
+/**
+ * @brief the porkchop plot: the transfers between all the departure and the
+ * arrival epochs
+ *
+ * Every cell is the prograde Lambert transfer, of up to the given number of
+ * full revolutions, with the least total hyperbolic excess speed. The cells
+ * are evaluated on all the cores, and written out in blocks of rows as they
+ * are done, so the grid never has to fit in memory.
+ *
+ * The file is a 64-byte header (the magic "CHRYPRK1", and the numbers of the
+ * departures, the arrivals and the columns as uint64_t), the departure and
+ * the arrival epochs, and then the columns, each one a departures by arrivals
+ * row-major array of doubles. The cells without a transfer (arrival before
+ * departure, or no solution) are NaN.
+ */
+class Porkchop {
+private:
+  /**
+   * @brief the solver
+   *
+   */
+  Lambert lambert_;
+
+  /**
+   * @brief the most full revolutions tried
+   *
+   */
+  int maxRevolutions_;
+
+public:
+  /**
+   * @brief the columns of the file
+   *
+   */
+  enum Column {
+    DepartureExcess, ///< hyperbolic excess speed at departure [m/s]
+    ArrivalExcess,   ///< hyperbolic excess speed at arrival [m/s]
+    Revolutions,     ///< the number of the full revolutions
+    Columns
+  };
+
+  /**
+   * @brief number of the cells evaluated, and written out, at once
+   *
+   */
+  static constexpr std::size_t BlockCells = 1 << 16;
+
+  /**
+   * @brief the porkchop plot around the given body
+   *
+   * @param body the central body
+   * @param maxRevolutions the most full revolutions tried, 0 or more
+   */
+  Porkchop(const CelestialBody *body, int maxRevolutions);
+
+  /**
+   * @brief evaluates one cell
+   *
+   * @param departurePosition the position at departure [m]
+   * @param departureVelocity the velocity at departure [m/s]
+   * @param arrivalPosition the position at arrival [m]
+   * @param arrivalVelocity the velocity at arrival [m/s]
+   * @param tof the time of flight [s]
+   * @param cell the values of the columns of the cell, Columns of them
+   */
+  void Evaluate(Vec3 departurePosition, Vec3 departureVelocity,
+                Vec3 arrivalPosition, Vec3 arrivalVelocity, double tof,
+                double *cell) const;
+
+  /**
+   * @brief evaluates the whole grid into the file
+   *
+   * @param path path to the file, it is overwritten
+   * @param departure the departure states
+   * @param arrival the arrival states
+   * @return false if the file could not be written completely
+   */
+  bool Write(const std::string &path, const PorkchopAxis &departure,
+             const PorkchopAxis &arrival) const;
+};
@@ -0,0 +1,34 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Quat.hpp"
+#include <iostream>
+
+template <typename T>
+::std::ostream &operator<<(::std::ostream &os, const BasicQuat<T> &bar) {
+  return os << "(" << bar.w_ << "; " << bar.x_ << "; " << bar.y_ << "; "
+            << bar.z_ << ")";
+}
+
+template class BasicQuat<float>;
+template class BasicQuat<double>;
+
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicQuat<float> &bar);
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicQuat<double> &bar);
@@ -0,0 +1,206 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Mat3.hpp" // for BasicMat3
+#include "Vec3.hpp" // for BasicVec3
+#include <cmath>    // for sqrt, cos, sin
+#include <cstddef>  // for size_t
+#include <iostream> // for ostream
+
+/**
+ * @brief quaternion, \f$q = w + x\mathbf{i} + y\mathbf{j} + z\mathbf{k}\f$
+ *
+ * Unit quaternions represent rotations (attitude), and are cheaper to
+ * compose and to keep orthonormal than rotation matrices.
+ *
+ * Follows the Vec3 conventions: everything is constexpr and inline,
+ * and the scalar type is a template parameter.
+ *
+ * \see https://en.wikipedia.org/wiki/Quaternions_and_spatial_rotation
+ *
+ * @tparam T scalar type
+ */
+template <typename T> class BasicQuat {
+public:
+  /**
+   * @brief scalar part
+   *
+   */
+  T w_;
+
+  /**
+   * @brief vector part
+   *
+   */
+  T x_;
+  T y_;
+  T z_;
+
+  constexpr bool operator==(BasicQuat rhs) const {
+    return (w_ == rhs.w_ && x_ == rhs.x_ && y_ == rhs.y_ && z_ == rhs.z_);
+  }
+
+  /**
+   * @brief Hamilton product, i.e. composition of rotations
+   *
+   * (p * q).rotate(v) == p.rotate(q.rotate(v))
+   *
+   * @return BasicQuat
+   */
+  constexpr BasicQuat operator*(BasicQuat rhs) const {
+    return BasicQuat(w_ * rhs.w_ - x_ * rhs.x_ - y_ * rhs.y_ - z_ * rhs.z_,
+                     w_ * rhs.x_ + x_ * rhs.w_ + y_ * rhs.z_ - z_ * rhs.y_,
+                     w_ * rhs.y_ - x_ * rhs.z_ + y_ * rhs.w_ + z_ * rhs.x_,
+                     w_ * rhs.z_ + x_ * rhs.y_ - y_ * rhs.x_ + z_ * rhs.w_);
+  }
+  constexpr BasicQuat &operator*=(BasicQuat rhs) {
+    *this = *this * rhs;
+    return *this;
+  }
+
+  /**
+   * @brief conjugate. For an unit quaternion, it is the inverse rotation.
+   *
+   * @return BasicQuat
+   */
+  constexpr BasicQuat conjugate() const { return BasicQuat(w_, -x_, -y_, -z_); }
+
+  /**
+   * @brief euclidean norm
+   *
+   * @return T
+   */
+  T norm() const {
+    using std::sqrt;
+    return sqrt(w_ * w_ + x_ * x_ + y_ * y_ + z_ * z_);
+  }
+
+  /**
+   * @brief scales the quaternion to the unit length, in-place
+   *
+   * Composing many rotations accumulates rounding errors, so it should be
+   * re-normalized from time to time.
+   *
+   * @return BasicQuat&
+   */
+  BasicQuat &normalize() {
+    const T inv = T(1.0) / norm();
+    w_ *= inv;
+    x_ *= inv;
+    y_ *= inv;
+    z_ *= inv;
+    return *this;
+  }
+
+  /**
+   * @brief unit quaternion, with the same direction
+   *
+   * @return BasicQuat
+   */
+  BasicQuat normalized() const {
+    BasicQuat res(*this);
+    return res.normalize();
+  }
+
+  /**
+   * @brief rotates vector by this (unit) quaternion
+   *
+   * Fused form of \f$q v q^{*}\f$:
+   * \f$\vec{t} = 2\vec{q} \times \vec{v}\f$,
+   * \f$\vec{v}' = \vec{v} + w\vec{t} + \vec{q} \times \vec{t}\f$
+   *
+   * That is 18 multiplications, versus 27 to build the rotation matrix and
+   * apply it once.
+   *
+   * @param v the vector
+   * @return BasicVec3<T> rotated vector
+   */
+  constexpr BasicVec3<T> rotate(BasicVec3<T> v) const {
+    const BasicVec3<T> q(x_, y_, z_);
+    const BasicVec3<T> t = q.cross(v) * T(2.0);
+    return v + t * w_ + q.cross(t);
+  }
+
+  /**
+   * @brief batched rotation of SoA arrays of vectors by this quaternion
+   *
+   * For many vectors, converting to the rotation matrix once and applying it
+   * (9 multiplications per vector) is cheaper than rotate().
+   *
+   * \see BasicMat3::apply
+   */
+  void rotate(const T *x, const T *y, const T *z, T *ox, T *oy, T *oz,
+              std::size_t n) const {
+    matrix().apply(x, y, z, ox, oy, oz, n);
+  }
+
+  /**
+   * @brief equivalent rotation matrix, for an unit quaternion
+   *
+   * @return BasicMat3<T>
+   */
+  constexpr BasicMat3<T> matrix() const {
+    const T xx = x_ * x_, yy = y_ * y_, zz = z_ * z_;
+    const T xy = x_ * y_, xz = x_ * z_, yz = y_ * z_;
+    const T wx = w_ * x_, wy = w_ * y_, wz = w_ * z_;
+
+    return BasicMat3<T>(T(1.0) - T(2.0) * (yy + zz), T(2.0) * (xy - wz),
+                        T(2.0) * (xz + wy), T(2.0) * (xy + wz),
+                        T(1.0) - T(2.0) * (xx + zz), T(2.0) * (yz - wx),
+                        T(2.0) * (xz - wy), T(2.0) * (yz + wx),
+                        T(1.0) - T(2.0) * (xx + yy));
+  }
+
+  /**
+   * @brief creates rotation around given axis, by given angle
+   *
+   * @param axis rotation axis, unit vector
+   * @param angle rotation angle, counter-clockwise [rad]
+   * @return BasicQuat
+   */
+  static BasicQuat FromAxisAngle(BasicVec3<T> axis, T angle) {
+    using std::cos;
+    using std::sin;
+    const T s = sin(angle / T(2.0));
+    return BasicQuat(cos(angle / T(2.0)), axis.x_ * s, axis.y_ * s,
+                     axis.z_ * s);
+  }
+
+  /**
+   * @brief identity rotation
+   *
+   */
+  constexpr BasicQuat() : w_(1.0), x_(0.0), y_(0.0), z_(0.0) {}
+  constexpr BasicQuat(T w, T x, T y, T z) : w_(w), x_(x), y_(y), z_(z) {}
+};
+
+template <typename T>
+std::ostream &operator<<(::std::ostream &os, const BasicQuat<T> &bar);
+
+extern template class BasicQuat<float>;
+extern template class BasicQuat<double>;
+
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicQuat<float> &bar);
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicQuat<double> &bar);
+
+using Quatf = BasicQuat<float>;
+using Quat = BasicQuat<double>;
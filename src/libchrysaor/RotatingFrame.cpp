@@ -0,0 +1,101 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RotatingFrame.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Mat3.hpp"          // for Mat3
+#include <cassert>           // for assert
+#include <cmath>             // for cos, sin, isfinite
+#include <cstddef>           // for size_t
+
+constexpr std::size_t RotatingFrame::ResyncSteps;
+
+void RotatingFrame::SetEpoch(double t) {
+  assert(std::isfinite(t));
+
+  base_ = t;
+  steps_ = 0;
+
+  t_ = t;
+
+  const double theta = Angle();
+  c_ = std::cos(theta);
+  s_ = std::sin(theta);
+}
+
+void RotatingFrame::SetStep(double dt) {
+  assert(std::isfinite(dt));
+
+  // the epoch is now counted from here
+  base_ = t_;
+  steps_ = 0;
+
+  dt_ = dt;
+  dc_ = std::cos(omega_ * dt);
+  ds_ = std::sin(omega_ * dt);
+}
+
+void RotatingFrame::Step() {
+  steps_++;
+
+  // no accumulated sum, so no drift of the epoch itself
+  const double t = base_ + static_cast<double>(steps_) * dt_;
+
+  if (steps_ % ResyncSteps == 0) {
+    t_ = t;
+
+    const double theta = Angle();
+    c_ = std::cos(theta);
+    s_ = std::sin(theta);
+    return;
+  }
+
+  // angle addition, (c + is) * (dc + i ds)
+  const double c = c_ * dc_ - s_ * ds_;
+  const double s = s_ * dc_ + c_ * ds_;
+
+  // one Newton iteration of 1/sqrt(c^2 + s^2), around 1
+  const double k = 1.5 - 0.5 * (c * c + s * s);
+
+  t_ = t;
+  c_ = c * k;
+  s_ = s * k;
+}
+
+void RotatingFrame::ToBodyFixed(const double *x, const double *y,
+                                const double *z, double *ox, double *oy,
+                                double *oz, std::size_t n) const {
+  ToBodyFixedMatrix().apply(x, y, z, ox, oy, oz, n);
+}
+
+void RotatingFrame::ToInertial(const double *x, const double *y,
+                               const double *z, double *ox, double *oy,
+                               double *oz, std::size_t n) const {
+  ToInertialMatrix().apply(x, y, z, ox, oy, oz, n);
+}
+
+RotatingFrame::RotatingFrame(const CelestialBody *body, double theta0)
+    : omega_(0), theta0_(theta0), base_(0), steps_(0), dt_(0), dc_(1),
+      ds_(0), t_(0), c_(1), s_(0) {
+  assert(body);
+  assert(std::isfinite(theta0));
+
+  omega_ = body->omega_;
+
+  SetEpoch(0.0);
+}
@@ -0,0 +1,212 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Mat3.hpp" // for Mat3
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+
+class CelestialBody;
+
+/**
+ * @brief body-fixed frame of a rotating body
+ *
+ * The body rotates around the Z axis of the inertial frame, with the
+ * angular velocity \f$\omega\f$ of CelestialBody, so the rotation angle is
+ * \f$\theta = \theta_0 + \omega{t}\f$.
+ *
+ * The sin and cos of the angle are computed once per SetEpoch(), and all
+ * the transforms at that epoch just use them.
+ *
+ * For fixed-step propagation, Step() advances the epoch by the step set
+ * with SetStep(), by rotating the cached (cos, sin) pair by the
+ * precomputed step rotation, i.e. 4 multiplications instead of the
+ * trigonometric calls. The pair is renormalized on every step, and
+ * recomputed exactly every ResyncSteps steps, so the rounding errors do not
+ * accumulate.
+ */
+class RotatingFrame {
+private:
+  /**
+   * @brief angular velocity of the body [rad/s]
+   *
+   */
+  double omega_;
+
+  /**
+   * @brief rotation angle at t = 0 [rad]
+   *
+   */
+  double theta0_;
+
+  /**
+   * @brief last exactly computed epoch, and the steps done since it
+   *
+   */
+  double base_;
+  std::size_t steps_;
+
+  /**
+   * @brief the step [s], and cos, sin of its rotation angle
+   *
+   */
+  double dt_;
+  double dc_;
+  double ds_;
+
+  /**
+   * @brief current epoch [s], and cos, sin of the rotation angle at it
+   *
+   */
+  double t_;
+  double c_;
+  double s_;
+
+public:
+  /**
+   * @brief number of Step()s between the exact recomputations
+   *
+   */
+  static constexpr std::size_t ResyncSteps = 256;
+
+  /**
+   * @brief current epoch [s]
+   *
+   */
+  double Epoch() const { return t_; }
+
+  /**
+   * @brief rotation angle at the current epoch, \f$\theta_0 + \omega{t}\f$
+   *
+   * @return double angle [rad]
+   */
+  double Angle() const { return theta0_ + omega_ * t_; }
+
+  /**
+   * @brief cos of the rotation angle at the current epoch
+   *
+   */
+  double Cos() const { return c_; }
+
+  /**
+   * @brief sin of the rotation angle at the current epoch
+   *
+   */
+  double Sin() const { return s_; }
+
+  /**
+   * @brief sets the epoch, computes the rotation at it
+   *
+   * @param t time [s]
+   */
+  void SetEpoch(double t);
+
+  /**
+   * @brief sets the step for Step(), computes its rotation
+   *
+   * @param dt time step [s]
+   */
+  void SetStep(double dt);
+
+  /**
+   * @brief advances the epoch by one step, incrementally
+   *
+   */
+  void Step();
+
+  /**
+   * @brief rotation matrix, from the inertial frame to the body-fixed one
+   *
+   */
+  Mat3 ToBodyFixedMatrix() const { return Mat3::RotationZ(c_, -s_); }
+
+  /**
+   * @brief rotation matrix, from the body-fixed frame to the inertial one
+   *
+   */
+  Mat3 ToInertialMatrix() const { return Mat3::RotationZ(c_, s_); }
+
+  /**
+   * @brief inertial position to the body-fixed frame
+   *
+   * @param r position, inertial [m]
+   * @return Vec3 position, body-fixed [m]
+   */
+  Vec3 ToBodyFixed(Vec3 r) const {
+    return Vec3(c_ * r.x_ + s_ * r.y_, c_ * r.y_ - s_ * r.x_, r.z_);
+  }
+
+  /**
+   * @brief body-fixed position to the inertial frame
+   *
+   * @param r position, body-fixed [m]
+   * @return Vec3 position, inertial [m]
+   */
+  Vec3 ToInertial(Vec3 r) const {
+    return Vec3(c_ * r.x_ - s_ * r.y_, s_ * r.x_ + c_ * r.y_, r.z_);
+  }
+
+  /**
+   * @brief inertial velocity to the body-fixed frame
+   *
+   * \f$\vec{v}_{bf} = R(\vec{v} - \vec\omega\times\vec{r})\f$
+   *
+   * @param r position, inertial [m]
+   * @param v velocity, inertial [m/s]
+   * @return Vec3 velocity, relative to the body surface, body-fixed [m/s]
+   */
+  Vec3 VelocityToBodyFixed(Vec3 r, Vec3 v) const {
+    return ToBodyFixed(Vec3(v.x_ + omega_ * r.y_, v.y_ - omega_ * r.x_, v.z_));
+  }
+
+  /**
+   * @brief body-fixed velocity to the inertial frame
+   *
+   * \f$\vec{v} = R^T(\vec{v}_{bf} + \vec\omega\times\vec{r}_{bf})\f$
+   *
+   * @param r position, body-fixed [m]
+   * @param v velocity, relative to the body surface, body-fixed [m/s]
+   * @return Vec3 velocity, inertial [m/s]
+   */
+  Vec3 VelocityToInertial(Vec3 r, Vec3 v) const {
+    return ToInertial(Vec3(v.x_ - omega_ * r.y_, v.y_ + omega_ * r.x_, v.z_));
+  }
+
+  /**
+   * @brief batched ToBodyFixed(), over SoA arrays
+   *
+   */
+  void ToBodyFixed(const double *x, const double *y, const double *z,
+                   double *ox, double *oy, double *oz, std::size_t n) const;
+
+  /**
+   * @brief batched ToInertial(), over SoA arrays
+   *
+   */
+  void ToInertial(const double *x, const double *y, const double *z,
+                  double *ox, double *oy, double *oz, std::size_t n) const;
+
+  /**
+   * @brief creates the body-fixed frame of the body, at epoch 0
+   *
+   * @param body the rotating body
+   * @param theta0 rotation angle at t = 0 [rad]
+   */
+  explicit RotatingFrame(const CelestialBody *body, double theta0 = 0.0);
+};
@@ -0,0 +1,60 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+#include <cstdint> // for int32_t, int64_t
+
+/**
+ * @brief fixed-width SIMD vector type for given scalar type
+ *
+ * Uses the GCC/Clang vector extensions, so the batched kernels are written
+ * once, with plain arithmetic operators, and the compiler lowers them to
+ * whatever the target (-march) supports: one AVX register, or two SSE ones.
+ *
+ * Auto-vectorization can not be relied upon for the SoA kernels, because the
+ * output arrays are allowed to alias the input ones, and at -O2 the compiler
+ * refuses to version the loops for that.
+ *
+ * The vector types must never be passed by value across function boundaries
+ * (that changes the ABI depending on -march), only used as locals, with
+ * memcpy() used for the unaligned loads and stores.
+ *
+ * The mask type is the result of the comparisons of the vectors, and the
+ * condition of the vector ?:, lanes of all-ones or all-zeros.
+ *
+ * Scalar types without a specialization have width of 1, i.e. no SIMD.
+ *
+ * \see https://gcc.gnu.org/onlinedocs/gcc/Vector-Extensions.html
+ *
+ * @tparam T scalar type
+ */
+template <typename T> struct Simd { static constexpr std::size_t width = 1; };
+
+template <> struct Simd<float> {
+  typedef float type __attribute__((vector_size(32)));
+  typedef std::int32_t mask __attribute__((vector_size(32)));
+  static constexpr std::size_t width = 8;
+};
+
+template <> struct Simd<double> {
+  typedef double type __attribute__((vector_size(32)));
+  typedef std::int64_t mask __attribute__((vector_size(32)));
+  static constexpr std::size_t width = 4;
+};
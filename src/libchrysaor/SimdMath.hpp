@@ -0,0 +1,176 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Simd.hpp" // for Simd
+#include <cmath>    // for M_PI, M_PI_2, M_PI_4
+
+/**
+ * @file
+ * @brief elementary functions of the SIMD vectors of double
+ *
+ * For the batched kernels, which would otherwise have to leave the vectors
+ * for the scalar libm calls. The polynomials are the ones of Cephes, and
+ * are accurate to an ulp or two, the same as libm, for the arguments of
+ * moderate magnitude (below about 1e9 for sin and cos).
+ *
+ * The functions are always inlined, and take the vectors by reference, so
+ * no vector ever crosses a function boundary, see Simd.hpp.
+ *
+ * \see http://www.netlib.org/cephes/
+ */
+
+/**
+ * @brief per-lane square root, of the non-negative finite lanes
+ *
+ * Not std::sqrt(), its errno path is a call, and the vectors would spill
+ * around it. The reciprocal square root is guessed from the halved
+ * exponent, refined by four Newton steps, then one Heron step gives the
+ * root, to within an ulp.
+ */
+inline __attribute__((always_inline)) void
+SimdSqrt(const Simd<double>::type &x, Simd<double>::type *r) {
+  typedef Simd<double>::type V;
+  typedef Simd<double>::mask M;
+
+  const V h = 0.5 * x;
+  V y = (V)(0x5FE6EB50C7B537A9 - ((M)x >> 1));
+  for (int i = 0; i < 4; i++)
+    y = y * (1.5 - h * y * y);
+
+  const V s = x * y;
+  *r = s + 0.5 * y * (x - s * s);
+}
+
+/**
+ * @brief per-lane cube root, of the finite normal or zero lanes
+ *
+ * The first guess divides the high word of the exponent by 3, as fdlibm
+ * does, which is good to 5 bits, then four Newton steps give the root, to
+ * within two ulps.
+ */
+inline __attribute__((always_inline)) void
+SimdCbrt(const Simd<double>::type &x, Simd<double>::type *r) {
+  typedef Simd<double>::type V;
+  typedef Simd<double>::mask M;
+
+  const V zero = {};
+  const V ax = x < zero ? -x : x;
+
+  // hi / 3, as a multiplication, for hi < 2^31
+  const M hi = (M)ax >> 32;
+  V y = (V)((((hi * 0x55555556) >> 32) + 715094163) << 32);
+  for (int i = 0; i < 4; i++)
+    y = y - (y - ax / (y * y)) * (1.0 / 3.0);
+
+  y = ax == zero ? zero : y;
+  *r = x < zero ? -y : y;
+}
+
+/**
+ * @brief per-lane sin and cos
+ *
+ * The argument is reduced by the multiples of pi/2, represented in three
+ * parts, to [-pi/4, pi/4], the quadrant picks the polynomial and the sign.
+ */
+inline __attribute__((always_inline)) void
+SimdSinCos(const Simd<double>::type &x, Simd<double>::type *s,
+           Simd<double>::type *c) {
+  typedef Simd<double>::type V;
+  typedef Simd<double>::mask M;
+
+  // rounds to the nearest integer, for |x| < 2^51
+  const double Round = 6755399441055744.0;
+
+  const V j = (x * (2.0 / M_PI) + Round) - Round;
+  const M q = __builtin_convertvector(j, M);
+
+  // pi/2, the first two parts have the trailing zero bits
+  const double DP1 = 1.57079625129699707031;
+  const double DP2 = 7.54978941586159635336e-8;
+  const double DP3 = 5.39030285815811905290e-15;
+
+  const V r = ((x - j * DP1) - j * DP2) - j * DP3;
+  const V z = r * r;
+
+  V ps = z * 1.58962301576546568060e-10 - 2.50507477628578072866e-8;
+  ps = ps * z + 2.75573136213857245213e-6;
+  ps = ps * z - 1.98412698295895385996e-4;
+  ps = ps * z + 8.33333333332211858878e-3;
+  ps = ps * z - 1.66666666666666307295e-1;
+
+  V pc = z * -1.13585365213876817300e-11 + 2.08757008419747316778e-9;
+  pc = pc * z - 2.75573141792967388112e-7;
+  pc = pc * z + 2.48015872888517045348e-5;
+  pc = pc * z - 1.38888888888730564116e-3;
+  pc = pc * z + 4.16666666666665929218e-2;
+
+  const V sr = r + r * z * ps;
+  const V cr = 1.0 - 0.5 * z + z * z * pc;
+
+  const M swap = (q & 1) != 0;
+  const V ss = swap ? cr : sr;
+  const V cc = swap ? sr : cr;
+
+  *s = ((q & 2) != 0) ? -ss : ss;
+  *c = (((q + 1) & 2) != 0) ? -cc : cc;
+}
+
+/**
+ * @brief per-lane atan2(y, x), in [-pi, pi]
+ *
+ * The ratio of the smaller to the larger magnitude is reduced further by
+ * pi/4, to [-tan(pi/8), tan(pi/8)], then the octant is restored.
+ */
+inline __attribute__((always_inline)) void
+SimdAtan2(const Simd<double>::type &y, const Simd<double>::type &x,
+          Simd<double>::type *r) {
+  typedef Simd<double>::type V;
+  typedef Simd<double>::mask M;
+
+  const V zero = {};
+
+  const V ay = y < zero ? -y : y;
+  const V ax = x < zero ? -x : x;
+
+  const M swap = ay > ax;
+  const V lo = swap ? ax : ay;
+  const V hi = swap ? ay : ax;
+  const V t = hi == zero ? zero : lo / hi;
+
+  const M big = t > 0.41421356237309504880;
+  const V u = big ? (t - 1.0) / (t + 1.0) : t;
+  const V z = u * u;
+
+  V p = z * -8.750608600031904122785e-1 - 1.615753718733365076637e1;
+  p = p * z - 7.500855792314704667340e1;
+  p = p * z - 1.228866684490136173410e2;
+  p = p * z - 6.485021904942025371773e1;
+
+  V q = z + 2.485846490142306297962e1;
+  q = q * z + 1.650270098316988542046e2;
+  q = q * z + 4.328810604912902668951e2;
+  q = q * z + 4.853903996359136964868e2;
+  q = q * z + 1.945506571482613964425e2;
+
+  V a = (big ? zero + M_PI_4 : zero) + (u + u * z * p / q);
+  a = swap ? M_PI_2 - a : a;
+  a = x < zero ? M_PI - a : a;
+  *r = y < zero ? -a : a;
+}
@@ -0,0 +1,64 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SolarSystem.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Constants.hpp"     // for SunMu, EarthMu, ...
+#include <cmath>             // for M_PI
+
+// constexpr, so these are constant-initialized, with no startup cost, and
+// no initialization order issues.
+
+namespace SolarSystem {
+
+constexpr CelestialBody Sun(Constants::SunMu, Constants::SunRadius);
+
+constexpr CelestialBody
+    Mercury(&Sun, Constants::SunMu / Constants::SunToMercuryMassRatio,
+            Constants::MercuryRadius, 0.0);
+constexpr CelestialBody Venus(&Sun,
+                              Constants::SunMu / Constants::SunToVenusMassRatio,
+                              Constants::VenusRadius, 0.0);
+constexpr CelestialBody Earth(&Sun, Constants::EarthMu,
+                              Constants::EarthEquatorialRadius,
+                              2.0 * M_PI / Constants::EarthAngularVelocity);
+constexpr CelestialBody Mars(&Sun,
+                             Constants::SunMu / Constants::SunToMarsMassRatio,
+                             Constants::MarsRadius, 0.0);
+constexpr CelestialBody
+    Jupiter(&Sun, Constants::SunMu / Constants::SunToJupiterMassRatio,
+            Constants::JupiterRadius, 0.0);
+constexpr CelestialBody
+    Saturn(&Sun, Constants::SunMu / Constants::SunToSaturnMassRatio,
+           Constants::SaturnRadius, 0.0);
+constexpr CelestialBody
+    Uranus(&Sun, Constants::SunMu / Constants::SunToUranusMassRatio,
+           Constants::UranusRadius, 0.0);
+constexpr CelestialBody
+    Neptune(&Sun, Constants::SunMu / Constants::SunToNeptuneMassRatio,
+            Constants::NeptuneRadius, 0.0);
+constexpr CelestialBody Pluto(&Sun,
+                              Constants::SunMu / Constants::SunToPlutoMassRatio,
+                              Constants::PlutoRadius, 0.0);
+
+constexpr CelestialBody Moon(&Earth,
+                             Constants::EarthMu *
+                                 Constants::MoonToEarthMassRatio,
+                             Constants::MoonRadius, 0.0);
+
+} // namespace SolarSystem
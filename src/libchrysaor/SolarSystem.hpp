@@ -0,0 +1,48 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "CelestialBody.hpp" // for CelestialBody
+
+/**
+ * @brief the bodies of the Solar system
+ *
+ * Constructed at compile time, from the constants in the generated
+ * Constants.hpp, which are parsed from doc/Astronomical_Constants_2016.txt.
+ *
+ * The masses of the planets include their satellites. The rotation period
+ * is only known for the Earth, all the other bodies are non-rotating.
+ */
+namespace SolarSystem {
+
+extern const CelestialBody Sun;
+
+extern const CelestialBody Mercury;
+extern const CelestialBody Venus;
+extern const CelestialBody Earth;
+extern const CelestialBody Mars;
+extern const CelestialBody Jupiter;
+extern const CelestialBody Saturn;
+extern const CelestialBody Uranus;
+extern const CelestialBody Neptune;
+extern const CelestialBody Pluto;
+
+extern const CelestialBody Moon;
+
+} // namespace SolarSystem
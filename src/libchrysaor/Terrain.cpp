@@ -0,0 +1,217 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Terrain.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "MappedFile.hpp"    // for MappedFile
+#include "Vec3.hpp"          // for Vec3
+#include <algorithm>         // for min
+#include <cassert>           // for assert
+#include <cmath>             // for floor, asin, atan2, isfinite, M_PI
+#include <cstddef>           // for size_t
+#include <cstdint>           // for uint64_t
+#include <cstdio>            // for fopen, fwrite, fclose, FILE
+#include <cstring>           // for memcpy, memcmp
+#include <memory>            // for unique_ptr
+#include <string>            // for string, to_string
+#include <utility>           // for move
+#include <vector>            // for vector
+
+namespace {
+
+const double RadToDeg = 180.0 / M_PI;
+
+// the file starts with this, and then has the heights (float)
+struct Header {
+  char magic[8];
+  std::uint64_t samples;
+  std::uint64_t reserved[6];
+};
+
+static_assert(sizeof(Header) == 64, "the header must have no padding");
+
+const char Magic[8] = {'C', 'H', 'R', 'Y', 'D', 'E', 'M', '1'};
+
+} // namespace
+
+void Terrain::Load(std::size_t tile, Slot *slot) {
+  slot->tile = tile;
+  slot->file.reset();
+  slot->heights = nullptr;
+  slot->samples = 0;
+
+  loads_++;
+
+  const std::string path = TilePath(tile / cols_, tile % cols_);
+
+  // a missing or malformed tile keeps no mapping, and is at the height 0
+  std::unique_ptr<MappedFile> file(new MappedFile(path));
+  if (file->size() < sizeof(Header))
+    return;
+
+  Header header;
+  std::memcpy(&header, file->data(), sizeof(header));
+  if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 ||
+      header.samples < 2)
+    return;
+
+  // exact divisions, so that a square that overflows cannot match
+  const std::size_t bytes = file->size() - sizeof(Header);
+  const std::size_t count = bytes / sizeof(float);
+  if (bytes % sizeof(float) != 0 || count % header.samples != 0 ||
+      count / header.samples != header.samples)
+    return;
+
+  // mmap is page-aligned, and so is the header, so these are aligned too
+  slot->file = std::move(file);
+  slot->samples = header.samples;
+  slot->heights = reinterpret_cast<const float *>(
+      static_cast<const char *>(slot->file->data()) + sizeof(Header));
+}
+
+const Terrain::Slot &Terrain::Lookup(std::size_t tile) {
+  clock_++;
+
+  if (last_ < slots_.size() && slots_[last_].tile == tile) {
+    slots_[last_].used = clock_;
+    return slots_[last_];
+  }
+
+  std::size_t victim = 0;
+  for (std::size_t i = 0; i < slots_.size(); i++) {
+    if (slots_[i].tile == tile) {
+      slots_[i].used = clock_;
+      last_ = i;
+      return slots_[i];
+    }
+    if (slots_[i].used < slots_[victim].used)
+      victim = i;
+  }
+
+  if (slots_.size() < capacity_) {
+    victim = slots_.size();
+    slots_.emplace_back();
+  }
+
+  Load(tile, &slots_[victim]);
+  slots_[victim].used = clock_;
+  last_ = victim;
+  return slots_[victim];
+}
+
+std::string Terrain::TilePath(std::size_t row, std::size_t col) const {
+  assert(row < rows_);
+  assert(col < cols_);
+
+  return directory_ + "/" + std::to_string(row) + "_" + std::to_string(col) +
+         ".dem";
+}
+
+double Terrain::Height(double latitude, double longitude) {
+  assert(std::isfinite(latitude));
+  assert((latitude >= -90.0) && (latitude <= 90.0));
+  assert(std::isfinite(longitude));
+
+  // the position in the tiles, the north pole and the antimeridian are in
+  // the last row and the first column
+  const double u = (latitude + 90.0) / tileSize_;
+  const double v = (longitude + 180.0) / tileSize_;
+  const double w = v - cols_ * std::floor(v / cols_);
+
+  const std::size_t row = std::min(static_cast<std::size_t>(u), rows_ - 1);
+  const std::size_t col = std::min(static_cast<std::size_t>(w), cols_ - 1);
+
+  const Slot &slot = Lookup(row * cols_ + col);
+  if (!slot.heights)
+    return 0.0;
+
+  // the position in the grid of the tile
+  const std::size_t n = slot.samples;
+  const double gy = (u - row) * (n - 1);
+  const double gx = (w - col) * (n - 1);
+
+  const std::size_t i = std::min(static_cast<std::size_t>(gy), n - 2);
+  const std::size_t j = std::min(static_cast<std::size_t>(gx), n - 2);
+  const double ty = gy - i;
+  const double tx = gx - j;
+
+  const float *h = slot.heights + i * n + j;
+  const double south = h[0] + tx * (h[1] - h[0]);
+  const double north = h[n] + tx * (h[n + 1] - h[n]);
+  return south + ty * (north - south);
+}
+
+void Terrain::Height(const double *latitude, const double *longitude,
+                     double *height, std::size_t n) {
+  for (std::size_t i = 0; i < n; i++)
+    height[i] = Height(latitude[i], longitude[i]);
+}
+
+double Terrain::Altitude(Vec3 r) {
+  const double norm = r.norm();
+  assert(norm > 0.0);
+
+  const double latitude = std::asin(r.z_ / norm) * RadToDeg;
+  const double longitude = std::atan2(r.y_, r.x_) * RadToDeg;
+
+  return norm - body_->R_ - Height(latitude, longitude);
+}
+
+bool Terrain::SaveTile(const std::string &path, std::size_t samples,
+                       const float *heights) {
+  assert(samples >= 2);
+  assert(heights);
+
+  Header header;
+  std::memcpy(header.magic, Magic, sizeof(Magic));
+  header.samples = samples;
+  for (std::uint64_t &reserved : header.reserved)
+    reserved = 0;
+
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file)
+    return false;
+
+  std::size_t written = std::fwrite(&header, sizeof(header), 1, file);
+  written += std::fwrite(heights, sizeof(float), samples * samples, file);
+
+  // the buffered tail is only written by fclose
+  const bool closed = std::fclose(file) == 0;
+  return closed && written == 1 + samples * samples;
+}
+
+Terrain::Terrain(const CelestialBody *body, const std::string &directory,
+                 double tileSize, std::size_t capacity)
+    : body_(body), directory_(directory), tileSize_(tileSize), rows_(0),
+      cols_(0), capacity_(capacity), slots_(), clock_(0), last_(0),
+      loads_(0) {
+  assert(body);
+  assert(std::isfinite(tileSize));
+  assert(tileSize > 0.0 && tileSize <= 180.0);
+  assert(capacity > 0);
+
+  const double rows = 180.0 / tileSize;
+  assert(rows == std::floor(rows));
+
+  rows_ = static_cast<std::size_t>(rows);
+  cols_ = 2 * rows_;
+
+  slots_.reserve(capacity);
+}
+
+Terrain::~Terrain() = default;
@@ -0,0 +1,191 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uint64_t
+#include <memory>   // for unique_ptr
+#include <string>   // for string
+#include <vector>   // for vector
+
+class CelestialBody;
+class MappedFile;
+
+/**
+ * @brief terrain height model of a body, from the tiled elevation grids
+ *
+ * The surface is split into the square tiles of tileSize degrees, row 0
+ * starting at the south pole, column 0 at the longitude -180. Each tile is
+ * a file in the directory, TilePath(), with the square grid of the heights
+ * above the datum, [m], from south to north, from west to east, including
+ * both edges, so the bilinear interpolation never needs a neighbour tile.
+ * A missing tile, or a file that is not a valid tile, is at the height 0.
+ *
+ * The tiles are memory-mapped when first needed, and kept in the cache of
+ * the given capacity, the least recently used tile is unmapped to make
+ * room. The consecutive queries in the same tile, as on a ground track, do
+ * not even search the cache.
+ *
+ * The cache is not synchronized, each thread needs its own Terrain; the
+ * mapped pages are shared by all of them anyway.
+ */
+class Terrain {
+private:
+  /**
+   * @brief one cached tile
+   *
+   */
+  struct Slot {
+    std::size_t tile;
+    std::uint64_t used;
+    std::unique_ptr<MappedFile> file;
+
+    // the grid, nullptr if the tile is missing
+    const float *heights;
+    std::size_t samples;
+  };
+
+  /**
+   * @brief the body
+   *
+   */
+  const CelestialBody *body_;
+
+  /**
+   * @brief directory of the tiles
+   *
+   */
+  std::string directory_;
+
+  /**
+   * @brief size of the tiles [deg], and their rows and columns
+   *
+   */
+  double tileSize_;
+  std::size_t rows_;
+  std::size_t cols_;
+
+  /**
+   * @brief maximal number of the cached tiles
+   *
+   */
+  std::size_t capacity_;
+
+  std::vector<Slot> slots_;
+
+  /**
+   * @brief the clock of the LRU, and the slot of the last query
+   *
+   */
+  std::uint64_t clock_;
+  std::size_t last_;
+
+  /**
+   * @brief number of the tiles loaded so far
+   *
+   */
+  std::size_t loads_;
+
+  /**
+   * @brief the slot of the tile, loads it on a miss
+   *
+   */
+  const Slot &Lookup(std::size_t tile);
+
+  /**
+   * @brief maps the tile into the slot
+   *
+   */
+  void Load(std::size_t tile, Slot *slot);
+
+public:
+  /**
+   * @brief size of the tiles [deg]
+   *
+   */
+  double TileSize() const { return tileSize_; }
+
+  /**
+   * @brief number of the tiles loaded so far, the misses of the cache
+   *
+   */
+  std::size_t Loads() const { return loads_; }
+
+  /**
+   * @brief path to the file of the tile
+   *
+   * @param row the row, from the south
+   * @param col the column, from the longitude -180
+   * @return std::string path
+   */
+  std::string TilePath(std::size_t row, std::size_t col) const;
+
+  /**
+   * @brief height of the terrain above the datum [m]
+   *
+   * @param latitude latitude [deg]
+   * @param longitude longitude, any [deg]
+   * @return double height [m]
+   */
+  double Height(double latitude, double longitude);
+
+  /**
+   * @brief batched Height(), over SoA arrays, e.g. for a ground track
+   *
+   */
+  void Height(const double *latitude, const double *longitude,
+              double *height, std::size_t n);
+
+  /**
+   * @brief altitude above the terrain, of the body-fixed position [m]
+   *
+   * The datum is the sphere of the radius of the body.
+   *
+   * @param r position, body-fixed [m]
+   * @return double altitude [m]
+   */
+  double Altitude(Vec3 r);
+
+  /**
+   * @brief writes the tile file
+   *
+   * @param path path to the file
+   * @param samples samples per side of the grid, at least 2
+   * @param heights the grid, samples * samples, see the class description
+   * @return false if the file could not be written completely
+   */
+  static bool SaveTile(const std::string &path, std::size_t samples,
+                       const float *heights);
+
+  /**
+   * @brief creates the terrain
+   *
+   * @param body the body
+   * @param directory directory of the tiles
+   * @param tileSize size of the tiles, dividing 180 [deg]
+   * @param capacity maximal number of the cached tiles
+   */
+  Terrain(const CelestialBody *body, const std::string &directory,
+          double tileSize, std::size_t capacity);
+
+  Terrain(const Terrain &) = delete;
+  Terrain &operator=(const Terrain &) = delete;
+  ~Terrain();
+};
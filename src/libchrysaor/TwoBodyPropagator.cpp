@@ -0,0 +1,328 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TwoBodyPropagator.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include <cassert>           // for assert
+#include <cmath>             // for sqrt, cos, cosh, sin, sinh, log, abs
+#include <limits>            // for numeric_limits
+
+constexpr int TwoBodyPropagator::MaxIterations;
+
+namespace {
+
+// the Taylor series is used below this |z|, where it takes as many terms
+// as the tables have
+const double SeriesLimit = 1.0;
+
+// 1/(2k+2)! and 1/(2k+3)!, the coefficients of (-z)^k in C(z) and S(z)
+const double InverseFactorialC[] = {
+    1.0 / 2.0,
+    1.0 / 24.0,
+    1.0 / 720.0,
+    1.0 / 40320.0,
+    1.0 / 3628800.0,
+    1.0 / 479001600.0,
+    1.0 / 87178291200.0,
+    1.0 / 20922789888000.0,
+    1.0 / 6402373705728000.0,
+    1.0 / 2432902008176640000.0,
+};
+const double InverseFactorialS[] = {
+    1.0 / 6.0,
+    1.0 / 120.0,
+    1.0 / 5040.0,
+    1.0 / 362880.0,
+    1.0 / 39916800.0,
+    1.0 / 6227020800.0,
+    1.0 / 1307674368000.0,
+    1.0 / 355687428096000.0,
+    1.0 / 121645100408832000.0,
+    1.0 / 51090942171709440000.0,
+};
+const int SeriesTerms = sizeof(InverseFactorialC) / sizeof(double);
+
+// Laguerre's n, Conway uses 5
+const double LaguerreN = 5.0;
+
+const double Epsilon = std::numeric_limits<double>::epsilon();
+
+// c4(z) and c5(z), from C(z) and S(z), or the tails of their series where
+// the recurrence cancels
+void HigherStumpff(double z, double c2, double c3, double *c4, double *c5) {
+  if (std::abs(z) < SeriesLimit) {
+    double c = 0.0, s = 0.0;
+    for (int k = SeriesTerms - 1; k >= 1; k--) {
+      c = InverseFactorialC[k] - z * c;
+      s = InverseFactorialS[k] - z * s;
+    }
+    *c4 = c;
+    *c5 = s;
+    return;
+  }
+
+  *c4 = (0.5 - c2) / z;
+  *c5 = (1.0 / 6.0 - c3) / z;
+}
+
+// f, g, df and dg, each followed by its partials over (r0, sigma0, alpha),
+// the Kepler's equation r0*U1 + sigma0*U2 + U3 = sqrt(mu)*dt moves chi with
+// them. Out of line, to keep its frame apart from the one of Transition().
+__attribute__((noinline)) void
+Partials(double r0, double sigma0, double alpha, double chi, double rn,
+         double sqrtMu, double z, double c2, double c3, double *F, double *G,
+         double *dF, double *dG) {
+  double c4, c5;
+  HigherStumpff(z, c2, c3, &c4, &c5);
+
+  // the universal functions
+  const double chi2 = chi * chi;
+  const double U0 = 1.0 - z * c2;
+  const double U1 = chi * (1.0 - z * c3);
+  const double U2 = chi2 * c2;
+  const double U3 = chi2 * chi * c3;
+  const double U4 = chi2 * chi2 * c4;
+  const double U5 = chi2 * chi2 * chi * c5;
+
+  // and their partials over alpha, at the fixed chi
+  const double A0 = -0.5 * chi * U1;
+  const double A1 = 0.5 * (U3 - chi * U2);
+  const double A2 = 0.5 * (2.0 * U4 - chi * U3);
+  const double A3 = 0.5 * (3.0 * U5 - chi * U4);
+
+  F[0] = 1.0 - U2 / r0;
+  G[0] = (r0 * U1 + sigma0 * U2) / sqrtMu;
+  dF[0] = -sqrtMu * U1 / (rn * r0);
+  dG[0] = 1.0 - U2 / rn;
+
+  for (int p = 0; p < 3; p++) {
+    const double K = p == 0 ? U1 : p == 1 ? U2 : r0 * A1 + sigma0 * A2 + A3;
+    const double x = -K / rn;
+    const double a = p == 2 ? 1.0 : 0.0;
+    const double q = p == 0 ? 1.0 / r0 : 0.0;
+
+    const double d0 = -alpha * U1 * x + A0 * a;
+    const double d1 = U0 * x + A1 * a;
+    const double d2 = U1 * x + A2 * a;
+    const double d3 = U2 * x + A3 * a;
+
+    const double dr = (p == 0 ? U0 : 0.0) + (p == 1 ? U1 : 0.0) + r0 * d0 +
+                      sigma0 * d1 + d2;
+
+    F[1 + p] = (q * U2 - d2) / r0;
+    G[1 + p] = -d3 / sqrtMu;
+    dF[1 + p] = -sqrtMu / (rn * r0) * (d1 - U1 * (dr / rn + q));
+    dG[1 + p] = (U2 * dr / rn - d2) / rn;
+  }
+}
+
+// one 3x3 block of the matrix, with the row stride of 6,
+// d*I + r*(pr*r + qr*v)^T + v*(pv*r + qv*v)^T, out of line, not unrolled
+// four times into the frame of Transition()
+__attribute__((noinline)) void Block(Vec3 r, Vec3 v, double d, double pr,
+                                     double qr, double pv, double qv,
+                                     double *m) {
+  const double ri[3] = {r.x_, r.y_, r.z_};
+  const double vi[3] = {v.x_, v.y_, v.z_};
+
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      m[6 * i + j] = (i == j ? d : 0.0) + ri[i] * (pr * ri[j] + qr * vi[j]) +
+                     vi[i] * (pv * ri[j] + qv * vi[j]);
+}
+
+} // namespace
+
+void TwoBodyPropagator::StumpffFunctions(double z, double *c2, double *c3) {
+  if (std::abs(z) < SeriesLimit) {
+    // Horner, from the smallest term
+    double c = 0.0, s = 0.0;
+    for (int k = SeriesTerms - 1; k >= 0; k--) {
+      c = InverseFactorialC[k] - z * c;
+      s = InverseFactorialS[k] - z * s;
+    }
+    *c2 = c;
+    *c3 = s;
+    return;
+  }
+
+  if (z > 0.0) {
+    const double y = std::sqrt(z);
+    *c2 = (1.0 - std::cos(y)) / z;
+    *c3 = (y - std::sin(y)) / (z * y);
+  } else {
+    const double y = std::sqrt(-z);
+    *c2 = (std::cosh(y) - 1.0) / (-z);
+    *c3 = (std::sinh(y) - y) / (-z * y);
+  }
+}
+
+void TwoBodyPropagator::Stumpff(double z) {
+  if (z == z_)
+    return;
+
+  StumpffFunctions(z, &c2_, &c3_);
+  z_ = z;
+}
+
+double TwoBodyPropagator::Guess(double r0, double sigma0, double alpha,
+                                double dt) const {
+  // ellipse
+  if (alpha > 0.0)
+    return sqrtMu_ * dt * alpha;
+
+  // hyperbola, Vallado's guess
+  if (alpha < 0.0) {
+    const double a = 1.0 / alpha;
+    const double s = dt < 0.0 ? -1.0 : 1.0;
+    const double mu = body_->mu_;
+    const double d =
+        sigma0 * sqrtMu_ + s * std::sqrt(-mu * a) * (1.0 - r0 * alpha);
+    const double x = (-2.0 * mu * alpha * dt) / d;
+    if (x > 0.0 && std::isfinite(x))
+      return s * std::sqrt(-a) * std::log(x);
+  }
+
+  // parabola, the first step of the series
+  return sqrtMu_ * dt / r0;
+}
+
+double TwoBodyPropagator::Solve(double r0, double sigma0, double alpha,
+                                double dt) {
+  // warm, unless the conic changed the kind
+  const bool warm = dt_ != 0.0 && (alpha > 0.0) == (alpha_ > 0.0);
+  double chi = warm ? chi_ * (dt / dt_) : Guess(r0, sigma0, alpha, dt);
+
+  const double k = 1.0 - alpha * r0;
+  const double t = sqrtMu_ * dt;
+
+  for (iterations_ = 1; iterations_ <= MaxIterations; iterations_++) {
+    const double chi2 = chi * chi;
+    const double z = alpha * chi2;
+    Stumpff(z);
+
+    const double F = sigma0 * chi2 * c2_ + k * chi2 * chi * c3_ + r0 * chi - t;
+    const double dF = sigma0 * chi * (1.0 - z * c3_) + k * chi2 * c2_ + r0;
+    const double ddF = sigma0 * (1.0 - z * c2_) + k * chi * (1.0 - z * c3_);
+
+    const double n = LaguerreN;
+    const double root = std::sqrt(
+        std::abs((n - 1.0) * (n - 1.0) * dF * dF - n * (n - 1.0) * F * ddF));
+    const double step = n * F / (dF + (dF < 0.0 ? -root : root));
+
+    // the step is below the rounding, and the Stumpff functions in the
+    // cache are those of the solution
+    if (std::abs(step) <= 4.0 * Epsilon * std::abs(chi))
+      break;
+
+    chi -= step;
+  }
+
+  assert(iterations_ <= MaxIterations);
+  return chi;
+}
+
+TwoBodyPropagator::TwoBodyPropagator(const CelestialBody *body)
+    : body_(body), sqrtMu_(0), chi_(0), dt_(0), alpha_(0), z_(0), c2_(0.5),
+      c3_(1.0 / 6.0), iterations_(0) {
+  assert(body);
+  assert(std::isfinite(body->mu_));
+  assert(body->mu_ > 0.0);
+
+  sqrtMu_ = std::sqrt(body->mu_);
+}
+
+void TwoBodyPropagator::Propagate(Vec3 position, Vec3 velocity, double dt,
+                                  Vec3 *newPosition, Vec3 *newVelocity) {
+  assert(newPosition);
+  assert(newVelocity);
+  assert(std::isfinite(dt));
+
+  if (dt == 0.0) {
+    *newPosition = position;
+    *newVelocity = velocity;
+    iterations_ = 0;
+    return;
+  }
+
+  const double r0 = position.norm();
+  assert(r0 > 0.0);
+
+  const double sigma0 = position.dot(velocity) / sqrtMu_;
+  const double alpha = 2.0 / r0 - velocity.dot(velocity) / body_->mu_;
+
+  const double chi = Solve(r0, sigma0, alpha, dt);
+  chi_ = chi;
+  dt_ = dt;
+  alpha_ = alpha;
+
+  const double chi2 = chi * chi;
+  const double f = 1.0 - chi2 * c2_ / r0;
+  const double g = dt - chi2 * chi * c3_ / sqrtMu_;
+
+  const Vec3 r = position * f + velocity * g;
+  const double rn = r.norm();
+
+  const double df = sqrtMu_ / (rn * r0) * chi * (z_ * c3_ - 1.0);
+  const double dg = 1.0 - chi2 * c2_ / rn;
+
+  *newPosition = r;
+  *newVelocity = position * df + velocity * dg;
+}
+
+void TwoBodyPropagator::Transition(Vec3 position, Vec3 velocity, double alpha,
+                                   double chi, double rn, double *stm) const {
+  const double r0 = position.norm();
+  const double sigma0 = position.dot(velocity) / sqrtMu_;
+
+  double F[4], G[4], dF[4], dG[4];
+  Partials(r0, sigma0, alpha, chi, rn, sqrtMu_, z_, c2_, c3_, F, G, dF, dG);
+
+  // the chain to the vectors, over the position:
+  // (r0, sigma0, alpha) -> (r/r0, v/sqrt(mu), -2r/r0^3), and over the
+  // velocity: (0, r/sqrt(mu), -2v/mu)
+  const double ir0 = 1.0 / r0;
+  const double kr = -2.0 * ir0 * ir0 * ir0;
+  const double kv = -2.0 / body_->mu_;
+  const double ks = 1.0 / sqrtMu_;
+
+  Block(position, velocity, F[0], F[1] * ir0 + F[3] * kr, F[2] * ks,
+        G[1] * ir0 + G[3] * kr, G[2] * ks, stm);
+  Block(position, velocity, G[0], F[2] * ks, F[3] * kv, G[2] * ks, G[3] * kv,
+        stm + 3);
+  Block(position, velocity, dF[0], dF[1] * ir0 + dF[3] * kr, dF[2] * ks,
+        dG[1] * ir0 + dG[3] * kr, dG[2] * ks, stm + 18);
+  Block(position, velocity, dG[0], dF[2] * ks, dF[3] * kv, dG[2] * ks,
+        dG[3] * kv, stm + 21);
+}
+
+void TwoBodyPropagator::Propagate(Vec3 position, Vec3 velocity, double dt,
+                                  Vec3 *newPosition, Vec3 *newVelocity,
+                                  double *stm) {
+  assert(stm);
+
+  Propagate(position, velocity, dt, newPosition, newVelocity);
+
+  if (dt == 0.0) {
+    for (int i = 0; i < 36; i++)
+      stm[i] = i % 7 == 0 ? 1.0 : 0.0;
+    return;
+  }
+
+  Transition(position, velocity, alpha_, chi_, newPosition->norm(), stm);
+}
@@ -0,0 +1,236 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Vec3.hpp" // for Vec3
+
+class CelestialBody;
+
+/**
+ * @brief the two-body (Kepler) propagator, in the universal variables
+ *
+ * The universal anomaly \f$\chi\f$, with \f$\alpha={2\over{r_0}}-
+ * {{v_0^2}\over\mu}\f$ and \f$z=\alpha\chi^2\f$, solves the universal
+ * Kepler's equation
+ *
+ * \f$\sqrt\mu\Delta{t}={{\vec{r_0}\cdot\vec{v_0}}\over\sqrt\mu}\chi^2C(z)+
+ * (1-\alpha{r_0})\chi^3S(z)+r_0\chi\f$
+ *
+ * for the ellipse, the parabola and the hyperbola alike, with the Stumpff
+ * functions \f$C(z)\f$ and \f$S(z)\f$. The new state is then the f and g
+ * functions of the initial one, no integration.
+ *
+ * The equation is solved by the Laguerre-Conway iteration, which converges
+ * from about any guess. The guess is warm: the universal anomaly of the
+ * previous call, scaled to the new \f$\Delta{t}\f$. When the same coast arc
+ * is propagated again and again with a perturbed initial state, as in a
+ * trajectory optimization, that is within a step or two of the solution.
+ * Only a call with the opposite sign of \f$\alpha\f$ (an elliptic orbit
+ * after a hyperbolic one, or vice versa) falls back to the cold guess.
+ *
+ * The Stumpff functions of the last solver step are kept for the f and g
+ * functions, and are not recomputed if the next evaluation is at the same
+ * \f$z\f$.
+ *
+ * A propagator is stateful, one per thread.
+ *
+ * \see Vallado, Fundamentals of Astrodynamics and Applications, algorithm 8
+ * \see Conway, An improved algorithm due to Laguerre for the solution of
+ * Kepler's equation, 1986
+ */
+class TwoBodyPropagator {
+private:
+  /**
+   * @brief the parent body
+   *
+   */
+  const CelestialBody *body_;
+
+  /**
+   * @brief \f$\sqrt\mu\f$
+   *
+   */
+  double sqrtMu_;
+
+  /**
+   * @brief the universal anomaly of the previous call
+   *
+   */
+  double chi_;
+
+  /**
+   * @brief the time of flight of the previous call [s], 0 if none
+   *
+   */
+  double dt_;
+
+  /**
+   * @brief \f$\alpha\f$ of the previous call [1/m]
+   *
+   */
+  double alpha_;
+
+  /**
+   * @brief the argument of the cached Stumpff functions
+   *
+   */
+  double z_;
+
+  /**
+   * @brief the cached \f$C(z)\f$
+   *
+   */
+  double c2_;
+
+  /**
+   * @brief the cached \f$S(z)\f$
+   *
+   */
+  double c3_;
+
+  /**
+   * @brief the solver steps of the previous call
+   *
+   */
+  int iterations_;
+
+  /**
+   * @brief evaluates, or recalls, \f$C(z)\f$ and \f$S(z)\f$
+   *
+   * @param z the argument
+   */
+  void Stumpff(double z);
+
+  /**
+   * @brief the cold guess of the universal anomaly
+   *
+   * @param r0 the initial radius [m]
+   * @param sigma0 \f${\vec{r_0}\cdot\vec{v_0}}\over\sqrt\mu\f$ [sqrt(m)]
+   * @param alpha \f$\alpha\f$ [1/m]
+   * @param dt the time of flight [s]
+   * @return double
+   */
+  double Guess(double r0, double sigma0, double alpha, double dt) const;
+
+  /**
+   * @brief solves the universal Kepler's equation
+   *
+   * @param r0 the initial radius [m]
+   * @param sigma0 \f${\vec{r_0}\cdot\vec{v_0}}\over\sqrt\mu\f$ [sqrt(m)]
+   * @param alpha \f$\alpha\f$ [1/m]
+   * @param dt the time of flight [s]
+   * @return double the universal anomaly [sqrt(m)], the Stumpff functions
+   * of it are cached
+   */
+  double Solve(double r0, double sigma0, double alpha, double dt);
+
+  /**
+   * @brief the state transition matrix of the previous Solve()
+   *
+   * @param position the initial position [m]
+   * @param velocity the initial velocity [m/s]
+   * @param alpha \f$\alpha\f$ [1/m]
+   * @param chi the universal anomaly [sqrt(m)]
+   * @param rn the final radius [m]
+   * @param stm the matrix, row-major 6x6
+   */
+  void Transition(Vec3 position, Vec3 velocity, double alpha, double chi,
+                  double rn, double *stm) const;
+
+public:
+  /**
+   * @brief the maximal number of the solver steps
+   *
+   */
+  static constexpr int MaxIterations = 30;
+
+  /**
+   * @brief the Stumpff functions, \f$C(z)={{1-\cos\sqrt{z}}\over{z}}\f$ and
+   * \f$S(z)={{\sqrt{z}-\sin\sqrt{z}}\over{\sqrt{z}^3}}\f$
+   *
+   * With the hyperbolic functions for \f$z<0\f$. Near \f$z=0\f$, where both
+   * forms cancel, the Taylor series is summed instead, from the table of the
+   * inverse factorials.
+   *
+   * @param z the argument
+   * @param c2 \f$C(z)\f$
+   * @param c3 \f$S(z)\f$
+   */
+  static void StumpffFunctions(double z, double *c2, double *c3);
+
+  /**
+   * @brief the propagator around the given body
+   *
+   * @param body the parent body
+   */
+  explicit TwoBodyPropagator(const CelestialBody *body);
+
+  /**
+   * @brief propagates the state by the given time of flight
+   *
+   * @param position the initial position, relative to the body [m]
+   * @param velocity the initial velocity, relative to the body [m/s]
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param newPosition the position after dt [m]
+   * @param newVelocity the velocity after dt [m/s]
+   */
+  void Propagate(Vec3 position, Vec3 velocity, double dt, Vec3 *newPosition,
+                 Vec3 *newVelocity);
+
+  /**
+   * @brief propagates the state, and its state transition matrix
+   *
+   * The matrix \f$\Phi={{\partial(\vec{r},\vec{v})}\over
+   * {\partial(\vec{r_0},\vec{v_0})}}\f$ is analytic: the f and g functions
+   * are differentiated over \f$r_0\f$, \f$\sigma_0\f$ and \f$\alpha\f$,
+   * with the universal anomaly held by the Kepler's equation, using
+   * \f${{\partial{U_n}}\over{\partial\alpha}}=
+   * {1\over2}(nU_{n+2}-\chi{U_{n+1}})\f$ for the universal functions
+   * \f$U_n=\chi^nc_n(\alpha\chi^2)\f$. It costs a few dozen flops over
+   * the propagation, instead of the 6 to 12 extra propagations of the finite
+   * differences.
+   *
+   * \see Battin, An Introduction to the Mathematics and Methods of
+   * Astrodynamics, 4.5 and 9.7
+   *
+   * @param position the initial position, relative to the body [m]
+   * @param velocity the initial velocity, relative to the body [m/s]
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param newPosition the position after dt [m]
+   * @param newVelocity the velocity after dt [m/s]
+   * @param stm the state transition matrix, row-major 6x6, the rows and
+   * the columns are \f$(x, y, z, v_x, v_y, v_z)\f$
+   */
+  void Propagate(Vec3 position, Vec3 velocity, double dt, Vec3 *newPosition,
+                 Vec3 *newVelocity, double *stm);
+
+  /**
+   * @brief the number of the solver steps of the previous Propagate()
+   *
+   * @return int
+   */
+  int Iterations() const { return iterations_; }
+
+  /**
+   * @brief the parent body
+   *
+   * @return const CelestialBody*
+   */
+  const CelestialBody *Body() const { return body_; }
+};
@@ -0,0 +1,169 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UnscentedTransform.hpp"
+#include "NumericalPropagator.hpp" // for NumericalPropagator
+#include "Parallel.hpp"            // for ParallelFor
+#include <algorithm>               // for min
+#include <cassert>                 // for assert
+#include <cmath>                   // for sqrt, isfinite
+#include <vector>                  // for vector
+
+constexpr int UnscentedTransform::Dimension;
+constexpr int UnscentedTransform::SigmaPoints;
+constexpr std::size_t UnscentedTransform::BlockPoints;
+
+namespace {
+
+const int N = UnscentedTransform::Dimension;
+
+// the lower Cholesky factor, P = L*L^T, may be in place, the zero pivots
+// of the semi-definite P give the zero columns
+void Cholesky(const double *P, double *L) {
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      double s = P[N * i + j];
+      for (int k = 0; k < j; k++)
+        s -= L[N * i + k] * L[N * j + k];
+
+      if (i == j)
+        L[N * i + i] = s > 0.0 ? std::sqrt(s) : 0.0;
+      else
+        L[N * i + j] = L[N * j + j] > 0.0 ? s / L[N * j + j] : 0.0;
+    }
+  }
+
+  for (int i = 0; i < N; i++)
+    for (int j = i + 1; j < N; j++)
+      L[N * i + j] = 0.0;
+}
+
+// the weighted mean of the sigma points of a case, less its mean point
+__attribute__((noinline)) void Delta(const double *state, std::size_t stride,
+                                     std::size_t first, double weight,
+                                     double *delta) {
+  for (int k = 0; k < N; k++) {
+    const double *x = state + k * stride + first;
+    double sum = 0.0;
+    for (int i = 1; i < UnscentedTransform::SigmaPoints; i++)
+      sum += x[i] - x[0];
+    delta[k] = weight * sum;
+  }
+}
+
+// covariance += w*e*e^T, out of line, not unrolled into the frame of
+// Reconstruct()
+__attribute__((noinline)) void AddOuter(double w, const double *e,
+                                        double *covariance) {
+  for (int k = 0; k < N; k++)
+    for (int l = 0; l < N; l++)
+      covariance[N * k + l] += w * e[k] * e[l];
+}
+
+} // namespace
+
+UnscentedTransform::UnscentedTransform(double alpha, double beta,
+                                       double kappa)
+    : scale_(0), meanWeight_(0), covarianceWeight_(0), weight_(0) {
+  assert(std::isfinite(alpha) && alpha > 0.0);
+  assert(std::isfinite(beta));
+  assert(std::isfinite(kappa));
+
+  const double spread = alpha * alpha * (N + kappa);
+  assert(spread > 0.0);
+
+  const double lambda = spread - N;
+  scale_ = std::sqrt(spread);
+  meanWeight_ = lambda / spread;
+  covarianceWeight_ = meanWeight_ + 1.0 - alpha * alpha + beta;
+  weight_ = 0.5 / spread;
+}
+
+void UnscentedTransform::Reconstruct(const double *state, std::size_t stride,
+                                     std::size_t first, double *mean,
+                                     double *covariance) const {
+  // the new mean, relative to the mean point
+  double delta[N];
+  Delta(state, stride, first, weight_, delta);
+
+  // the mean point itself is at -delta from the mean
+  for (int k = 0; k < N * N; k++)
+    covariance[k] = 0.0;
+  AddOuter(covarianceWeight_, delta, covariance);
+
+  for (int i = 1; i < SigmaPoints; i++) {
+    double e[N];
+    for (int k = 0; k < N; k++) {
+      const double *x = state + k * stride + first;
+      e[k] = x[i] - x[0] - delta[k];
+    }
+    AddOuter(weight_, e, covariance);
+  }
+
+  for (int k = 0; k < N; k++)
+    mean[k] = state[k * stride + first] + delta[k];
+}
+
+void UnscentedTransform::Propagate(const NumericalPropagator *propagator,
+                                   const double *mean,
+                                   const double *covariance, double dt,
+                                   double *newMean, double *newCovariance,
+                                   std::size_t n) const {
+  assert(propagator);
+  assert(mean);
+  assert(covariance);
+  assert(newMean);
+  assert(newCovariance);
+
+  // the sigma points of all of the cases, SoA, kept for the next call
+  const std::size_t points = SigmaPoints * n;
+  thread_local std::vector<double> sigma;
+  if (sigma.size() < N * points)
+    sigma.resize(N * points);
+  double *state = sigma.data();
+
+  for (std::size_t c = 0; c < n; c++) {
+    // the factor goes to the output, which is free until the end
+    double *L = newCovariance + N * N * c;
+    Cholesky(covariance + N * N * c, L);
+
+    const double *m = mean + N * c;
+    const std::size_t first = SigmaPoints * c;
+    for (int k = 0; k < N; k++) {
+      double *x = state + k * points + first;
+      x[0] = m[k];
+      for (int j = 0; j < N; j++) {
+        x[1 + j] = m[k] + scale_ * L[N * k + j];
+        x[1 + N + j] = m[k] - scale_ * L[N * k + j];
+      }
+    }
+  }
+
+  const std::size_t blocks = (points + BlockPoints - 1) / BlockPoints;
+  ParallelFor(blocks, [propagator, state, points, dt](std::size_t b) {
+    thread_local double scratch[NumericalPropagator::BatchScratch *
+                                BlockPoints];
+    const std::size_t first = b * BlockPoints;
+    const std::size_t count = std::min(BlockPoints, points - first);
+    propagator->Propagate(state + first, points, count, dt, scratch);
+  });
+
+  for (std::size_t c = 0; c < n; c++)
+    Reconstruct(state, points, SigmaPoints * c, newMean + N * c,
+                newCovariance + N * N * c);
+}
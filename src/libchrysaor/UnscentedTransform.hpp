@@ -0,0 +1,142 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstddef> // for size_t
+
+class NumericalPropagator;
+
+/**
+ * @brief the unscented transform of the state uncertainty, through the
+ * numerical propagation
+ *
+ * The mean state \f$\bar{x}\f$ and its covariance \f$P\f$ are sampled by the
+ * \f$2n+1\f$ sigma points, \f$\bar{x}\f$ and \f$\bar{x}\pm\sqrt{n+\lambda}
+ * L_j\f$ for the columns of the Cholesky factor \f$P=LL^T\f$, with
+ * \f$\lambda=\alpha^2(n+\kappa)-n\f$. Those are propagated, and the new mean
+ * and covariance are their weighted sums, exact for the linear motion, and
+ * to the second order otherwise. For the few dozen propagations, instead of
+ * the thousands of a Monte Carlo run.
+ *
+ * The sigma points of all of the cases of a call are propagated together, as
+ * one SoA batch, split among the threads of the ParallelFor() pool in the
+ * blocks of BlockPoints. Each thread integrates its blocks in its own
+ * thread-local scratch, which the pool threads keep from one call to the
+ * next, and the batch itself is kept by the calling thread, so only a call
+ * with more points than ever before allocates.
+ *
+ * The sums are taken relative to the propagated mean point, not to the
+ * origin, so they do not cancel with the small \f$\alpha\f$ and the orbital
+ * distances.
+ *
+ * \see Wan, van der Merwe, The Unscented Kalman Filter for Nonlinear
+ * Estimation, 2000
+ */
+class UnscentedTransform {
+public:
+  /**
+   * @brief the dimension of the state, position and velocity
+   *
+   */
+  static constexpr int Dimension = 6;
+
+  /**
+   * @brief the number of the sigma points per case
+   *
+   */
+  static constexpr int SigmaPoints = 2 * Dimension + 1;
+
+  /**
+   * @brief the number of the sigma points per parallel task
+   *
+   */
+  static constexpr std::size_t BlockPoints = 64;
+
+private:
+  /**
+   * @brief \f$\sqrt{n+\lambda}\f$, the spread of the sigma points
+   *
+   */
+  double scale_;
+
+  /**
+   * @brief the weight of the mean point in the mean
+   *
+   */
+  double meanWeight_;
+
+  /**
+   * @brief the weight of the mean point in the covariance
+   *
+   */
+  double covarianceWeight_;
+
+  /**
+   * @brief the weight of each of the other points, in both
+   *
+   */
+  double weight_;
+
+  /**
+   * @brief the new mean and covariance of one case
+   *
+   * @param state the propagated sigma points, SoA
+   * @param stride the distance of the arrays of state
+   * @param first the index of the mean point of the case
+   * @param mean the new mean
+   * @param covariance the new covariance, row-major 6x6
+   */
+  void Reconstruct(const double *state, std::size_t stride, std::size_t first,
+                   double *mean, double *covariance) const;
+
+public:
+  /**
+   * @brief the transform with the given spread of the sigma points
+   *
+   * @param alpha the spread, \f$0<\alpha\le1\f$
+   * @param beta the prior knowledge of the distribution, 2 for the Gaussian
+   * @param kappa the secondary spread
+   */
+  explicit UnscentedTransform(double alpha = 1.0, double beta = 2.0,
+                              double kappa = 0.0);
+
+  /**
+   * @brief propagates the mean states and their covariances
+   *
+   * @param propagator the propagator, only its const batched Propagate() is
+   * used, from all of the threads
+   * @param mean the mean states, 6 per case, position [m], velocity [m/s]
+   * @param covariance their covariances, row-major 6x6 per case, positive
+   * semi-definite
+   * @param dt the time of flight [s], negative to propagate backwards
+   * @param newMean the new mean states, may be mean
+   * @param newCovariance the new covariances, may be covariance
+   * @param n the number of the cases
+   */
+  void Propagate(const NumericalPropagator *propagator, const double *mean,
+                 const double *covariance, double dt, double *newMean,
+                 double *newCovariance, std::size_t n = 1) const;
+
+  /**
+   * @brief \f$\sqrt{n+\lambda}\f$, the spread of the sigma points
+   *
+   * @return double
+   */
+  double Scale() const { return scale_; }
+};
@@ -19,6 +19,15 @@
 #include "Vec3.hpp"
 #include <iostream>
 
-::std::ostream &operator<<(::std::ostream &os, const Vec3 &bar) {
+template <typename T>
+::std::ostream &operator<<(::std::ostream &os, const BasicVec3<T> &bar) {
   return os << "(" << bar.x_ << "; " << bar.y_ << "; " << bar.z_ << ")";
 }
+
+template class BasicVec3<float>;
+template class BasicVec3<double>;
+
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicVec3<float> &bar);
+template ::std::ostream &operator<<(::std::ostream &os,
+                                    const BasicVec3<double> &bar);
@@ -21,104 +21,160 @@
 #include <cmath>
 #include <iostream>
 
-class Vec3 {
+/**
+ * @brief 3-dimensional vector
+ *
+ * All the operators are constexpr and defined inline, so that compound
+ * expressions like \f$\vec{r} + \vec{v}{dt} + \vec{a}{{dt^2}\over{2}}\f$
+ * get fully inlined and collapse into a single pass over the components,
+ * with no intermediate Vec3 stored to memory.
+ *
+ * Compound assignment operators update the vector in-place and return a
+ * reference to it, so chained updates do not copy either.
+ *
+ * The scalar type is a template parameter, so the same geometry code works
+ * with float, double, or with a Dual number (forward-mode automatic
+ * differentiation, see Dual.hpp).
+ *
+ * @tparam T scalar type
+ */
+template <typename T> class BasicVec3 {
 public:
-  double x_;
-  double y_;
-  double z_;
+  T x_;
+  T y_;
+  T z_;
 
-  bool operator==(Vec3 rhs) const {
+  constexpr bool operator==(BasicVec3 rhs) const {
     return (x_ == rhs.x_ && y_ == rhs.y_ && z_ == rhs.z_);
   }
 
-  Vec3 operator+(Vec3 rhs) const {
-    return Vec3(x_ + rhs.x_, y_ + rhs.y_, z_ + rhs.z_);
+  constexpr BasicVec3 operator+(BasicVec3 rhs) const {
+    return BasicVec3(x_ + rhs.x_, y_ + rhs.y_, z_ + rhs.z_);
   }
-  Vec3 operator+=(Vec3 rhs) {
-    *this = *this + rhs;
+  constexpr BasicVec3 &operator+=(BasicVec3 rhs) {
+    x_ += rhs.x_;
+    y_ += rhs.y_;
+    z_ += rhs.z_;
     return *this;
   }
 
-  Vec3 operator-(Vec3 rhs) const {
-    return Vec3(x_ - rhs.x_, y_ - rhs.y_, z_ - rhs.z_);
+  constexpr BasicVec3 operator-(BasicVec3 rhs) const {
+    return BasicVec3(x_ - rhs.x_, y_ - rhs.y_, z_ - rhs.z_);
   }
-  Vec3 operator-=(Vec3 rhs) {
-    *this = *this - rhs;
+  constexpr BasicVec3 &operator-=(BasicVec3 rhs) {
+    x_ -= rhs.x_;
+    y_ -= rhs.y_;
+    z_ -= rhs.z_;
     return *this;
   }
 
-  Vec3 operator*(Vec3 rhs) const {
-    return Vec3(x_ * rhs.x_, y_ * rhs.y_, z_ * rhs.z_);
+  constexpr BasicVec3 operator*(BasicVec3 rhs) const {
+    return BasicVec3(x_ * rhs.x_, y_ * rhs.y_, z_ * rhs.z_);
   }
-  Vec3 operator*=(Vec3 rhs) {
-    *this = *this * rhs;
+  constexpr BasicVec3 &operator*=(BasicVec3 rhs) {
+    x_ *= rhs.x_;
+    y_ *= rhs.y_;
+    z_ *= rhs.z_;
     return *this;
   }
 
-  Vec3 operator/(Vec3 rhs) const {
-    return Vec3(x_ / rhs.x_, y_ / rhs.y_, z_ / rhs.z_);
+  constexpr BasicVec3 operator/(BasicVec3 rhs) const {
+    return BasicVec3(x_ / rhs.x_, y_ / rhs.y_, z_ / rhs.z_);
   }
-  Vec3 operator/=(Vec3 rhs) {
-    *this = *this / rhs;
+  constexpr BasicVec3 &operator/=(BasicVec3 rhs) {
+    x_ /= rhs.x_;
+    y_ /= rhs.y_;
+    z_ /= rhs.z_;
     return *this;
   }
 
-  Vec3 operator+(double scalar) const {
-    return Vec3(x_ + scalar, y_ + scalar, z_ + scalar);
+  constexpr BasicVec3 operator+(T scalar) const {
+    return BasicVec3(x_ + scalar, y_ + scalar, z_ + scalar);
   }
-  Vec3 operator+=(double scalar) {
-    *this = *this + scalar;
+  constexpr BasicVec3 &operator+=(T scalar) {
+    x_ += scalar;
+    y_ += scalar;
+    z_ += scalar;
     return *this;
   }
 
-  Vec3 operator-(double scalar) const {
-    return Vec3(x_ - scalar, y_ - scalar, z_ - scalar);
+  constexpr BasicVec3 operator-(T scalar) const {
+    return BasicVec3(x_ - scalar, y_ - scalar, z_ - scalar);
   }
-  Vec3 operator-=(double scalar) {
-    *this = *this - scalar;
+  constexpr BasicVec3 &operator-=(T scalar) {
+    x_ -= scalar;
+    y_ -= scalar;
+    z_ -= scalar;
     return *this;
   }
 
-  Vec3 operator*(double scalar) const {
-    return Vec3(x_ * scalar, y_ * scalar, z_ * scalar);
+  constexpr BasicVec3 operator*(T scalar) const {
+    return BasicVec3(x_ * scalar, y_ * scalar, z_ * scalar);
   }
-  Vec3 operator*=(double scalar) {
-    *this = *this * scalar;
+  constexpr BasicVec3 &operator*=(T scalar) {
+    x_ *= scalar;
+    y_ *= scalar;
+    z_ *= scalar;
     return *this;
   }
 
-  Vec3 operator/(double scalar) const {
-    return Vec3(x_ / scalar, y_ / scalar, z_ / scalar);
+  constexpr BasicVec3 operator/(T scalar) const {
+    return BasicVec3(x_ / scalar, y_ / scalar, z_ / scalar);
   }
-  Vec3 operator/=(double scalar) {
-    *this = *this / scalar;
+  constexpr BasicVec3 &operator/=(T scalar) {
+    x_ /= scalar;
+    y_ /= scalar;
+    z_ /= scalar;
     return *this;
   }
 
   /**
    * @brief euclidean norm, L^2-Norm
    *
-   * @return double
+   * @return T
    */
-  double norm() const { return std::sqrt(x_ * x_ + y_ * y_ + z_ * z_); }
+  T norm() const {
+    using std::sqrt;
+    return sqrt(dot(*this));
+  }
 
   /**
    * @brief dot product
    *
-   * @return double
+   * @return T
    */
-  double dot(Vec3 rhs) const {
+  constexpr T dot(BasicVec3 rhs) const {
     return (x_ * rhs.x_ + y_ * rhs.y_ + z_ * rhs.z_);
   }
 
-  Vec3 cross(Vec3 rhs) const {
-    return Vec3(y_ * rhs.z_ - z_ * rhs.y_, z_ * rhs.x_ - x_ * rhs.z_,
-                x_ * rhs.y_ - y_ * rhs.x_);
+  constexpr BasicVec3 cross(BasicVec3 rhs) const {
+    return BasicVec3(y_ * rhs.z_ - z_ * rhs.y_, z_ * rhs.x_ - x_ * rhs.z_,
+                     x_ * rhs.y_ - y_ * rhs.x_);
   }
 
-  Vec3() : x_(0.0), y_(0.0), z_(0.0) {}
-  Vec3(double x, double y, double z) : x_(x), y_(y), z_(z) {}
-  explicit Vec3(const double (&v)[3]) : x_(v[0]), y_(v[1]), z_(v[2]) {}
+  constexpr BasicVec3() : x_(0.0), y_(0.0), z_(0.0) {}
+  constexpr BasicVec3(T x, T y, T z) : x_(x), y_(y), z_(z) {}
+  constexpr explicit BasicVec3(const T (&v)[3])
+      : x_(v[0]), y_(v[1]), z_(v[2]) {}
 };
 
-std::ostream &operator<<(::std::ostream &os, const Vec3 &bar);
+template <typename T>
+std::ostream &operator<<(::std::ostream &os, const BasicVec3<T> &bar);
+
+extern template class BasicVec3<float>;
+extern template class BasicVec3<double>;
+
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicVec3<float> &bar);
+extern template std::ostream &operator<<(::std::ostream &os,
+                                         const BasicVec3<double> &bar);
+
+/**
+ * @brief single precision vector, for bandwidth-bound code
+ */
+using Vec3f = BasicVec3<float>;
+
+/**
+ * @brief double precision vector, the default one
+ */
+using Vec3 = BasicVec3<double>;
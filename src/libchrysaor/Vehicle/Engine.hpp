@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "Constants.hpp"              // for StandardGravity
 #include "Curve/AbstractCurve.hpp"    // for AbstractCurve
 #include "Curve/LinearCurvePoint.hpp" // for LinearCurvePoint
 
@@ -25,7 +26,7 @@
 * @brief std gravity asl [m/s^2]
 * http://physics.nist.gov/cgi-bin/cuu/Value?gn
 */
-static const double constexpr g0 = 9.80665;
+static const double constexpr g0 = Constants::StandardGravity;
 
 /**
  * @brief provides all the necessary functionality to model an engine
@@ -0,0 +1,196 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BodySystem.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for M_PI, isinf, sin, sqrt
+#include <cstddef>           // for size_t
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <vector>            // for vector
+
+namespace {
+
+const CelestialBody Kerbol(1.1723328e+18, 261600000.0, 432000.0);
+const CelestialBody Kerbin(&Kerbol, 3.5316000e+12, 600000.0, 21549.425);
+const CelestialBody Mun(&Kerbin, 6.5138398e+10, 200000.0, 138984.38);
+const CelestialBody Minmus(&Kerbin, 1.7658000e+09, 60000.0, 40400.0);
+const CelestialBody Duna(&Kerbol, 3.0136321e+11, 320000.0, 65517.859);
+
+class BodySystemTest : public ::testing::Test {
+protected:
+  BodySystem system;
+
+  std::size_t kerbol;
+  std::size_t kerbin;
+  std::size_t mun;
+  std::size_t minmus;
+  std::size_t duna;
+
+  BodySystemTest() : system(), kerbol(), kerbin(), mun(), minmus(), duna() {
+    kerbol = system.Add(&Kerbol);
+    kerbin = system.Add(&Kerbin, 13599840256.0, 0.0, 0.0, 179.9);
+    mun = system.Add(&Mun, 12000000.0, 0.0, 0.0, 97.4);
+    duna = system.Add(&Duna, 20726155264.0, 0.06, 135.5, 179.9);
+    minmus = system.Add(&Minmus, 47000000.0, 6.0, 78.0, 108.9);
+  }
+};
+
+} // namespace
+
+TEST(CelestialBodyHierarchyTest, TestParentBody) {
+  ASSERT_EQ(nullptr, Kerbol.ParentBody());
+  ASSERT_EQ(&Kerbol, Kerbin.ParentBody());
+  ASSERT_EQ(&Kerbin, Mun.ParentBody());
+  ASSERT_EQ(&Kerbin, Minmus.ParentBody());
+}
+
+TEST_F(BodySystemTest, TestStructure) {
+  ASSERT_EQ(5, system.size());
+
+  ASSERT_EQ(0, kerbol);
+  ASSERT_EQ(&Mun, system.Body(mun));
+  ASSERT_EQ(minmus, system.Index(&Minmus));
+
+  ASSERT_EQ(kerbol, system.Parent(kerbol));
+  ASSERT_EQ(kerbol, system.Parent(kerbin));
+  ASSERT_EQ(kerbin, system.Parent(mun));
+  ASSERT_EQ(kerbin, system.Parent(minmus));
+  ASSERT_EQ(kerbol, system.Parent(duna));
+}
+
+TEST(BodySystemAddTest, TestMissingParent) {
+  BodySystem system;
+  system.Add(&Kerbol);
+
+  // the Mun orbits Kerbin, which is not in the system
+  ASSERT_EQ(system.size(), system.Index(&Kerbin));
+  ASSERT_EQ(1, system.Add(&Mun, 12000000.0, 0.0, 0.0, 97.4));
+  ASSERT_EQ(1, system.size());
+
+  ASSERT_EQ(1, system.Add(&Kerbin, 13599840256.0, 0.0, 0.0, 179.9));
+  ASSERT_EQ(2, system.Add(&Mun, 12000000.0, 0.0, 0.0, 97.4));
+  ASSERT_EQ(3, system.size());
+}
+
+TEST_F(BodySystemTest, TestSphereOfInfluence) {
+  ASSERT_TRUE(std::isinf(system.SphereOfInfluence(kerbol)));
+
+  // as in the game
+  ASSERT_NEAR(84159286.0, system.SphereOfInfluence(kerbin), 1.0);
+  ASSERT_NEAR(2429559.1, system.SphereOfInfluence(mun), 1.0);
+  ASSERT_NEAR(2247428.4, system.SphereOfInfluence(minmus), 1.0);
+  ASSERT_NEAR(47921949.0, system.SphereOfInfluence(duna), 1.0);
+}
+
+TEST_F(BodySystemTest, TestPositions) {
+  for (double t = 0.0; t < 1.0e+07; t = 3.0 * t + 1000.0) {
+    system.Update(t);
+    ASSERT_EQ(t, system.Epoch());
+
+    ASSERT_EQ(0.0, system.Position(kerbol).norm());
+    ASSERT_NEAR(13599840256.0, system.Position(kerbin).norm(), 1.0e-03);
+    ASSERT_NEAR(12000000.0,
+                (system.Position(mun) - system.Position(kerbin)).norm(),
+                1.0e-06);
+    ASSERT_EQ(system.Position(kerbin) + system.RelativePosition(minmus, t),
+              system.Position(minmus));
+  }
+}
+
+TEST_F(BodySystemTest, TestPeriod) {
+  // relative orbit, so both masses count, unlike in the game
+  const double T = 2.0 * M_PI * std::sqrt(12000000.0 * 12000000.0 *
+                                          12000000.0 / (Kerbin.mu_ + Mun.mu_));
+
+  const Vec3 r0 = system.RelativePosition(mun, 0.0);
+  const Vec3 rT = system.RelativePosition(mun, T);
+  ASSERT_NEAR(0.0, (r0 - rT).norm(), 10.0);
+
+  // half a period later, on the other side
+  const Vec3 rT2 = system.RelativePosition(mun, T / 2.0);
+  ASSERT_NEAR(0.0, (r0 + rT2).norm(), 10.0);
+
+  // inclined orbit
+  const Vec3 minmus0 = system.RelativePosition(minmus, 0.0);
+  ASSERT_NEAR(47000000.0 * std::sin(M_PI * 6.0 / 180.0) *
+                  std::sin(M_PI * 108.9 / 180.0),
+              minmus0.z_, 1.0e-06);
+}
+
+TEST_F(BodySystemTest, TestDominantBody) {
+  system.Update(123456.0);
+
+  const Vec3 kerbinPos = system.Position(kerbin);
+  const Vec3 munPos = system.Position(mun);
+
+  ASSERT_EQ(kerbol, system.DominantBody(Vec3(0.0, 0.0, 1.0e+09)));
+  ASSERT_EQ(kerbin, system.DominantBody(kerbinPos + Vec3(0, 0, 7.0e+05)));
+  ASSERT_EQ(mun, system.DominantBody(munPos + Vec3(0, 0, 2.4e+06)));
+  ASSERT_EQ(kerbin, system.DominantBody(munPos + Vec3(0, 0, 2.5e+06)));
+  ASSERT_EQ(kerbol, system.DominantBody(kerbinPos + Vec3(0, 8.5e+07, 0)));
+  ASSERT_EQ(duna, system.DominantBody(system.Position(duna) +
+                                      Vec3(1.0e+07, 0, 0)));
+  ASSERT_EQ(minmus, system.DominantBody(system.Position(minmus)));
+}
+
+TEST_F(BodySystemTest, TestHint) {
+  system.Update(98765.0);
+
+  const Vec3 kerbinPos = system.Position(kerbin);
+
+  unsigned seed = 42;
+  for (int k = 0; k < 1000; k++) {
+    Vec3 r;
+    for (double *c : {&r.x_, &r.y_, &r.z_}) {
+      seed = seed * 1103515245u + 12345u;
+      *c = (double(seed % 20001) - 10000.0) * 1.0e+04;
+    }
+    r += kerbinPos;
+
+    const std::size_t ref = system.DominantBody(r);
+    for (std::size_t hint = 0; hint < system.size(); hint++)
+      ASSERT_EQ(ref, system.DominantBody(r, hint));
+  }
+}
+
+TEST_F(BodySystemTest, TestBatch) {
+  system.Update(0.0);
+
+  // a straight line from the Mun, to Kerbin, to the interplanetary space
+  const Vec3 from = system.Position(mun);
+  const Vec3 to = system.Position(kerbin) * 1.1;
+
+  const std::size_t n = 1000;
+  std::vector<double> x(n), y(n), z(n);
+  std::vector<std::size_t> body(n);
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 r = from + (to - from) * (double(i) / n);
+    x[i] = r.x_;
+    y[i] = r.y_;
+    z[i] = r.z_;
+  }
+
+  system.DominantBody(x.data(), y.data(), z.data(), body.data(), n);
+
+  for (std::size_t i = 0; i < n; i++)
+    ASSERT_EQ(system.DominantBody(Vec3(x[i], y[i], z[i])), body[i]);
+
+  ASSERT_EQ(mun, body.front());
+  ASSERT_EQ(kerbol, body.back());
+}
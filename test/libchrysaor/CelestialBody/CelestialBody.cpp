@@ -20,6 +20,8 @@
 #include "Atmosphere.hpp"             // for Atmosphere
 #include "Curve/AbstractCurve.hpp"    // for AbstractCurve
 #include "Curve/LinearCurvePoint.hpp" // for LinearCurvePoint
+#include "Vec3.hpp"                   // for Vec3
+#include <cmath>                      // for M_PI
 #include <gtest/gtest.h>              // for Message, TestPartResult, TestP...
 
 TEST(CelestialBodyTest, TestConstructor) {
@@ -116,3 +118,56 @@ TEST(CelestialBodyTest, TestSpeedAtLat) {
   ASSERT_LT(s_minus90deg, s_2859deg);
   ASSERT_LT(s_minus90deg, s_0deg);
 }
+
+TEST(CelestialBodyTest, TestDerivedConstants) {
+  const CelestialBody Earth(3.986004418e+14, 6378136.6, 86164.098903691);
+
+  ASSERT_DOUBLE_EQ(2.0 * M_PI / 86164.098903691, Earth.omega_);
+  ASSERT_NEAR(7.292115e-05, Earth.omega_, 1.0e-11);
+  ASSERT_DOUBLE_EQ(Earth.omega_ * Earth.R_, Earth.equatorialSpeed_);
+  ASSERT_DOUBLE_EQ(Earth.equatorialSpeed_, Earth.EquatorialSpeed());
+
+  // non-rotating
+  const CelestialBody foo;
+  ASSERT_EQ(0.0, foo.omega_);
+  ASSERT_EQ(0.0, foo.EquatorialSpeed());
+}
+
+TEST(CelestialBodyTest, TestGravitationalAccelerationAtRadius) {
+  const CelestialBody Earth(3.986004418e+14, 6378136.6);
+
+  for (double alt = 0.0; alt < 1.0e+08; alt = 2.0 * alt + 1.0e+03) {
+    ASSERT_DOUBLE_EQ(Earth.GravitationalAcceleration(alt),
+                     Earth.GravitationalAccelerationAtRadius(alt + Earth.R_));
+  }
+}
+
+TEST(CelestialBodyTest, TestGravitationalAccelerationVector) {
+  const CelestialBody Earth(3.986004418e+14, 6378136.6);
+
+  const Vec3 r(4.0e+06, -3.0e+06, 5.0e+06);
+  const Vec3 a = Earth.GravitationalAcceleration(r);
+
+  // points towards the center
+  ASSERT_NEAR(-1.0, a.dot(r) / (a.norm() * r.norm()), 1.0e-15);
+  ASSERT_DOUBLE_EQ(Earth.GravitationalAccelerationAtRadius(r.norm()),
+                   a.norm());
+}
+
+TEST(CelestialBodyTest, TestGravitationalAccelerationBatch) {
+  const CelestialBody Earth(3.986004418e+14, 6378136.6);
+
+  const double x[] = {7.0e+06, 0.0, -4.0e+06, 1.0e+08, 6.5e+06};
+  const double y[] = {0.0, 7.0e+06, 3.0e+06, -2.0e+07, 1.0e+05};
+  const double z[] = {0.0, 0.0, -5.0e+06, 3.0e+05, 2.0e+06};
+  double ax[5], ay[5], az[5];
+
+  Earth.GravitationalAcceleration(x, y, z, ax, ay, az, 5);
+
+  for (int i = 0; i < 5; i++) {
+    const Vec3 a = Earth.GravitationalAcceleration(Vec3(x[i], y[i], z[i]));
+    ASSERT_DOUBLE_EQ(a.x_, ax[i]);
+    ASSERT_DOUBLE_EQ(a.y_, ay[i]);
+    ASSERT_DOUBLE_EQ(a.z_, az[i]);
+  }
+}
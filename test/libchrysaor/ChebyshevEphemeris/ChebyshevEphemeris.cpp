@@ -0,0 +1,258 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ChebyshevEphemeris.hpp"
+#include "BodySystem.hpp"    // for BodySystem
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <cstddef>           // for size_t
+#include <cstdio>            // for remove
+#include <cstdlib>           // for mkstemp
+#include <cstring>           // for memcpy
+#include <fstream>           // for ifstream, ofstream
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <ios>               // for ios
+#include <iterator>          // for istreambuf_iterator
+#include <string>            // for string
+#include <thread>            // for thread
+#include <unistd.h>          // for close
+#include <vector>            // for vector
+
+namespace {
+
+const CelestialBody Kerbol(1.1723328e+18, 261600000.0, 432000.0);
+const CelestialBody Kerbin(&Kerbol, 3.5316000e+12, 600000.0, 21549.425);
+const CelestialBody Mun(&Kerbin, 6.5138398e+10, 200000.0, 138984.38);
+const CelestialBody Minmus(&Kerbin, 1.7658000e+09, 60000.0, 40400.0);
+
+// a day of the Mun orbit per segment
+const double t0 = -1.0e+05;
+const double t1 = 1.0e+06;
+const double segment = 21600.0;
+const std::size_t degree = 16;
+
+class ChebyshevEphemerisTest : public ::testing::Test {
+protected:
+  BodySystem system;
+
+  ChebyshevEphemerisTest() : system() {
+    system.Add(&Kerbol);
+    system.Add(&Kerbin, 13599840256.0, 0.0, 0.0, 179.9);
+    system.Add(&Mun, 12000000.0, 0.0, 0.0, 97.4);
+    system.Add(&Minmus, 47000000.0, 6.0, 78.0, 108.9);
+  }
+
+  // times, all over the span, including both ends
+  std::vector<double> Times() const {
+    std::vector<double> t;
+    for (double f = 0.0; f <= 1.0; f += 1.0 / 1024.0)
+      t.push_back(t0 + f * (t1 - t0));
+    t.push_back(t1);
+    return t;
+  }
+};
+
+std::string TemporaryFile() {
+  char path[] = "/tmp/chrysaor-ephemeris-XXXXXX";
+  const int fd = mkstemp(path);
+  close(fd);
+  return path;
+}
+
+std::string Read(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)),
+                     std::istreambuf_iterator<char>());
+}
+
+void Write(const std::string &path, const std::string &bytes) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out << bytes;
+}
+
+} // namespace
+
+TEST_F(ChebyshevEphemerisTest, TestStructure) {
+  const ChebyshevEphemeris ephemeris(system, t0, t1, segment, degree);
+
+  ASSERT_EQ(4, ephemeris.size());
+  ASSERT_EQ(51, ephemeris.Segments());
+  ASSERT_EQ(degree, ephemeris.Degree());
+  ASSERT_EQ(t0, ephemeris.Begin());
+  ASSERT_EQ(t1, ephemeris.End());
+
+  for (std::size_t body = 0; body < system.size(); body++)
+    ASSERT_EQ(system.Parent(body), ephemeris.Parent(body));
+}
+
+TEST_F(ChebyshevEphemerisTest, TestAccuracy) {
+  const ChebyshevEphemeris ephemeris(system, t0, t1, segment, degree);
+
+  for (const double t : Times()) {
+    ASSERT_EQ(0.0, ephemeris.Position(0, t).norm());
+
+    for (std::size_t body = 1; body < system.size(); body++) {
+      const Vec3 ref = system.RelativePosition(body, t);
+      ASSERT_NEAR(0.0, (ephemeris.Position(body, t) - ref).norm(),
+                  1.0e-13 * ref.norm());
+    }
+  }
+}
+
+TEST_F(ChebyshevEphemerisTest, TestBatch) {
+  const ChebyshevEphemeris ephemeris(system, t0, t1, segment, degree);
+
+  const std::vector<double> t = Times();
+  const std::size_t n = t.size();
+  std::vector<double> x(n), y(n), z(n);
+
+  ephemeris.Position(2, t.data(), x.data(), y.data(), z.data(), n);
+
+  for (std::size_t i = 0; i < n; i++)
+    ASSERT_EQ(ephemeris.Position(2, t[i]), Vec3(x[i], y[i], z[i]));
+}
+
+TEST_F(ChebyshevEphemerisTest, TestBodySystem) {
+  const ChebyshevEphemeris ephemeris(system, t0, t1, segment, degree);
+
+  BodySystem cached;
+  cached.Add(&Kerbol);
+  cached.Add(&Kerbin, 13599840256.0, 0.0, 0.0, 179.9);
+  cached.Add(&Mun, 12000000.0, 0.0, 0.0, 97.4);
+  cached.Add(&Minmus, 47000000.0, 6.0, 78.0, 108.9);
+  cached.UseEphemeris(&ephemeris);
+
+  for (const double t : Times()) {
+    system.Update(t);
+    cached.Update(t);
+
+    for (std::size_t body = 1; body < system.size(); body++) {
+      ASSERT_NEAR(0.0, (cached.Position(body) - system.Position(body)).norm(),
+                  1.0e-13 * system.Position(body).norm());
+    }
+
+    ASSERT_EQ(ephemeris.Position(3, t) + cached.Position(1),
+              cached.Position(3));
+  }
+}
+
+TEST_F(ChebyshevEphemerisTest, TestFile) {
+  const std::string path = TemporaryFile();
+
+  const ChebyshevEphemeris fitted(system, t0, t1, segment, degree);
+  ASSERT_TRUE(fitted.Save(path));
+
+  const ChebyshevEphemeris mapped(path);
+  std::remove(path.c_str());
+
+  ASSERT_TRUE(fitted.valid());
+  ASSERT_TRUE(mapped.valid());
+  ASSERT_EQ(fitted.size(), mapped.size());
+  ASSERT_EQ(fitted.Segments(), mapped.Segments());
+  ASSERT_EQ(fitted.Degree(), mapped.Degree());
+  ASSERT_EQ(fitted.Begin(), mapped.Begin());
+  ASSERT_EQ(fitted.End(), mapped.End());
+
+  for (std::size_t body = 0; body < fitted.size(); body++) {
+    ASSERT_EQ(fitted.Parent(body), mapped.Parent(body));
+
+    for (const double t : Times())
+      ASSERT_EQ(fitted.Position(body, t), mapped.Position(body, t));
+  }
+}
+
+TEST_F(ChebyshevEphemerisTest, TestThreads) {
+  const std::string path = TemporaryFile();
+  ASSERT_TRUE(ChebyshevEphemeris(system, t0, t1, segment, degree).Save(path));
+
+  const ChebyshevEphemeris shared(path);
+  std::remove(path.c_str());
+
+  const std::vector<double> t = Times();
+
+  // every worker reads the same mapping
+  const std::size_t workers = 4;
+  std::vector<std::vector<Vec3>> results(workers);
+  std::vector<std::thread> threads;
+  for (std::size_t w = 0; w < workers; w++) {
+    threads.emplace_back([&shared, &t, &results, w]() {
+      for (const double ti : t)
+        results[w].push_back(shared.Position(2, ti));
+    });
+  }
+
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (std::size_t w = 0; w < workers; w++) {
+    ASSERT_EQ(t.size(), results[w].size());
+    for (std::size_t i = 0; i < t.size(); i++)
+      ASSERT_EQ(shared.Position(2, t[i]), results[w][i]);
+  }
+}
+
+TEST_F(ChebyshevEphemerisTest, TestMissingFile) {
+  const std::string path = TemporaryFile();
+  std::remove(path.c_str());
+
+  const ChebyshevEphemeris missing(path);
+  ASSERT_FALSE(missing.valid());
+  ASSERT_EQ(0, missing.size());
+}
+
+TEST_F(ChebyshevEphemerisTest, TestMalformedFile) {
+  const std::string path = TemporaryFile();
+  ASSERT_TRUE(ChebyshevEphemeris(system, t0, t1, segment, 4).Save(path));
+  const std::string good = Read(path);
+  ASSERT_TRUE(ChebyshevEphemeris(path).valid());
+
+  std::string magic = good;
+  magic[7] = '2';
+  std::string parent = good;
+  parent[64] = 99;
+  std::string terms = good;
+  terms[24] = 0;
+  std::string span = good;
+  std::memcpy(&span[32], &t1, sizeof(t1));
+
+  const std::string bad[] = {"",
+                             good.substr(0, 32),
+                             good.substr(0, good.size() - 8),
+                             good + "12345678",
+                             good + "1",
+                             magic,
+                             parent,
+                             terms,
+                             span};
+
+  for (const std::string &bytes : bad) {
+    Write(path, bytes);
+
+    const ChebyshevEphemeris ephemeris(path);
+    ASSERT_FALSE(ephemeris.valid());
+    ASSERT_EQ(0, ephemeris.size());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_F(ChebyshevEphemerisTest, TestSaveUnwritable) {
+  const ChebyshevEphemeris fitted(system, t0, t1, segment, 4);
+
+  ASSERT_FALSE(fitted.Save("/nonexistent-chrysaor-directory/ephemeris"));
+}
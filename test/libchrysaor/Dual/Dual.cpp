@@ -0,0 +1,109 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Dual.hpp"      // for Dual, operator*, operator+, sqrt, sin, ...
+#include <cmath>         // for cos, sin, sqrt, exp, log, atan2
+#include <gtest/gtest.h> // for ASSERT_DOUBLE_EQ, ASSERT_EQ, TEST
+
+TEST(DualTest, TestConstructor) {
+  ASSERT_NO_THROW({ Dual<double> foo; });
+  ASSERT_NO_THROW({ Dual<double> foo(1.0); });
+  ASSERT_NO_THROW({ Dual<double> foo(1.0, 2.0); });
+  ASSERT_NO_THROW({ Dual<float> foo(1.0f, 2.0f); });
+}
+
+TEST(DualTest, TestGetter) {
+  const Dual<double> foo;
+  ASSERT_EQ(0.0, foo.val_);
+  ASSERT_EQ(0.0, foo.eps_);
+
+  const Dual<double> bar(4.2);
+  ASSERT_EQ(4.2, bar.val_);
+  ASSERT_EQ(0.0, bar.eps_);
+
+  const Dual<double> baz(4.2, -1.5);
+  ASSERT_EQ(4.2, baz.val_);
+  ASSERT_EQ(-1.5, baz.eps_);
+}
+
+TEST(DualTest, TestArithmetic) {
+  const Dual<double> x(3.0, 1.0);
+
+  // f(x) = (2x + 1) * x - x / 4, f'(x) = 4x + 1 - 1/4
+  const Dual<double> f = (2.0 * x + 1.0) * x - x / 4.0;
+  ASSERT_DOUBLE_EQ(21.0 - 0.75, f.val_);
+  ASSERT_DOUBLE_EQ(13.0 - 0.25, f.eps_);
+
+  // f(x) = 1 / x, f'(x) = -1 / x^2
+  const Dual<double> g = 1.0 / x;
+  ASSERT_DOUBLE_EQ(1.0 / 3.0, g.val_);
+  ASSERT_DOUBLE_EQ(-1.0 / 9.0, g.eps_);
+
+  // f(x) = x / x, f'(x) = 0
+  const Dual<double> h = x / x;
+  ASSERT_DOUBLE_EQ(1.0, h.val_);
+  ASSERT_DOUBLE_EQ(0.0, h.eps_);
+
+  const Dual<double> n = -x;
+  ASSERT_DOUBLE_EQ(-3.0, n.val_);
+  ASSERT_DOUBLE_EQ(-1.0, n.eps_);
+}
+
+TEST(DualTest, TestElementaryFunctions) {
+  const double v = 0.3;
+  const Dual<double> x(v, 1.0);
+
+  ASSERT_DOUBLE_EQ(std::sqrt(v), sqrt(x).val_);
+  ASSERT_DOUBLE_EQ(0.5 / std::sqrt(v), sqrt(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::sin(v), sin(x).val_);
+  ASSERT_DOUBLE_EQ(std::cos(v), sin(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::cos(v), cos(x).val_);
+  ASSERT_DOUBLE_EQ(-std::sin(v), cos(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::exp(v), exp(x).val_);
+  ASSERT_DOUBLE_EQ(std::exp(v), exp(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::log(v), log(x).val_);
+  ASSERT_DOUBLE_EQ(1.0 / v, log(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::asin(v), asin(x).val_);
+  ASSERT_DOUBLE_EQ(1.0 / std::sqrt(1.0 - v * v), asin(x).eps_);
+
+  ASSERT_DOUBLE_EQ(std::pow(v, 3.0), pow(x, 3.0).val_);
+  ASSERT_DOUBLE_EQ(3.0 * v * v, pow(x, 3.0).eps_);
+
+  // d/dx atan2(1, x) = -1 / (1 + x^2)
+  const Dual<double> y(1.0);
+  ASSERT_DOUBLE_EQ(std::atan2(1.0, v), atan2(y, x).val_);
+  ASSERT_DOUBLE_EQ(-1.0 / (1.0 + v * v), atan2(y, x).eps_);
+}
+
+TEST(DualTest, TestComparison) {
+  const Dual<double> foo(1.0, 5.0);
+  const Dual<double> bar(1.0, -5.0);
+  const Dual<double> baz(2.0, 0.0);
+
+  ASSERT_TRUE(foo == bar);
+  ASSERT_TRUE(foo != baz);
+  ASSERT_TRUE(foo < baz);
+  ASSERT_TRUE(baz > foo);
+  ASSERT_TRUE(foo <= bar);
+  ASSERT_TRUE(foo >= bar);
+}
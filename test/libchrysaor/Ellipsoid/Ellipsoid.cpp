@@ -0,0 +1,155 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Ellipsoid.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Constants.hpp"     // for EarthEquatorialRadius, EarthInverseF...
+#include "SolarSystem.hpp"   // for Earth
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for cos, sin, sqrt, M_PI
+#include <cstddef>           // for size_t
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <vector>            // for vector
+
+namespace {
+
+const Ellipsoid Earth(Constants::EarthEquatorialRadius,
+                      1.0 / Constants::EarthInverseFlattening);
+
+void ExpectNear(Vec3 ref, Vec3 v, double eps) {
+  EXPECT_NEAR(ref.x_, v.x_, eps);
+  EXPECT_NEAR(ref.y_, v.y_, eps);
+  EXPECT_NEAR(ref.z_, v.z_, eps);
+}
+
+} // namespace
+
+TEST(EllipsoidTest, TestConstructor) {
+  EXPECT_EQ(Constants::EarthEquatorialRadius, Earth.EquatorialRadius());
+  EXPECT_EQ(1.0 / Constants::EarthInverseFlattening, Earth.Flattening());
+  EXPECT_NEAR(6356751.9, Earth.PolarRadius(), 0.1);
+
+  const Ellipsoid sphere(&SolarSystem::Earth);
+  EXPECT_EQ(SolarSystem::Earth.R_, sphere.EquatorialRadius());
+  EXPECT_EQ(SolarSystem::Earth.R_, sphere.PolarRadius());
+  EXPECT_EQ(0.0, sphere.Flattening());
+}
+
+TEST(EllipsoidTest, TestToCartesian) {
+  const double a = Earth.EquatorialRadius();
+  const double b = Earth.PolarRadius();
+
+  ExpectNear(Vec3(a, 0.0, 0.0), Earth.ToCartesian(0.0, 0.0, 0.0), 1e-6);
+  ExpectNear(Vec3(0.0, a + 100.0, 0.0), Earth.ToCartesian(0.0, 90.0, 100.0),
+             1e-6);
+  ExpectNear(Vec3(0.0, 0.0, b), Earth.ToCartesian(90.0, 0.0, 0.0), 1e-6);
+  ExpectNear(Vec3(0.0, 0.0, -b - 10.0), Earth.ToCartesian(-90.0, 0.0, 10.0),
+             1e-6);
+
+  // the point is on the ellipsoid, and the normal there is the latitude
+  const double lat = 37.5;
+  const Vec3 r = Earth.ToCartesian(lat, 0.0, 0.0);
+  EXPECT_NEAR(1.0, r.x_ * r.x_ / (a * a) + r.z_ * r.z_ / (b * b), 1e-15);
+  const double phi = lat * M_PI / 180.0;
+  const Vec3 up(std::cos(phi), 0.0, std::sin(phi));
+  ExpectNear(r + up * 1000.0, Earth.ToCartesian(lat, 0.0, 1000.0), 1e-6);
+}
+
+TEST(EllipsoidTest, TestSphere) {
+  const double R = 600000.0;
+  const Ellipsoid sphere(R, 0.0);
+
+  for (double lat = -90.0; lat <= 90.0; lat += 15.0) {
+    for (double lon = -165.0; lon <= 180.0; lon += 15.0) {
+      const double phi = lat * M_PI / 180.0;
+      const double lambda = lon * M_PI / 180.0;
+      const Vec3 ref = Vec3(std::cos(phi) * std::cos(lambda),
+                            std::cos(phi) * std::sin(lambda), std::sin(phi)) *
+                       (R + 70000.0);
+
+      const Vec3 r = sphere.ToCartesian(lat, lon, 70000.0);
+      ExpectNear(ref, r, 1e-8);
+
+      double la, lo, h;
+      sphere.ToGeodetic(r, &la, &lo, &h);
+      EXPECT_NEAR(lat, la, 1e-12);
+      EXPECT_NEAR(70000.0, h, 1e-8);
+      if (std::fabs(lat) != 90.0) {
+        EXPECT_NEAR(lon, lo, 1e-12);
+      }
+    }
+  }
+}
+
+TEST(EllipsoidTest, TestRoundTrip) {
+  // from the bottom of the ocean, to the geostationary orbit, to the Moon
+  const double altitudes[] = {-11000.0, 0.0,         8848.0,
+                              400000.0, 35786000.0, 384400000.0};
+
+  for (double altitude : altitudes) {
+    for (double lat = -90.0; lat <= 90.0; lat += 2.5) {
+      for (double lon = -180.0 + 7.5; lon <= 180.0; lon += 15.0) {
+        double la, lo, h;
+        Earth.ToGeodetic(Earth.ToCartesian(lat, lon, altitude), &la, &lo, &h);
+
+        // 1e-10 deg is about 0.01 mm on the surface of the Earth
+        EXPECT_NEAR(lat, la, 1e-10);
+        EXPECT_NEAR(altitude, h, 1e-6);
+        if (std::fabs(lat) != 90.0) {
+          EXPECT_NEAR(lon, lo, 1e-9);
+        }
+      }
+    }
+  }
+}
+
+TEST(EllipsoidTest, TestBatch) {
+  const std::size_t n = 1001;
+
+  std::vector<double> lat(n), lon(n), alt(n);
+  for (std::size_t i = 0; i < n; i++) {
+    lat[i] = -89.0 + 178.0 * i / (n - 1);
+    lon[i] = -180.0 + 359.0 * i / (n - 1);
+    alt[i] = 1000.0 * i;
+  }
+
+  std::vector<double> x(n), y(n), z(n);
+  Earth.ToCartesian(lat.data(), lon.data(), alt.data(), x.data(), y.data(),
+                    z.data(), n);
+
+  std::vector<double> la(n), lo(n), h(n);
+  Earth.ToGeodetic(x.data(), y.data(), z.data(), la.data(), lo.data(),
+                   h.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 r = Earth.ToCartesian(lat[i], lon[i], alt[i]);
+    EXPECT_EQ(r.x_, x[i]);
+    EXPECT_EQ(r.y_, y[i]);
+    EXPECT_EQ(r.z_, z[i]);
+
+    double ref[3];
+    Earth.ToGeodetic(r, &ref[0], &ref[1], &ref[2]);
+    EXPECT_EQ(ref[0], la[i]);
+    EXPECT_EQ(ref[1], lo[i]);
+    EXPECT_EQ(ref[2], h[i]);
+
+    EXPECT_NEAR(lat[i], la[i], 1e-9);
+    EXPECT_NEAR(lon[i], lo[i], 1e-9);
+    EXPECT_NEAR(alt[i], h[i], 1e-3);
+  }
+}
@@ -0,0 +1,400 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Gravity/SphericalHarmonicGravity.hpp"
+#include "CelestialBody.hpp"        // for CelestialBody
+#include "Dual.hpp"                 // for Dual
+#include "Gravity/ZonalGravity.hpp" // for ZonalGravity
+#include "Vec3.hpp"                 // for Vec3
+#include <cmath>                    // for sqrt
+#include <cstdio>                   // for remove
+#include <cstdlib>                  // for mkstemp
+#include <fstream>                  // for ofstream
+#include <gtest/gtest.h>            // for Message, TestPartResult, TestP...
+#include <sstream>                  // for ostringstream, istringstream
+#include <string>                   // for string
+#include <thread>                   // for thread
+#include <unistd.h>                 // for close
+#include <vector>                   // for vector
+
+namespace {
+
+const double mu = 3.986004415e+14;
+const double R = 6378136.3;
+
+// EGM2008, up to degree and order 3
+const char *const EGM2008_3x3 = "# GM R\n"
+                                "3.986004415e+14 6378136.3\n"
+                                "\n"
+                                "# n m C S\n"
+                                "2 0 -4.84165143790815e-04 0\n"
+                                "2 1 -2.06615509074176e-10 "
+                                "1.38441389137979e-09\n"
+                                "2 2 2.43938357328313e-06 "
+                                "-1.40027370385934e-06\n"
+                                "3 0 9.57161207093473e-07 0\n"
+                                "3 1 2.03046201047864e-06 "
+                                "2.48200415856872e-07\n"
+                                "3 2 9.04787894809528e-07 "
+                                "-6.19005475177618e-07\n"
+                                "3 3 7.21321757121568e-07 "
+                                "1.41434926192941e-06\n";
+
+SphericalHarmonicGravity Load(const char *text) {
+  std::istringstream in(text);
+  SphericalHarmonicGravity g;
+  EXPECT_TRUE(g.Load(in));
+  return g;
+}
+
+// loads the text into g, as Load() does
+bool LoadInto(SphericalHarmonicGravity *g, const char *text,
+              const CelestialBody *body = nullptr) {
+  std::istringstream in(text);
+  return g->Load(in, body);
+}
+
+// closed-form potential of the degree 2 terms and of C30
+template <typename T> T Potential(const SphericalHarmonicGravity &g, T x, T y,
+                                  T z) {
+  using std::sqrt;
+  const T r2 = x * x + y * y + z * z;
+  const T r = sqrt(r2);
+  const T k = mu / r * (R * R / r2);
+  const T s = z / r;
+
+  const T U20 = g.C(2, 0) * sqrt(5.0) * (3.0 * s * s - 1.0) / 2.0;
+  const T U21 = sqrt(5.0 / 3.0) * 3.0 * z * (g.C(2, 1) * x + g.S(2, 1) * y) /
+                r2;
+  const T U22 = sqrt(5.0 / 12.0) * 3.0 *
+                (g.C(2, 2) * (x * x - y * y) + g.S(2, 2) * 2.0 * x * y) / r2;
+  const T U30 = g.C(3, 0) * sqrt(7.0) * (5.0 * s * s * s - 3.0 * s) / 2.0 *
+                (R / r);
+
+  return mu / r + k * (U20 + U21 + U22) + k * U30;
+}
+
+Vec3 PotentialGradient(const SphericalHarmonicGravity &g, Vec3 r) {
+  using D = Dual<double>;
+  const D gx = Potential(g, D(r.x_, 1.0), D(r.y_), D(r.z_));
+  const D gy = Potential(g, D(r.x_), D(r.y_, 1.0), D(r.z_));
+  const D gz = Potential(g, D(r.x_), D(r.y_), D(r.z_, 1.0));
+  return Vec3(gx.eps_, gy.eps_, gz.eps_);
+}
+
+const Vec3 positions[] = {
+    Vec3(7.0e+06, 0.0, 0.0),           Vec3(0.0, 7.0e+06, 0.0),
+    Vec3(0.0, 0.0, 7.0e+06),           Vec3(0.0, 0.0, -6.6e+06),
+    Vec3(4.0e+06, -3.0e+06, 5.0e+06),  Vec3(-2.0e+06, 6.0e+06, -1.5e+06),
+    Vec3(4.2e+07, 1.0e+06, 3.0e+05),   Vec3(1.0, 2.0, 6.5e+06),
+};
+
+void ExpectNear(Vec3 ref, Vec3 a, double tolerance) {
+  const double eps = tolerance * ref.norm();
+  EXPECT_NEAR(ref.x_, a.x_, eps);
+  EXPECT_NEAR(ref.y_, a.y_, eps);
+  EXPECT_NEAR(ref.z_, a.z_, eps);
+}
+
+} // namespace
+
+TEST(SphericalHarmonicGravityTest, TestLoad) {
+  const SphericalHarmonicGravity g = Load(EGM2008_3x3);
+
+  ASSERT_EQ(mu, g.mu());
+  ASSERT_EQ(R, g.R());
+  ASSERT_EQ(3, g.LoadedDegree());
+  ASSERT_EQ(3, g.MaxDegree());
+  ASSERT_EQ(3, g.MaxOrder());
+
+  ASSERT_EQ(1.0, g.C(0, 0));
+  ASSERT_EQ(0.0, g.C(1, 0));
+  ASSERT_EQ(-4.84165143790815e-04, g.C(2, 0));
+  ASSERT_EQ(-1.40027370385934e-06, g.S(2, 2));
+  ASSERT_EQ(1.41434926192941e-06, g.S(3, 3));
+}
+
+TEST(SphericalHarmonicGravityTest, TestLoadFile) {
+  char path[] = "/tmp/chrysaor-gravity-XXXXXX";
+  const int fd = mkstemp(path);
+  ASSERT_NE(-1, fd);
+  close(fd);
+
+  {
+    std::ofstream out(path);
+    out << EGM2008_3x3;
+  }
+
+  SphericalHarmonicGravity g;
+  ASSERT_TRUE(g.Load(std::string(path)));
+  std::remove(path);
+
+  const SphericalHarmonicGravity ref = Load(EGM2008_3x3);
+  for (const Vec3 &r : positions)
+    ASSERT_EQ(ref.Potential(r), g.Potential(r));
+}
+
+TEST(SphericalHarmonicGravityTest, TestLoadMissingFile) {
+  char path[] = "/tmp/chrysaor-gravity-XXXXXX";
+  const int fd = mkstemp(path);
+  ASSERT_NE(-1, fd);
+  close(fd);
+  std::remove(path);
+
+  SphericalHarmonicGravity g;
+  ASSERT_FALSE(g.Load(std::string(path)));
+
+  // still the empty model
+  ASSERT_EQ(0, g.LoadedDegree());
+  ASSERT_EQ(0.0, g.Acceleration(positions[0]).norm());
+}
+
+TEST(SphericalHarmonicGravityTest, TestLoadMalformed) {
+  const char *const texts[] = {
+      "",
+      "# only a comment\n",
+      "3.986004415e+14\n",
+      "3.986004415e+14 6378136.3 1\n",
+      "-3.986004415e+14 6378136.3\n",
+      "3.986004415e+14 0\n",
+      "nan 6378136.3\n",
+      "3.986004415e+14 6378136.3\n2 0 abc 0\n",
+      "3.986004415e+14 6378136.3\n2 0 1e-3\n",
+      "3.986004415e+14 6378136.3\n2 0 1e-3 0 7\n",
+      "3.986004415e+14 6378136.3\n2 3 1e-3 0\n",
+      "3.986004415e+14 6378136.3\n2 -1 1e-3 0\n",
+      "3.986004415e+14 6378136.3\n-2 0 1e-3 0\n",
+      "3.986004415e+14 6378136.3\n2.5 0 1e-3 0\n",
+      "3.986004415e+14 6378136.3\n2 0 inf 0\n",
+      "3.986004415e+14 6378136.3\n999999999 0 1e-3 0\n",
+  };
+
+  for (const char *text : texts) {
+    SphericalHarmonicGravity g = Load(EGM2008_3x3);
+    const Vec3 a = g.Acceleration(positions[0]);
+
+    ASSERT_FALSE(LoadInto(&g, text)) << text;
+
+    // the model is as it was
+    ASSERT_EQ(mu, g.mu());
+    ASSERT_EQ(3, g.LoadedDegree());
+    ASSERT_EQ(a, g.Acceleration(positions[0]));
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestLoadBody) {
+  const CelestialBody Earth(mu, R);
+  const CelestialBody Mars(4.282837e+13, 3396190.0);
+
+  SphericalHarmonicGravity g;
+  ASSERT_FALSE(LoadInto(&g, EGM2008_3x3, &Mars));
+  ASSERT_EQ(0, g.LoadedDegree());
+
+  ASSERT_TRUE(LoadInto(&g, EGM2008_3x3, &Earth));
+  ASSERT_EQ(3, g.LoadedDegree());
+
+  ASSERT_TRUE(g.Matches(Earth));
+  ASSERT_FALSE(g.Matches(Mars));
+
+  // another realization of the Earth, within the tolerance
+  ASSERT_TRUE(g.Matches(CelestialBody(3.986004418e+14, 6378137.0)));
+}
+
+TEST(SphericalHarmonicGravityTest, TestPointMass) {
+  const SphericalHarmonicGravity g = Load("3.986004415e+14 6378136.3\n");
+  const CelestialBody Earth(mu, R);
+
+  ASSERT_EQ(0, g.LoadedDegree());
+
+  for (const Vec3 &r : positions) {
+    ASSERT_DOUBLE_EQ(mu / r.norm(), g.Potential(r));
+    ExpectNear(Earth.GravitationalAcceleration(r), g.Acceleration(r),
+               1.0e-15);
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestZonal) {
+  // C20 = -J2 / sqrt(5), C30 = -J3 / sqrt(7), C40 = -J4 / 3
+  const double J2 = 1.08262668e-03;
+  const double J3 = -2.53265649e-06;
+  const double J4 = -1.61962159e-06;
+
+  std::ostringstream text;
+  text.precision(17);
+  text << mu << " " << R << "\n";
+  text << "2 0 " << -J2 / std::sqrt(5.0) << " 0\n";
+  text << "3 0 " << -J3 / std::sqrt(7.0) << " 0\n";
+  text << "4 0 " << -J4 / 3.0 << " 0\n";
+
+  const SphericalHarmonicGravity g = Load(text.str().c_str());
+
+  const CelestialBody Earth(mu, R);
+  const ZonalGravity ref(&Earth, J2, J3, J4);
+
+  for (const Vec3 &r : positions)
+    ExpectNear(ref.Acceleration(r), g.Acceleration(r), 1.0e-14);
+}
+
+TEST(SphericalHarmonicGravityTest, TestPotentialGradient) {
+  // all the degree 2, but only C30 of the degree 3
+  const SphericalHarmonicGravity g =
+      Load("3.986004415e+14 6378136.3\n"
+           "2 0 -4.84165143790815e-04 0\n"
+           "2 1 -2.06615509074176e-10 1.38441389137979e-09\n"
+           "2 2 2.43938357328313e-06 -1.40027370385934e-06\n"
+           "3 0 9.57161207093473e-07 0\n");
+
+  for (const Vec3 &r : positions)
+    ExpectNear(PotentialGradient(g, r), g.Acceleration(r), 1.0e-14);
+}
+
+TEST(SphericalHarmonicGravityTest, TestFiniteDifferences) {
+  // some pseudo-random field of degree and order 24
+  std::ostringstream text;
+  text.precision(17);
+  text << mu << " " << R << "\n";
+  unsigned seed = 12345;
+  for (int n = 2; n <= 24; n++) {
+    for (int m = 0; m <= n; m++) {
+      seed = seed * 1103515245u + 12345u;
+      const double C = (double(seed % 2001) - 1000.0) * 1.0e-9 / (n * n);
+      seed = seed * 1103515245u + 12345u;
+      const double S =
+          m == 0 ? 0.0 : (double(seed % 2001) - 1000.0) * 1.0e-9 / (n * n);
+      text << n << " " << m << " " << C << " " << S << "\n";
+    }
+  }
+
+  const SphericalHarmonicGravity g = Load(text.str().c_str());
+  ASSERT_EQ(24, g.LoadedDegree());
+
+  const double h = 1.0;
+  for (const Vec3 &r : positions) {
+    const Vec3 fd(
+        (g.Potential(r + Vec3(h, 0, 0)) - g.Potential(r - Vec3(h, 0, 0))) /
+            (2.0 * h),
+        (g.Potential(r + Vec3(0, h, 0)) - g.Potential(r - Vec3(0, h, 0))) /
+            (2.0 * h),
+        (g.Potential(r + Vec3(0, 0, h)) - g.Potential(r - Vec3(0, 0, h))) /
+            (2.0 * h));
+
+    ExpectNear(fd, g.Acceleration(r), 1.0e-7);
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestTruncate) {
+  SphericalHarmonicGravity g = Load(EGM2008_3x3);
+  const SphericalHarmonicGravity degree2 =
+      Load("3.986004415e+14 6378136.3\n"
+           "2 0 -4.84165143790815e-04 0\n"
+           "2 1 -2.06615509074176e-10 1.38441389137979e-09\n"
+           "2 2 2.43938357328313e-06 -1.40027370385934e-06\n");
+
+  for (const Vec3 &r : positions) {
+    const Vec3 full = g.Acceleration(r);
+
+    g.Truncate(2, 2);
+    ASSERT_EQ(degree2.Acceleration(r), g.Acceleration(r));
+    ASSERT_FALSE(full == g.Acceleration(r));
+
+    // and back, the cached tables must be rebuilt
+    g.Truncate(3, 3);
+    ASSERT_EQ(full, g.Acceleration(r));
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestCache) {
+  const SphericalHarmonicGravity g = Load(EGM2008_3x3);
+  const SphericalHarmonicGravity ref = Load(EGM2008_3x3);
+
+  // same direction, different radius; and then back
+  const Vec3 r(4.0e+06, -3.0e+06, 5.0e+06);
+  const Vec3 a1 = g.Acceleration(r);
+  const Vec3 a2 = g.Acceleration(r * 2.0);
+  const Vec3 a3 = g.Acceleration(Vec3(r.x_, r.y_, -r.z_));
+  ASSERT_EQ(a1, g.Acceleration(r));
+
+  ASSERT_EQ(a2, ref.Acceleration(r * 2.0));
+  ASSERT_EQ(a3, ref.Acceleration(Vec3(r.x_, r.y_, -r.z_)));
+}
+
+TEST(SphericalHarmonicGravityTest, TestCelestialBody) {
+  const SphericalHarmonicGravity g = Load(EGM2008_3x3);
+  const CelestialBody Earth(mu, R, 86164.098903691, &g);
+  const CelestialBody Sphere(mu, R, 86164.098903691);
+
+  ASSERT_EQ(&g, Earth.gravityField_);
+  ASSERT_EQ(nullptr, Sphere.gravityField_);
+
+  for (const Vec3 &r : positions) {
+    ASSERT_EQ(g.Acceleration(r), Earth.FieldAcceleration(r));
+    ASSERT_EQ(Sphere.GravitationalAcceleration(r),
+              Sphere.FieldAcceleration(r));
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestWorkspace) {
+  const SphericalHarmonicGravity g = Load(EGM2008_3x3);
+  const SphericalHarmonicGravity degree2 =
+      Load("3.986004415e+14 6378136.3\n"
+           "2 0 -4.84165143790815e-04 0\n");
+
+  // one workspace, shared by the models of the different degree
+  SphericalHarmonicGravity::Workspace workspace;
+  for (const Vec3 &r : positions) {
+    ASSERT_EQ(g.Acceleration(r), g.Acceleration(r, &workspace));
+    ASSERT_EQ(degree2.Acceleration(r), degree2.Acceleration(r, &workspace));
+    ASSERT_EQ(g.Potential(r), g.Potential(r, &workspace));
+    ASSERT_EQ(degree2.Potential(r), degree2.Potential(r, &workspace));
+  }
+}
+
+TEST(SphericalHarmonicGravityTest, TestThreads) {
+  const SphericalHarmonicGravity g = Load(EGM2008_3x3);
+  const CelestialBody Earth(mu, R, 86164.098903691, &g);
+
+  const int count = 4;
+  const int steps = 1000;
+
+  std::vector<Vec3> expected;
+  for (int i = 0; i < steps; i++)
+    expected.push_back(g.Acceleration(
+        positions[i % (sizeof(positions) / sizeof(positions[0]))] *
+        (1.0 + 1.0e-3 * i)));
+
+  // every thread walks the same points, out of step with the others
+  std::vector<int> mismatches(count, 0);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < count; k++) {
+    threads.emplace_back([&, k] {
+      for (int j = 0; j < steps; j++) {
+        const int i = (j + k * 7) % steps;
+        const Vec3 r =
+            positions[i % (sizeof(positions) / sizeof(positions[0]))] *
+            (1.0 + 1.0e-3 * i);
+        if (!(Earth.FieldAcceleration(r) == expected[i]))
+          mismatches[k]++;
+      }
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  for (int k = 0; k < count; k++)
+    ASSERT_EQ(0, mismatches[k]);
+}
@@ -0,0 +1,139 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Gravity/ZonalGravity.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Dual.hpp"          // for Dual
+#include "Vec3.hpp"          // for Vec3
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+
+namespace {
+
+const CelestialBody Earth(3.986004418e+14, 6378136.6);
+
+const double J2 = 1.08262668e-03;
+const double J3 = -2.53265649e-06;
+const double J4 = -1.61962159e-06;
+
+// the zonal potential itself, acceleration is its gradient
+template <typename T> T Potential(T x, T y, T z) {
+  using std::sqrt;
+  const T r = sqrt(x * x + y * y + z * z);
+  const T s = z / r;
+  const T q = Earth.R_ / r;
+
+  const T P2 = (3.0 * s * s - 1.0) / 2.0;
+  const T P3 = (5.0 * s * s * s - 3.0 * s) / 2.0;
+  const T P4 = (35.0 * s * s * s * s - 30.0 * s * s + 3.0) / 8.0;
+
+  return Earth.mu_ / r * (1.0 - J2 * q * q * P2 - J3 * q * q * q * P3 -
+                          J4 * q * q * q * q * P4);
+}
+
+Vec3 PotentialGradient(Vec3 r) {
+  using D = Dual<double>;
+  const D gx = Potential(D(r.x_, 1.0), D(r.y_), D(r.z_));
+  const D gy = Potential(D(r.x_), D(r.y_, 1.0), D(r.z_));
+  const D gz = Potential(D(r.x_), D(r.y_), D(r.z_, 1.0));
+  return Vec3(gx.eps_, gy.eps_, gz.eps_);
+}
+
+const Vec3 positions[] = {
+    Vec3(7.0e+06, 0.0, 0.0),          Vec3(0.0, 0.0, 7.0e+06),
+    Vec3(0.0, 0.0, -6.6e+06),         Vec3(4.0e+06, -3.0e+06, 5.0e+06),
+    Vec3(-2.0e+06, 6.0e+06, -1.5e+06), Vec3(4.2e+07, 1.0e+06, 3.0e+05),
+};
+
+} // namespace
+
+TEST(ZonalGravityTest, TestConstructor) {
+  ASSERT_NO_THROW({ ZonalGravity foo(&Earth, J2); });
+  ASSERT_NO_THROW({ ZonalGravity foo(&Earth, J2, J3); });
+  ASSERT_NO_THROW({ ZonalGravity foo(&Earth, J2, J3, J4); });
+}
+
+TEST(ZonalGravityTest, TestPointMass) {
+  const ZonalGravity g(&Earth, 0.0);
+
+  for (const Vec3 &r : positions) {
+    const Vec3 a = g.Acceleration(r);
+    const Vec3 ref = Earth.GravitationalAcceleration(r);
+
+    ASSERT_NEAR(ref.x_, a.x_, 1.0e-15 * ref.norm());
+    ASSERT_NEAR(ref.y_, a.y_, 1.0e-15 * ref.norm());
+    ASSERT_NEAR(ref.z_, a.z_, 1.0e-15 * ref.norm());
+  }
+}
+
+TEST(ZonalGravityTest, TestPotentialGradient) {
+  const ZonalGravity g(&Earth, J2, J3, J4);
+
+  for (const Vec3 &r : positions) {
+    const Vec3 a = g.Acceleration(r);
+    const Vec3 ref = PotentialGradient(r);
+
+    ASSERT_NEAR(ref.x_, a.x_, 1.0e-14 * ref.norm());
+    ASSERT_NEAR(ref.y_, a.y_, 1.0e-14 * ref.norm());
+    ASSERT_NEAR(ref.z_, a.z_, 1.0e-14 * ref.norm());
+  }
+}
+
+TEST(ZonalGravityTest, TestOblateness) {
+  const ZonalGravity g(&Earth, J2);
+
+  // at the equator, the bulge pulls stronger, the force is still radial
+  const Vec3 eq(7.0e+06, 0.0, 0.0);
+  const Vec3 aEq = g.Acceleration(eq);
+  ASSERT_GT(aEq.norm(), Earth.GravitationalAcceleration(eq).norm());
+  ASSERT_EQ(0.0, aEq.y_);
+  ASSERT_EQ(0.0, aEq.z_);
+
+  // above the pole, it is weaker
+  const Vec3 pole(0.0, 0.0, 7.0e+06);
+  ASSERT_LT(g.Acceleration(pole).norm(),
+            Earth.GravitationalAcceleration(pole).norm());
+
+  // and at mid-latitudes, it pulls towards the equatorial plane harder than
+  // towards the axis
+  const Vec3 mid(5.0e+06, 0.0, 5.0e+06);
+  const Vec3 aMid = g.Acceleration(mid);
+  const Vec3 aMidPoint = Earth.GravitationalAcceleration(mid);
+  ASSERT_GT(aMid.x_, aMidPoint.x_);
+  ASSERT_LT(aMid.z_, aMidPoint.z_);
+}
+
+TEST(ZonalGravityTest, TestBatch) {
+  const ZonalGravity g(&Earth, J2, J3, J4);
+
+  const std::size_t n = sizeof(positions) / sizeof(positions[0]);
+  double x[n], y[n], z[n], ax[n], ay[n], az[n];
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = positions[i].x_;
+    y[i] = positions[i].y_;
+    z[i] = positions[i].z_;
+  }
+
+  g.Acceleration(x, y, z, ax, ay, az, n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 a = g.Acceleration(positions[i]);
+    ASSERT_EQ(a.x_, ax[i]);
+    ASSERT_EQ(a.y_, ay[i]);
+    ASSERT_EQ(a.z_, az[i]);
+  }
+}
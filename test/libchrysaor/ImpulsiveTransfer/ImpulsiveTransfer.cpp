@@ -0,0 +1,152 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ImpulsiveTransfer.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include <cmath>                                 // for sqrt, cos, sin
+#include <cstddef>                               // for size_t
+#include <gtest/gtest.h>                         // for Message, TestPa...
+#include <vector>                                // for vector
+
+namespace {
+
+const double Pi = 3.14159265358979323846;
+
+const double LEO = 6678000.0;
+const double GEO = 42164000.0;
+
+} // namespace
+
+TEST(ImpulsiveTransferTest, TestConstructor) {
+  ASSERT_NO_THROW({ ImpulsiveTransfer foo; });
+  ASSERT_NO_THROW({ ImpulsiveTransfer::Hohmann(LEO, GEO, &Earth); });
+}
+
+TEST(ImpulsiveTransferTest, TestHohmann) {
+  ImpulsiveTransfer foo = ImpulsiveTransfer::Hohmann(LEO, GEO, &Earth);
+
+  // the textbook LEO to GEO transfer
+  EXPECT_NEAR(2.42e3, foo.dv1_, 10.0);
+  EXPECT_NEAR(1.46e3, foo.dv2_, 10.0);
+  EXPECT_NEAR(3.89e3, foo.dv_, 10.0);
+  EXPECT_EQ(0.0, foo.dv3_);
+  EXPECT_NEAR(5.27 * 3600.0, foo.tof_, 60.0);
+
+  // the same way down
+  ImpulsiveTransfer bar = ImpulsiveTransfer::Hohmann(GEO, LEO, &Earth);
+  EXPECT_NEAR(foo.dv_, bar.dv_, 1e-6);
+  EXPECT_DOUBLE_EQ(foo.tof_, bar.tof_);
+}
+
+TEST(ImpulsiveTransferTest, TestBiElliptic) {
+  // beyond the ratio of about 15.58, a far enough apoapsis wins
+  const double r2 = 20.0 * LEO;
+  ImpulsiveTransfer hohmann = ImpulsiveTransfer::Hohmann(LEO, r2, &Earth);
+  ImpulsiveTransfer foo =
+      ImpulsiveTransfer::BiElliptic(LEO, r2, 100.0 * LEO, &Earth);
+  EXPECT_LT(foo.dv_, hohmann.dv_);
+  EXPECT_GT(foo.tof_, hohmann.tof_);
+  EXPECT_DOUBLE_EQ(foo.dv1_ + foo.dv2_ + foo.dv3_, foo.dv_);
+
+  // with the intermediate apoapsis at the target, it is a Hohmann transfer
+  ImpulsiveTransfer bar = ImpulsiveTransfer::BiElliptic(LEO, r2, r2, &Earth);
+  EXPECT_NEAR(hohmann.dv_, bar.dv_, 1e-6);
+  EXPECT_DOUBLE_EQ(hohmann.tof_ + Pi * std::sqrt(r2 * r2 * r2 / Earth.mu_),
+                   bar.tof_);
+}
+
+TEST(ImpulsiveTransferTest, TestPlaneChange) {
+  ImpulsiveTransfer hohmann = ImpulsiveTransfer::Hohmann(LEO, GEO, &Earth);
+
+  // no plane change
+  ImpulsiveTransfer flat = ImpulsiveTransfer::PlaneChange(LEO, GEO, 0.0,
+                                                          &Earth);
+  EXPECT_NEAR(hohmann.dv_, flat.dv_, 1e-9);
+  EXPECT_DOUBLE_EQ(hohmann.tof_, flat.tof_);
+
+  // the 28.5 degrees of Cape Canaveral, mostly done at the apoapsis
+  const double di = 28.5 * Pi / 180.0;
+  ImpulsiveTransfer foo = ImpulsiveTransfer::PlaneChange(LEO, GEO, di,
+                                                         &Earth);
+  EXPECT_GT(foo.split_, 0.0);
+  EXPECT_LT(foo.split_, 0.5);
+  EXPECT_NEAR(4.24e3, foo.dv_, 20.0);
+
+  // not worse than any other split
+  for (int i = 0; i <= 100; i++) {
+    const double s = 0.01 * i;
+    const double v1 = std::sqrt(Earth.mu_ / LEO);
+    const double v2 = std::sqrt(Earth.mu_ / GEO);
+    const double a = 0.5 * (LEO + GEO);
+    const double vp = std::sqrt(Earth.mu_ * (2.0 / LEO - 1.0 / a));
+    const double va = std::sqrt(Earth.mu_ * (2.0 / GEO - 1.0 / a));
+    const double dv =
+        std::sqrt(v1 * v1 + vp * vp - 2.0 * v1 * vp * std::cos(s * di)) +
+        std::sqrt(va * va + v2 * v2 -
+                  2.0 * va * v2 * std::cos((1.0 - s) * di));
+    EXPECT_LE(foo.dv_, dv + 1e-6);
+  }
+}
+
+TEST(ImpulsiveTransferTest, TestSameOrbit) {
+  // a plane change alone is the one burn
+  const double di = 0.1;
+  ImpulsiveTransfer foo = ImpulsiveTransfer::PlaneChange(LEO, LEO, di,
+                                                         &Earth);
+  const double v = std::sqrt(Earth.mu_ / LEO);
+  EXPECT_NEAR(2.0 * v * std::sin(0.5 * di), foo.dv_, 1e-9);
+}
+
+TEST(ImpulsiveTransferTest, TestBatch) {
+  const std::size_t n = 23;
+  std::vector<double> r1(n), r2(n), rb(n), di(n);
+  for (std::size_t i = 0; i < n; i++) {
+    r1[i] = LEO + 1.0e5 * i;
+    r2[i] = GEO * (1.0 + 0.5 * i);
+    rb[i] = 2.0 * r2[i];
+    di[i] = 0.02 * i;
+  }
+
+  std::vector<double> dv(n), tof(n);
+  ImpulsiveTransfer::Hohmann(&Earth, r1.data(), r2.data(), dv.data(),
+                             tof.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ImpulsiveTransfer foo = ImpulsiveTransfer::Hohmann(r1[i], r2[i], &Earth);
+    EXPECT_NEAR(foo.dv_, dv[i], 1e-6);
+    EXPECT_NEAR(foo.tof_, tof[i], 1e-6);
+  }
+
+  ImpulsiveTransfer::BiElliptic(&Earth, r1.data(), r2.data(), rb.data(),
+                                dv.data(), tof.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ImpulsiveTransfer foo =
+        ImpulsiveTransfer::BiElliptic(r1[i], r2[i], rb[i], &Earth);
+    EXPECT_NEAR(foo.dv_, dv[i], 1e-6);
+    EXPECT_NEAR(foo.tof_, tof[i], 1e-6);
+  }
+
+  ImpulsiveTransfer::PlaneChange(&Earth, r1.data(), r2.data(), di.data(),
+                                 dv.data(), tof.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ImpulsiveTransfer foo =
+        ImpulsiveTransfer::PlaneChange(r1[i], r2[i], di[i], &Earth);
+    EXPECT_EQ(foo.dv_, dv[i]);
+    EXPECT_EQ(foo.tof_, tof[i]);
+  }
+}
@@ -0,0 +1,141 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Kepler.hpp"
+#include <cmath>         // for sin, sinh, tan, abs, remainder, M_PI
+#include <cstddef>       // for size_t
+#include <gtest/gtest.h> // for Message, TestPartResult, TestP...
+#include <vector>        // for vector
+
+namespace {
+
+const double Deg = M_PI / 180.0;
+
+// the angles are compared on the circle
+double AngleError(double expected, double actual) {
+  return std::abs(std::remainder(expected - actual, 2.0 * M_PI));
+}
+
+} // namespace
+
+TEST(KeplerTest, TestKnownValue) {
+  // Vallado, Fundamentals of Astrodynamics and Applications, example 2-1
+  EXPECT_NEAR(220.512074767522 * Deg, EccentricAnomaly(235.4 * Deg, 0.4),
+              1e-13);
+}
+
+TEST(KeplerTest, TestCircular) {
+  for (double M = -7.0; M < 7.0; M += 0.1) {
+    EXPECT_DOUBLE_EQ(M, EccentricAnomaly(M, 0.0));
+    EXPECT_LT(AngleError(M, TrueAnomaly(M, 0.0)), 1e-15);
+  }
+}
+
+TEST(KeplerTest, TestElliptic) {
+  for (double e : {0.0, 0.01, 0.3, 0.7, 0.9, 0.99, 0.999, 0.9999}) {
+    for (double M = -10.0; M < 10.0; M += 0.0137) {
+      const double E = EccentricAnomaly(M, e);
+      EXPECT_NEAR(M, E - e * std::sin(E), 4e-15 * (1.0 + std::abs(M)))
+          << "e = " << e;
+    }
+  }
+}
+
+TEST(KeplerTest, TestNearPeriapsis) {
+  // the very eccentric orbit, just past periapsis
+  for (double e : {0.99, 0.999, 0.9999}) {
+    for (double M = 1e-12; M < 1e-2; M *= 1.7) {
+      const double E = EccentricAnomaly(M, e);
+      // the residual is evaluated with the rounding of the terms, ~E
+      EXPECT_NEAR(M, E - e * std::sin(E), 4e-16 * E) << "e = " << e;
+      EXPECT_GE(E, M);
+    }
+  }
+}
+
+TEST(KeplerTest, TestHyperbolic) {
+  for (double e : {1.0001, 1.01, 1.5, 3.0, 10.0}) {
+    for (double m = 1e-6; m < 1e4; m *= 1.3) {
+      for (double M : {-m, m}) {
+        const double H = HyperbolicAnomaly(M, e);
+        EXPECT_NEAR(M, e * std::sinh(H) - H, 1e-14 * (1.0 + std::abs(M)))
+            << "e = " << e;
+      }
+    }
+  }
+}
+
+TEST(KeplerTest, TestParabolic) {
+  for (double m = 1e-6; m < 1e3; m *= 1.3) {
+    for (double M : {-m, m}) {
+      const double D = std::tan(0.5 * TrueAnomaly(M, 1.0));
+      EXPECT_NEAR(M, D + D * D * D / 3.0, 1e-14 * (1.0 + std::abs(M)));
+    }
+  }
+
+  // no cancellation for the small ones
+  EXPECT_NEAR(1e-12, 2.0 * std::tan(0.5 * TrueAnomaly(0.5e-12, 1.0)), 1e-27);
+}
+
+TEST(KeplerTest, TestRoundTrip) {
+  for (double e : {0.0, 0.1, 0.5, 0.9, 1.0, 1.2, 2.0, 5.0}) {
+    // the true anomalies, within the asymptotes of the hyperbola
+    const double limit = e > 1.0 ? std::acos(-1.0 / e) - 0.01 : M_PI;
+    for (double nu = -limit; nu < limit; nu += 0.01) {
+      const double M = MeanAnomaly(nu, e);
+      EXPECT_LT(AngleError(nu, TrueAnomaly(M, e)), 1e-11) << "e = " << e;
+    }
+  }
+}
+
+TEST(KeplerTest, TestRange) {
+  for (double M = -20.0; M < 20.0; M += 0.1) {
+    const double nu = TrueAnomaly(M, 0.5);
+    EXPECT_GE(nu, 0.0);
+    EXPECT_LT(nu, 2.0 * M_PI);
+
+    const double M0 = MeanAnomaly(nu, 0.5);
+    EXPECT_GE(M0, 0.0);
+    EXPECT_LT(M0, 2.0 * M_PI);
+  }
+}
+
+TEST(KeplerTest, TestBatch) {
+  // several full vectors and a tail
+  std::vector<double> M, e;
+  for (double ecc : {0.0, 0.2, 0.6, 0.95, 0.9999}) {
+    for (double m = -50.0; m < 50.0; m += 0.77) {
+      M.push_back(m);
+      e.push_back(ecc);
+    }
+  }
+  M.push_back(1e-9);
+  e.push_back(0.999);
+  const std::size_t n = M.size();
+
+  std::vector<double> E(n), nu(n);
+  EccentricAnomaly(M.data(), e.data(), E.data(), n);
+  TrueAnomaly(M.data(), e.data(), nu.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    EXPECT_NEAR(EccentricAnomaly(M[i], e[i]), E[i], 1e-13) << i;
+    EXPECT_LT(AngleError(TrueAnomaly(M[i], e[i]), nu[i]), 1e-12) << i;
+    EXPECT_GE(nu[i], 0.0);
+    EXPECT_LT(nu[i], 2.0 * M_PI);
+  }
+}
@@ -0,0 +1,158 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Lambert.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "TwoBodyPropagator.hpp"                 // for TwoBodyPropagator
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt, cos, sin, M_PI
+#include <cstddef>                               // for size_t
+#include <gtest/gtest.h>                         // for Message, TestPa...
+
+namespace {
+
+Vec3 OnCircle(double R, double angle) {
+  return Vec3(R * std::cos(angle), R * std::sin(angle), 0.0);
+}
+
+// the transfer from r1 with v1 reaches r2 with v2 after tof
+void ExpectTransfer(Vec3 r1, Vec3 v1, Vec3 r2, Vec3 v2, double tof) {
+  TwoBodyPropagator propagator(&Earth);
+  Vec3 r, v;
+  propagator.Propagate(r1, v1, tof, &r, &v);
+  EXPECT_NEAR(0.0, (r - r2).norm(), 1e-7 * r2.norm()) << r << " vs " << r2;
+  EXPECT_NEAR(0.0, (v - v2).norm(), 1e-7 * v2.norm()) << v << " vs " << v2;
+}
+
+} // namespace
+
+TEST(LambertTest, TestCircular) {
+  // an arc of the circular orbit
+  const double R = 7e6;
+  const double V = std::sqrt(Earth.mu_ / R);
+  const double angle = 1.2;
+
+  Vec3 v1[2], v2[2];
+  ASSERT_EQ(1U, Lambert(&Earth).Solve(OnCircle(R, 0.0), OnCircle(R, angle),
+                                      angle * R / V, 0, false, v1, v2));
+  EXPECT_NEAR(0.0, (v1[0] - Vec3(0.0, V, 0.0)).norm(), 1e-8 * V);
+  EXPECT_NEAR(0.0, (v2[0] - OnCircle(V, angle + M_PI / 2.0)).norm(),
+              1e-8 * V);
+}
+
+TEST(LambertTest, TestShortWay) {
+  const Vec3 r1(7e6, 1e6, 2e5);
+  const Vec3 r2(-2e6, 9e6, -1e6);
+  const Lambert lambert(&Earth);
+
+  for (double tof : {600.0, 1800.0, 3600.0, 20000.0}) {
+    Vec3 v1[2], v2[2];
+    ASSERT_EQ(1U, lambert.Solve(r1, r2, tof, 0, false, v1, v2)) << tof;
+    ExpectTransfer(r1, v1[0], r2, v2[0], tof);
+    EXPECT_GT(r1.cross(v1[0]).z_, 0.0);
+  }
+}
+
+TEST(LambertTest, TestLongWay) {
+  // 250 degrees, prograde
+  const Vec3 r1 = OnCircle(7e6, 0.0);
+  const Vec3 r2 = OnCircle(8e6, 250.0 * M_PI / 180.0) + Vec3(0, 0, 5e5);
+  const Lambert lambert(&Earth);
+
+  for (double tof : {2000.0, 5000.0, 40000.0}) {
+    Vec3 v1[2], v2[2];
+    ASSERT_EQ(1U, lambert.Solve(r1, r2, tof, 0, false, v1, v2)) << tof;
+    ExpectTransfer(r1, v1[0], r2, v2[0], tof);
+    EXPECT_GT(r1.cross(v1[0]).z_, 0.0);
+  }
+}
+
+TEST(LambertTest, TestRetrograde) {
+  const Vec3 r1 = OnCircle(7e6, 0.0);
+  const Vec3 r2 = OnCircle(9e6, 1.0);
+  const double tof = 4000.0;
+
+  Vec3 v1[2], v2[2];
+  ASSERT_EQ(1U, Lambert(&Earth).Solve(r1, r2, tof, 0, true, v1, v2));
+  ExpectTransfer(r1, v1[0], r2, v2[0], tof);
+  EXPECT_LT(r1.cross(v1[0]).z_, 0.0);
+}
+
+TEST(LambertTest, TestMultipleRevolutions) {
+  const double R = 7e6;
+  const double T = 2.0 * M_PI * std::sqrt(R * R * R / Earth.mu_);
+  const Vec3 r1 = OnCircle(R, 0.0);
+  const Vec3 r2 = OnCircle(1.3 * R, 2.0);
+  const double tof = 5.5 * T;
+  const Lambert lambert(&Earth);
+
+  for (int revolutions = 1; revolutions <= 4; revolutions++) {
+    Vec3 v1[2], v2[2];
+    ASSERT_EQ(2U, lambert.Solve(r1, r2, tof, revolutions, false, v1, v2))
+        << revolutions;
+    for (std::size_t k = 0; k < 2; k++)
+      ExpectTransfer(r1, v1[k], r2, v2[k], tof);
+    EXPECT_FALSE(v1[0] == v1[1]);
+  }
+}
+
+TEST(LambertTest, TestMinimumTime) {
+  // the two branches meet at the minimum time of flight
+  const double R = 7e6;
+  const double V = std::sqrt(Earth.mu_ / R);
+  const double T = 2.0 * M_PI * R / V;
+  const Vec3 r1 = OnCircle(R, 0.0);
+  const Vec3 r2 = OnCircle(1.3 * R, 2.0);
+  const Lambert lambert(&Earth);
+
+  Vec3 v1[2], v2[2];
+  double lo = 0.5 * T;
+  double hi = 5.0 * T;
+  ASSERT_EQ(0U, lambert.Solve(r1, r2, lo, 1, false, v1, v2));
+  ASSERT_EQ(2U, lambert.Solve(r1, r2, hi, 1, false, v1, v2));
+  for (int i = 0; i < 60; i++) {
+    const double tof = 0.5 * (lo + hi);
+    (lambert.Solve(r1, r2, tof, 1, false, v1, v2) ? hi : lo) = tof;
+  }
+
+  const double tof = hi * (1.0 + 1e-6);
+  ASSERT_EQ(2U, lambert.Solve(r1, r2, tof, 1, false, v1, v2));
+  for (std::size_t k = 0; k < 2; k++)
+    ExpectTransfer(r1, v1[k], r2, v2[k], tof);
+  EXPECT_NEAR(0.0, (v1[0] - v1[1]).norm(), 1e-2 * V);
+}
+
+TEST(LambertTest, TestTooFewRevolutions) {
+  // no time for a whole revolution
+  const double R = 7e6;
+  const double T = 2.0 * M_PI * std::sqrt(R * R * R / Earth.mu_);
+
+  Vec3 v1[2], v2[2];
+  EXPECT_EQ(0U, Lambert(&Earth).Solve(OnCircle(R, 0.0), OnCircle(R, 2.0),
+                                      0.5 * T, 1, false, v1, v2));
+}
+
+TEST(LambertTest, TestCollinear) {
+  // the plane is undefined
+  Vec3 v1[2], v2[2];
+  EXPECT_EQ(0U, Lambert(&Earth).Solve(Vec3(7e6, 0, 0), Vec3(-8e6, 0, 0),
+                                      3000.0, 0, false, v1, v2));
+  EXPECT_EQ(0U, Lambert(&Earth).Solve(Vec3(7e6, 0, 0), Vec3(8e6, 0, 0),
+                                      3000.0, 0, false, v1, v2));
+}
@@ -0,0 +1,150 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Porkchop.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt, cos, sin, isnan
+#include <cstddef>                               // for size_t
+#include <cstdint>                               // for uint64_t
+#include <cstdio>                                // for fopen, fread, remove
+#include <cstdlib>                               // for mkstemp
+#include <cstring>                               // for memcmp
+#include <gtest/gtest.h>                         // for Message, TestPa...
+#include <string>                                // for string
+#include <unistd.h>                              // for close
+#include <vector>                                // for vector
+
+namespace {
+
+std::string TemporaryFile() {
+  char path[] = "/tmp/chrysaor-porkchop-XXXXXX";
+  const int fd = mkstemp(path);
+  close(fd);
+  return path;
+}
+
+// the states on the circular equatorial orbit
+struct Circle {
+  std::vector<double> t;
+  std::vector<Vec3> r;
+  std::vector<Vec3> v;
+
+  Circle(double R, double phase, double t0, double dt, std::size_t n) {
+    const double V = std::sqrt(Earth.mu_ / R);
+    for (std::size_t i = 0; i < n; i++) {
+      t.push_back(t0 + i * dt);
+      const double angle = phase + t.back() * V / R;
+      r.emplace_back(R * std::cos(angle), R * std::sin(angle), 0.0);
+      v.emplace_back(-V * std::sin(angle), V * std::cos(angle), 0.0);
+    }
+  }
+
+  PorkchopAxis Axis() const { return {t.data(), r.data(), v.data(), t.size()}; }
+};
+
+} // namespace
+
+TEST(PorkchopTest, TestEvaluate) {
+  // the transfer to the same orbit, later, is no transfer at all
+  const double R = 7e6;
+  const Circle circle(R, 0.0, 0.0, 700.0, 2);
+  double cell[Porkchop::Columns];
+  Porkchop(&Earth, 0).Evaluate(circle.r[0], circle.v[0], circle.r[1],
+                               circle.v[1], 700.0, cell);
+  EXPECT_NEAR(0.0, cell[Porkchop::DepartureExcess], 1e-6);
+  EXPECT_NEAR(0.0, cell[Porkchop::ArrivalExcess], 1e-6);
+  EXPECT_EQ(0.0, cell[Porkchop::Revolutions]);
+
+  Porkchop(&Earth, 0).Evaluate(circle.r[1], circle.v[1], circle.r[0],
+                               circle.v[0], -700.0, cell);
+  EXPECT_TRUE(std::isnan(cell[Porkchop::DepartureExcess]));
+  EXPECT_TRUE(std::isnan(cell[Porkchop::ArrivalExcess]));
+  EXPECT_TRUE(std::isnan(cell[Porkchop::Revolutions]));
+}
+
+TEST(PorkchopTest, TestWrite) {
+  // more cells than one block, so that it is streamed
+  const Circle departure(7e6, 0.0, 0.0, 60.0, 300);
+  const Circle arrival(12e6, 1.0, 3000.0, 90.0, 301);
+  const std::size_t cells = departure.t.size() * arrival.t.size();
+  ASSERT_GT(cells, Porkchop::BlockCells);
+
+  const Porkchop porkchop(&Earth, 1);
+  const std::string path = TemporaryFile();
+  ASSERT_TRUE(porkchop.Write(path, departure.Axis(), arrival.Axis()));
+
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  ASSERT_NE(nullptr, file);
+
+  char magic[8];
+  std::uint64_t sizes[7];
+  ASSERT_EQ(1U, std::fread(magic, sizeof(magic), 1, file));
+  ASSERT_EQ(7U, std::fread(sizes, sizeof(sizes[0]), 7, file));
+  EXPECT_EQ(0, std::memcmp(magic, "CHRYPRK1", 8));
+  EXPECT_EQ(departure.t.size(), sizes[0]);
+  EXPECT_EQ(arrival.t.size(), sizes[1]);
+  EXPECT_EQ(std::uint64_t(Porkchop::Columns), sizes[2]);
+
+  std::vector<double> t(departure.t.size() + arrival.t.size());
+  std::vector<double> columns(cells * Porkchop::Columns);
+  ASSERT_EQ(t.size(), std::fread(t.data(), sizeof(double), t.size(), file));
+  ASSERT_EQ(columns.size(), std::fread(columns.data(), sizeof(double),
+                                       columns.size(), file));
+  std::fclose(file);
+  std::remove(path.c_str());
+
+  EXPECT_EQ(departure.t.front(), t.front());
+  EXPECT_EQ(arrival.t.back(), t.back());
+
+  std::size_t transfers = 0;
+  for (std::size_t i = 0; i < departure.t.size(); i += 7) {
+    for (std::size_t j = 0; j < arrival.t.size(); j += 5) {
+      double cell[Porkchop::Columns];
+      porkchop.Evaluate(departure.r[i], departure.v[i], arrival.r[j],
+                        arrival.v[j], arrival.t[j] - departure.t[i], cell);
+
+      for (std::size_t c = 0; c < Porkchop::Columns; c++) {
+        const double value = columns[c * cells + i * arrival.t.size() + j];
+        if (std::isnan(cell[c]))
+          EXPECT_TRUE(std::isnan(value));
+        else
+          EXPECT_EQ(cell[c], value);
+      }
+      transfers += !std::isnan(cell[Porkchop::DepartureExcess]);
+    }
+  }
+  EXPECT_GT(transfers, 0U);
+}
+
+TEST(PorkchopTest, TestWriteUnwritable) {
+  const Circle departure(7e6, 0.0, 0.0, 60.0, 3);
+  const Circle arrival(12e6, 1.0, 3000.0, 90.0, 4);
+
+  const Porkchop porkchop(&Earth, 1);
+  EXPECT_FALSE(porkchop.Write("/nonexistent-chrysaor-directory/porkchop",
+                              departure.Axis(), arrival.Axis()));
+
+  // a full device fails on a write, not on the open
+  std::FILE *full = std::fopen("/dev/full", "wb");
+  if (full) {
+    std::fclose(full);
+    EXPECT_FALSE(porkchop.Write("/dev/full", departure.Axis(), arrival.Axis()));
+  }
+}
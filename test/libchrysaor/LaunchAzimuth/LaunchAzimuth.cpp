@@ -0,0 +1,167 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LaunchAzimuth.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "LaunchSite.hpp"    // for LaunchSite
+#include "SolarSystem.hpp"   // for Earth
+#include <cmath>             // for sin, cos, asin, atan2, sqrt, isfinite, M_PI
+#include <cstddef>           // for size_t
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <vector>            // for vector
+
+namespace {
+
+CelestialBody Earth = SolarSystem::Earth;
+
+const double DegToRad = M_PI / 180.0;
+
+} // namespace
+
+TEST(LaunchAzimuthTest, TestOrbitalSpeed) {
+  const LaunchAzimuth solver(&Earth, 200000.0);
+  EXPECT_NEAR(std::sqrt(Earth.mu_ / (Earth.R_ + 200000.0)),
+              solver.OrbitalSpeed(), 1e-9);
+}
+
+TEST(LaunchAzimuthTest, TestDueEast) {
+  const LaunchAzimuth solver(&Earth, 200000.0);
+
+  // the inclination of the latitude is reached by launching due east
+  const AzimuthSolution s = solver.Solve(28.5, 28.5);
+  EXPECT_NEAR(90.0, s.inertial, 1e-6);
+  EXPECT_NEAR(90.0, s.rotating, 1e-6);
+  EXPECT_NEAR(Earth.EquatorialSpeed(28.5), s.gain, 1e-6);
+  EXPECT_NEAR(solver.OrbitalSpeed() - s.gain, s.speed, 1e-9);
+
+  // the lower ones too, into the nearest plane
+  const AzimuthSolution e = solver.Solve(28.5, 10.0);
+  EXPECT_EQ(90.0, e.inertial);
+  EXPECT_EQ(90.0, e.rotating);
+
+  // the equatorial orbit, from the equator, gets all of it
+  const AzimuthSolution q = solver.Solve(0.0, 0.0);
+  EXPECT_NEAR(Earth.EquatorialSpeed(), q.gain, 1e-9);
+}
+
+TEST(LaunchAzimuthTest, TestInclined) {
+  const LaunchAzimuth solver(&Earth, 200000.0);
+  const double v = solver.OrbitalSpeed();
+
+  const double lat = 28.5;
+  const double incl = 51.6;
+  const AzimuthSolution s = solver.Solve(lat, incl);
+
+  const double beta =
+      std::asin(std::cos(incl * DegToRad) / std::cos(lat * DegToRad));
+  EXPECT_NEAR(beta / DegToRad, s.inertial, 1e-12);
+
+  // the rotation turns the launch further north
+  const double vrot = Earth.EquatorialSpeed(lat);
+  const double east = v * std::sin(beta) - vrot;
+  const double north = v * std::cos(beta);
+  EXPECT_NEAR(std::atan2(east, north) / DegToRad, s.rotating, 1e-12);
+  EXPECT_LT(s.rotating, s.inertial);
+  EXPECT_NEAR(std::sqrt(east * east + north * north), s.speed, 1e-9);
+  EXPECT_GT(s.gain, 0.0);
+  EXPECT_LT(s.gain, vrot);
+}
+
+TEST(LaunchAzimuthTest, TestPolarAndRetrograde) {
+  const LaunchAzimuth solver(&Earth, 200000.0);
+
+  // the polar orbit is due north inertially, slightly west of it on ground
+  const AzimuthSolution p = solver.Solve(45.0, 90.0);
+  EXPECT_NEAR(0.0, p.inertial, 1e-12);
+  EXPECT_NEAR(360.0 + std::atan2(-Earth.EquatorialSpeed(45.0),
+                                 solver.OrbitalSpeed()) /
+                          DegToRad,
+              p.rotating, 1e-12);
+  EXPECT_LT(p.gain, 0.0);
+
+  // the retrograde orbits are northwest
+  const AzimuthSolution r = solver.Solve(34.6, 98.0);
+  EXPECT_GT(r.inertial, 270.0);
+  EXPECT_LT(r.inertial, 360.0);
+  EXPECT_LT(r.rotating, r.inertial);
+  EXPECT_LT(r.gain, 0.0);
+}
+
+TEST(LaunchAzimuthTest, TestSite) {
+  CelestialBody kerbin(3.5316000e12, 600000.0, 21549.425);
+  const LaunchAzimuth solver(&kerbin, 80000.0);
+
+  const LaunchSite sea(&kerbin, 5.0, 0.0, 0);
+  const AzimuthSolution a = solver.Solve(sea, 30.0);
+  const AzimuthSolution b = solver.Solve(5.0, 30.0);
+  EXPECT_NEAR(b.inertial, a.inertial, 1e-12);
+  EXPECT_NEAR(b.rotating, a.rotating, 1e-12);
+  EXPECT_NEAR(b.gain, a.gain, 1e-9);
+
+  // the higher site moves faster
+  const LaunchSite mountain(&kerbin, 5.0, 0.0, 6000);
+  EXPECT_GT(solver.Solve(mountain, 30.0).gain, a.gain);
+}
+
+TEST(LaunchAzimuthTest, TestBatch) {
+  const LaunchAzimuth solver(&Earth, 400000.0);
+
+  std::vector<double> lat, incl;
+  for (double l = -89.0; l <= 89.0; l += 4.5) {
+    for (double i = 0.0; i <= 180.0; i += 7.5) {
+      lat.push_back(l);
+      incl.push_back(i);
+    }
+  }
+  // a tail for the scalar path
+  lat.push_back(12.0);
+  incl.push_back(33.0);
+
+  const std::size_t n = lat.size();
+  std::vector<double> inertial(n), rotating(n), gain(n);
+  solver.Solve(lat.data(), incl.data(), inertial.data(), rotating.data(),
+               gain.data(), n);
+
+  for (std::size_t k = 0; k < n; k++) {
+    const AzimuthSolution s = solver.Solve(lat[k], incl[k]);
+    EXPECT_NEAR(s.inertial, inertial[k], 1e-9) << lat[k] << " " << incl[k];
+    EXPECT_NEAR(s.rotating, rotating[k], 1e-9) << lat[k] << " " << incl[k];
+    EXPECT_NEAR(s.gain, gain[k], 1e-9) << lat[k] << " " << incl[k];
+  }
+}
+
+TEST(LaunchAzimuthTest, TestBatchPoles) {
+  const LaunchAzimuth solver(&Earth, 400000.0);
+
+  // whole vectors of the poles, polar and equatorial orbits
+  const double lat[8] = {90.0, -90.0, 90.0, -90.0, 90.0, -90.0, 90.0, -90.0};
+  const double incl[8] = {90.0, 90.0, 0.0, 180.0, 90.0, 90.0, 45.0, 135.0};
+
+  double inertial[8], rotating[8], gain[8];
+  solver.Solve(lat, incl, inertial, rotating, gain, 8);
+
+  for (std::size_t k = 0; k < 8; k++) {
+    const AzimuthSolution s = solver.Solve(lat[k], incl[k]);
+    ASSERT_TRUE(std::isfinite(inertial[k])) << lat[k] << " " << incl[k];
+    ASSERT_TRUE(std::isfinite(rotating[k])) << lat[k] << " " << incl[k];
+    ASSERT_TRUE(std::isfinite(gain[k])) << lat[k] << " " << incl[k];
+    EXPECT_NEAR(s.inertial, inertial[k], 1e-9) << lat[k] << " " << incl[k];
+    EXPECT_NEAR(s.rotating, rotating[k], 1e-9) << lat[k] << " " << incl[k];
+    EXPECT_NEAR(s.gain, gain[k], 1e-9) << lat[k] << " " << incl[k];
+  }
+}
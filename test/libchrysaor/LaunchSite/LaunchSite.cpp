@@ -18,6 +18,12 @@
 
 #include "LaunchSite.hpp"
 #include "CelestialBody.hpp"
+#include "Constants.hpp"
+#include "Ellipsoid.hpp"
+#include "RotatingFrame.hpp"
+#include "SolarSystem.hpp"
+#include "Vec3.hpp"
+#include <cmath>
 #include <cstddef>
 #include <gtest/gtest.h>
 
@@ -44,3 +50,51 @@ TEST(LaunchSiteTest, TestParentBody) {
   LaunchSite foo(&parentBody, 0.0, 0.0, 0.0);
   EXPECT_EQ(&parentBody, foo.Body());
 }
+
+TEST(LaunchSiteTest, TestPosition) {
+  CelestialBody kerbin(3.5316000e12, 600000.0, 21549.425);
+  LaunchSite ksc(&kerbin, -0.0972, -74.5577, 68);
+
+  const Vec3 r = ksc.Position();
+  EXPECT_NEAR(600068.0, r.norm(), 1e-8);
+  EXPECT_NEAR(-0.0972, std::asin(r.z_ / r.norm()) * 180.0 / M_PI, 1e-12);
+  EXPECT_NEAR(-74.5577, std::atan2(r.y_, r.x_) * 180.0 / M_PI, 1e-12);
+
+  const Vec3 v = ksc.RotationalVelocity();
+  EXPECT_EQ(0.0, v.z_);
+  EXPECT_NEAR(0.0, v.dot(r), 1e-6);
+  EXPECT_NEAR(kerbin.EquatorialSpeed(-0.0972) * 600068.0 / 600000.0,
+              v.norm(), 1e-9);
+}
+
+TEST(LaunchSiteTest, TestEllipsoid) {
+  CelestialBody earth = SolarSystem::Earth;
+  const Ellipsoid wgs(Constants::EarthEquatorialRadius,
+                      1.0 / Constants::EarthInverseFlattening);
+  LaunchSite canaveral(&earth, wgs, 28.5, -80.5, 3);
+
+  const Vec3 r = canaveral.Position();
+  double lat, lon, alt;
+  wgs.ToGeodetic(r, &lat, &lon, &alt);
+  EXPECT_NEAR(28.5, lat, 1e-9);
+  EXPECT_NEAR(-80.5, lon, 1e-9);
+  EXPECT_NEAR(3.0, alt, 1e-6);
+}
+
+TEST(LaunchSiteTest, TestInertial) {
+  CelestialBody kerbin(3.5316000e12, 600000.0, 21549.425);
+  LaunchSite ksc(&kerbin, 0.0, 0.0, 0);
+
+  RotatingFrame frame(&kerbin);
+  frame.SetEpoch(kerbin.Trot_ / 4.0);
+
+  const Vec3 r = ksc.InertialPosition(frame);
+  EXPECT_NEAR(0.0, r.x_, 1e-6);
+  EXPECT_NEAR(600000.0, r.y_, 1e-6);
+  EXPECT_NEAR(0.0, r.z_, 1e-6);
+
+  const Vec3 v = ksc.InertialVelocity(frame);
+  EXPECT_NEAR(-kerbin.EquatorialSpeed(), v.x_, 1e-9);
+  EXPECT_NEAR(0.0, v.y_, 1e-9);
+  EXPECT_NEAR(0.0, v.z_, 1e-9);
+}
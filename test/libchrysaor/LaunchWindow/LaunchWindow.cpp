@@ -0,0 +1,154 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LaunchWindow.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "LaunchSite.hpp"    // for LaunchSite
+#include "RotatingFrame.hpp" // for RotatingFrame
+#include "SolarSystem.hpp"   // for Earth
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for cos, sin, asin, sqrt, M_PI
+#include <cstddef>           // for size_t
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <vector>            // for vector
+
+namespace {
+
+CelestialBody Earth = SolarSystem::Earth;
+
+const double DegToRad = M_PI / 180.0;
+
+Vec3 Normal(const TargetPlane &plane) {
+  const double i = plane.inclination * DegToRad;
+  const double raan = plane.raan * DegToRad;
+  return Vec3(std::sin(i) * std::sin(raan), -std::sin(i) * std::cos(raan),
+              std::cos(i));
+}
+
+} // namespace
+
+TEST(LaunchWindowTest, TestCrossing) {
+  const LaunchSite site(&Earth, 28.5, -80.5, 0);
+  const TargetPlane plane{51.6, 120.0};
+  const LaunchWindowScanner scanner(&Earth, 60.0, 200000.0, 0.3);
+
+  const double day = Earth.Trot_;
+  const std::vector<LaunchWindow> windows =
+      scanner.Scan(site, plane, 0.0, 3.0 * day);
+
+  // once northeast, once southeast, every day
+  ASSERT_EQ(6U, windows.size());
+
+  const double phi = 28.5 * DegToRad;
+  const double beta =
+      std::asin(std::cos(51.6 * DegToRad) / std::cos(phi)) / DegToRad;
+
+  RotatingFrame frame(&Earth, 0.3);
+  for (std::size_t i = 0; i < windows.size(); i++) {
+    const LaunchWindow &w = windows[i];
+    EXPECT_EQ(0U, w.site);
+    EXPECT_EQ(0U, w.plane);
+    if (i > 0) {
+      EXPECT_LT(windows[i - 1].time, w.time);
+    }
+    if (i > 1) {
+      EXPECT_NEAR(day, w.time - windows[i - 2].time, 1e-3);
+    }
+
+    // the site is in the plane
+    frame.SetEpoch(w.time);
+    const Vec3 r = site.InertialPosition(frame);
+    EXPECT_NEAR(0.0, Normal(plane).dot(r) / r.norm(), 1e-9);
+
+    EXPECT_NEAR(0.0, w.planeChange, 1e-6);
+    EXPECT_NEAR(0.0, w.deltaV, 1e-3);
+
+    if (w.azimuth < 90.0) {
+      EXPECT_NEAR(beta, w.azimuth, 1e-6);
+    } else {
+      EXPECT_NEAR(180.0 - beta, w.azimuth, 1e-6);
+    }
+  }
+}
+
+TEST(LaunchWindowTest, TestClosestApproach) {
+  const LaunchSite site(&Earth, 45.0, 10.0, 0);
+  const TargetPlane plane{30.0, 0.0};
+  const double parking = 200000.0;
+  const LaunchWindowScanner scanner(&Earth, 120.0, parking);
+
+  const double day = Earth.Trot_;
+  const std::vector<LaunchWindow> windows =
+      scanner.Scan(site, plane, 0.0, 2.0 * day);
+
+  // the plane never reaches the site, only once a day it is the nearest
+  ASSERT_EQ(2U, windows.size());
+
+  const double v = std::sqrt(Earth.mu_ / (Earth.R_ + parking));
+  for (const LaunchWindow &w : windows) {
+    EXPECT_NEAR(15.0, w.planeChange, 1e-9);
+    EXPECT_NEAR(2.0 * v * std::sin(7.5 * DegToRad), w.deltaV, 1e-6);
+    EXPECT_NEAR(90.0, w.azimuth, 1e-6);
+  }
+  EXPECT_NEAR(day, windows[1].time - windows[0].time, 1e-3);
+}
+
+TEST(LaunchWindowTest, TestBatch) {
+  const LaunchSite sites[] = {
+      LaunchSite(&Earth, 28.5, -80.5, 0), LaunchSite(&Earth, 45.9, 63.3, 0),
+      LaunchSite(&Earth, 5.2, -52.8, 0)};
+  const TargetPlane planes[] = {{51.6, 120.0}, {98.0, 10.0}, {5.0, 0.0}};
+  const LaunchWindowScanner scanner(&Earth, 60.0, 200000.0);
+
+  const double t0 = 1000.0;
+  const double t1 = t0 + 5.0 * Earth.Trot_;
+  const std::vector<LaunchWindow> windows =
+      scanner.Scan(sites, 3, planes, 3, t0, t1);
+
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < 3; i++) {
+    for (std::size_t j = 0; j < 3; j++) {
+      const std::vector<LaunchWindow> ref =
+          scanner.Scan(sites[i], planes[j], t0, t1);
+      EXPECT_FALSE(ref.empty());
+
+      for (const LaunchWindow &w : ref) {
+        ASSERT_LT(k, windows.size());
+        EXPECT_EQ(i, windows[k].site);
+        EXPECT_EQ(j, windows[k].plane);
+        EXPECT_EQ(w.time, windows[k].time);
+        EXPECT_EQ(w.azimuth, windows[k].azimuth);
+        EXPECT_EQ(w.planeChange, windows[k].planeChange);
+        EXPECT_EQ(w.deltaV, windows[k].deltaV);
+        EXPECT_GE(w.time, t0);
+        EXPECT_LE(w.time, t1);
+        k++;
+      }
+    }
+  }
+  EXPECT_EQ(k, windows.size());
+}
+
+TEST(LaunchWindowTest, TestEquatorial) {
+  const LaunchSite site(&Earth, 28.5, -80.5, 0);
+  const TargetPlane plane{0.0, 0.0};
+  const LaunchWindowScanner scanner(&Earth, 60.0, 200000.0);
+
+  // every moment is the same, there is no distinct window
+  EXPECT_TRUE(scanner.Scan(site, plane, 0.0, 2.0 * Earth.Trot_).empty());
+}
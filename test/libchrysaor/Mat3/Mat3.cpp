@@ -0,0 +1,111 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Mat3.hpp"      // for Mat3, BasicMat3, operator<<
+#include "Vec3.hpp"      // for Vec3
+#include <cmath>         // for M_PI
+#include <gtest/gtest.h> // for ASSERT_EQ, ASSERT_NEAR, TEST
+#include <sstream>       // for ostringstream
+#include <string>        // for string
+#include <vector>        // for vector
+
+TEST(Mat3Test, TestConstructor) {
+  ASSERT_NO_THROW({ Mat3 foo; });
+  ASSERT_NO_THROW({ Mat3 foo(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0); });
+  ASSERT_NO_THROW({
+    Mat3 foo(Vec3(1.0, 2.0, 3.0), Vec3(4.0, 5.0, 6.0), Vec3(7.0, 8.0, 9.0));
+  });
+}
+
+TEST(Mat3Test, TestComparison) {
+  const Mat3 foo(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0);
+  const Mat3 bar(Vec3(1.0, 2.0, 3.0), Vec3(4.0, 5.0, 6.0),
+                 Vec3(7.0, 8.0, 9.0));
+
+  ASSERT_EQ(foo, bar);
+  ASSERT_EQ(6.0, foo.m_[1][2]);
+  ASSERT_EQ(Mat3(0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0), Mat3());
+}
+
+TEST(Mat3Test, TestProducts) {
+  constexpr Mat3 foo(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0);
+  constexpr Mat3 id = Mat3::Identity();
+
+  static_assert(foo * Vec3(1.0, 0.0, -1.0) == Vec3(-2.0, -2.0, -2.0), "");
+  static_assert(id * foo == foo, "");
+  static_assert(foo * id == foo, "");
+
+  ASSERT_EQ(Mat3(30.0, 36.0, 42.0, 66.0, 81.0, 96.0, 102.0, 126.0, 150.0),
+            foo * foo);
+  ASSERT_EQ(Mat3(1.0, 4.0, 7.0, 2.0, 5.0, 8.0, 3.0, 6.0, 9.0),
+            foo.transpose());
+  ASSERT_EQ(0.0, foo.determinant());
+  ASSERT_EQ(1.0, id.determinant());
+}
+
+TEST(Mat3Test, TestRotationZ) {
+  const Mat3 rot = Mat3::RotationZ(M_PI / 2.0);
+
+  const Vec3 v = rot * Vec3(1.0, 0.0, 5.0);
+  ASSERT_NEAR(0.0, v.x_, 1.0e-15);
+  ASSERT_NEAR(1.0, v.y_, 1.0e-15);
+  ASSERT_EQ(5.0, v.z_);
+
+  ASSERT_NEAR(1.0, rot.determinant(), 1.0e-15);
+
+  const Mat3 back = rot.transpose() * rot;
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      ASSERT_NEAR(Mat3::Identity().m_[i][j], back.m_[i][j], 1.0e-15);
+    }
+  }
+}
+
+TEST(Mat3Test, TestBatchedApply) {
+  const Mat3 foo(0.5, -2.0, 3.0, 4.0, 0.25, -6.0, 7.0, 8.0, 1.0);
+
+  const std::size_t n = 37;
+  std::vector<double> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = static_cast<double>(i);
+    y[i] = 1.0 - static_cast<double>(i) / 3.0;
+    z[i] = static_cast<double>(i * i) / 7.0;
+  }
+
+  foo.apply(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 ref = foo * Vec3(x[i], y[i], z[i]);
+    ASSERT_EQ(ref, Vec3(ox[i], oy[i], oz[i]));
+  }
+
+  // in-place
+  foo.apply(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), n);
+  for (std::size_t i = 0; i < n; i++) {
+    ASSERT_EQ(Vec3(ox[i], oy[i], oz[i]), Vec3(x[i], y[i], z[i]));
+  }
+}
+
+TEST(Mat3Test, TestPrint) {
+  const Mat3 foo(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.5);
+
+  std::ostringstream output;
+  output << foo;
+
+  ASSERT_EQ(std::string("((1; 2; 3); (4; 5; 6); (7; 8; 9.5))"), output.str());
+}
@@ -0,0 +1,189 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NumericalPropagator.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "Constants.hpp"                         // for EarthJ2
+#include "Gravity/ZonalGravity.hpp"              // for ZonalGravity
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "TwoBodyPropagator.hpp"                 // for TwoBodyPropagator
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt
+#include <cstddef>                               // for size_t
+#include <gtest/gtest.h>                         // for Message, TestPa...
+#include <vector>                                // for vector
+
+namespace {
+
+const Vec3 Position(7.0e6, 1.0e6, -5.0e5);
+const Vec3 Velocity(-1.0e3, 7.2e3, 1.5e3);
+
+// the central differences of the propagation, column by column
+void FiniteDifferences(NumericalPropagator *propagator, Vec3 r, Vec3 v,
+                       double dt, double *stm) {
+  for (int j = 0; j < 6; j++) {
+    const double h = j < 3 ? 1e-6 * r.norm() : 1e-6 * v.norm();
+    Vec3 rs[2], vs[2];
+    for (int s = 0; s < 2; s++) {
+      const double x = s == 0 ? -h : h;
+      const Vec3 d(j % 3 == 0 ? x : 0.0, j % 3 == 1 ? x : 0.0,
+                   j % 3 == 2 ? x : 0.0);
+      if (j < 3)
+        propagator->Propagate(r + d, v, dt, &rs[s], &vs[s]);
+      else
+        propagator->Propagate(r, v + d, dt, &rs[s], &vs[s]);
+    }
+    const Vec3 dr = (rs[1] - rs[0]) * (0.5 / h);
+    const Vec3 dv = (vs[1] - vs[0]) * (0.5 / h);
+    stm[0 * 6 + j] = dr.x_;
+    stm[1 * 6 + j] = dr.y_;
+    stm[2 * 6 + j] = dr.z_;
+    stm[3 * 6 + j] = dv.x_;
+    stm[4 * 6 + j] = dv.y_;
+    stm[5 * 6 + j] = dv.z_;
+  }
+}
+
+// each 3x3 block, relative to its norm
+void ExpectNear(const double *expected, const double *actual,
+                double tolerance) {
+  for (int b = 0; b < 4; b++) {
+    const int offset = (b / 2) * 18 + (b % 2) * 3;
+    double norm = 0.0, error = 0.0;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        const int k = offset + 6 * i + j;
+        norm += expected[k] * expected[k];
+        error += (expected[k] - actual[k]) * (expected[k] - actual[k]);
+      }
+    }
+    EXPECT_LE(std::sqrt(error), tolerance * std::sqrt(norm)) << "block " << b;
+  }
+}
+
+} // namespace
+
+TEST(NumericalPropagatorTest, TestConstructor) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  ASSERT_NO_THROW({ NumericalPropagator foo(&gravity, 10.0); });
+
+  NumericalPropagator foo(&gravity, 10.0);
+  EXPECT_EQ(10.0, foo.Step());
+}
+
+TEST(NumericalPropagatorTest, TestIdentity) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  NumericalPropagator foo(&gravity, 10.0);
+
+  Vec3 r, v;
+  double stm[36];
+  foo.Propagate(Position, Velocity, 0.0, &r, &v, stm);
+  EXPECT_EQ(Position, r);
+  EXPECT_EQ(Velocity, v);
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      EXPECT_EQ(i == j ? 1.0 : 0.0, stm[6 * i + j]);
+}
+
+TEST(NumericalPropagatorTest, TestTwoBody) {
+  // without the zonal terms, it is the Kepler's problem
+  const ZonalGravity gravity(&Earth, 0.0);
+  NumericalPropagator foo(&gravity, 5.0);
+  TwoBodyPropagator bar(&Earth);
+
+  const double dt = 6000.0;
+  Vec3 r1, v1, r2, v2;
+  double stm[36], expected[36];
+  foo.Propagate(Position, Velocity, dt, &r1, &v1, stm);
+  bar.Propagate(Position, Velocity, dt, &r2, &v2, expected);
+
+  EXPECT_NEAR(0.0, (r1 - r2).norm(), 1e-2);
+  EXPECT_NEAR(0.0, (v1 - v2).norm(), 1e-5);
+  ExpectNear(expected, stm, 1e-7);
+
+  // the same without the matrix
+  Vec3 r3, v3;
+  foo.Propagate(Position, Velocity, dt, &r3, &v3);
+  EXPECT_EQ(r1, r3);
+  EXPECT_EQ(v1, v3);
+}
+
+TEST(NumericalPropagatorTest, TestBackwards) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  NumericalPropagator foo(&gravity, 5.0);
+
+  Vec3 r1, v1, r2, v2;
+  foo.Propagate(Position, Velocity, 3000.0, &r1, &v1);
+  foo.Propagate(r1, v1, -3000.0, &r2, &v2);
+  EXPECT_NEAR(0.0, (Position - r2).norm(), 1e-3);
+  EXPECT_NEAR(0.0, (Velocity - v2).norm(), 1e-6);
+}
+
+TEST(NumericalPropagatorTest, TestZonal) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2, -2.53265649e-06,
+                             -1.61962159e-06);
+  NumericalPropagator foo(&gravity, 10.0);
+
+  const double dt = 8000.0;
+  Vec3 r, v;
+  double stm[36], expected[36];
+  foo.Propagate(Position, Velocity, dt, &r, &v, stm);
+  FiniteDifferences(&foo, Position, Velocity, dt, expected);
+  ExpectNear(expected, stm, 1e-6);
+
+  // J2 does change it, from the Kepler's problem
+  TwoBodyPropagator bar(&Earth);
+  Vec3 r2, v2;
+  bar.Propagate(Position, Velocity, dt, &r2, &v2);
+  EXPECT_GT((r - r2).norm(), 1e3);
+}
+
+TEST(NumericalPropagatorTest, TestBatch) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  const NumericalPropagator foo(&gravity, 10.0);
+
+  // the arrays further apart than the states
+  const std::size_t n = 9, stride = 12;
+  std::vector<double> state(6 * stride);
+  std::vector<double> scratch(NumericalPropagator::BatchScratch * n);
+  for (std::size_t i = 0; i < n; i++) {
+    const double s = 1.0 + 0.05 * i;
+    state[0 * stride + i] = Position.x_ * s;
+    state[1 * stride + i] = Position.y_;
+    state[2 * stride + i] = Position.z_;
+    state[3 * stride + i] = Velocity.x_;
+    state[4 * stride + i] = Velocity.y_ / std::sqrt(s);
+    state[5 * stride + i] = Velocity.z_;
+  }
+  foo.Propagate(state.data(), stride, n, 4000.0, scratch.data());
+
+  NumericalPropagator bar(&gravity, 10.0);
+  for (std::size_t i = 0; i < n; i++) {
+    const double s = 1.0 + 0.05 * i;
+    Vec3 r, v;
+    bar.Propagate(Vec3(Position.x_ * s, Position.y_, Position.z_),
+                  Vec3(Velocity.x_, Velocity.y_ / std::sqrt(s), Velocity.z_),
+                  4000.0, &r, &v);
+    EXPECT_NEAR(r.x_, state[0 * stride + i], 1e-6);
+    EXPECT_NEAR(r.y_, state[1 * stride + i], 1e-6);
+    EXPECT_NEAR(r.z_, state[2 * stride + i], 1e-6);
+    EXPECT_NEAR(v.x_, state[3 * stride + i], 1e-9);
+    EXPECT_NEAR(v.y_, state[4 * stride + i], 1e-9);
+    EXPECT_NEAR(v.z_, state[5 * stride + i], 1e-9);
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Orbit.hpp"                               // for Orbit
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/EllipticalOrbitData.hpp" // for EllipticalOrbit...
+#include "Vec3.hpp"                                // for Vec3
+#include <gtest/gtest.h>                           // for CmpHelperFloati...
+
+class OrbitTest : public ::testing::TestWithParam<EllipticalOrbitData> {};
+
+INSTANTIATE_TEST_CASE_P(Kerbin, OrbitTest,
+                        testing::ValuesIn(KerbinEllipticalOrbitData));
+
+INSTANTIATE_TEST_CASE_P(Earth, OrbitTest,
+                        testing::ValuesIn(EarthEllipticalOrbitData));
+
+TEST_P(OrbitTest, Elements) {
+  auto as = GetParam();
+
+  Orbit foo(as.velocity, 0.0, as.altitude, as.body);
+
+  EXPECT_NEAR(as.sma, foo.Sma(), 1e-9 * as.sma);
+  EXPECT_NEAR(as.ecc, foo.Ecc(), 1.0e-07);
+  EXPECT_NEAR(as.epsilon, foo.Epsilon(), -1e-9 * as.epsilon);
+  EXPECT_NEAR(as.srh, foo.Srh(), 1e-9 * as.srh);
+}
+
+TEST_P(OrbitTest, Apsides) {
+  auto as = GetParam();
+
+  Orbit foo(as.velocity, 0.0, as.altitude, as.body);
+
+  EXPECT_NEAR(as.altitude, foo.Pe().Altitude(), 1e-6 * as.sma);
+  EXPECT_NEAR(as.apoapsis, foo.Ap().Altitude(), 1e-6 * as.sma);
+}
+
+TEST_P(OrbitTest, StateVector) {
+  auto as = GetParam();
+
+  // the same orbit, in the equatorial plane, anywhere on the periapsis line
+  const double r = as.body->R_ + as.altitude;
+  Orbit foo(Vec3(0.0, 0.0, r), Vec3(as.velocity, 0.0, 0.0), as.body);
+  Orbit bar(as.velocity, 0.0, as.altitude, as.body);
+
+  EXPECT_DOUBLE_EQ(bar.Sma(), foo.Sma());
+  EXPECT_NEAR(bar.Ecc(), foo.Ecc(), 1e-15);
+  EXPECT_DOUBLE_EQ(bar.Epsilon(), foo.Epsilon());
+  EXPECT_DOUBLE_EQ(bar.Srh(), foo.Srh());
+}
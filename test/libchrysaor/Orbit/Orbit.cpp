@@ -0,0 +1,117 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Orbit.hpp"                                 // for Orbit
+#include "CelestialBody.hpp"                         // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp"     // for Kerbin, Earth
+#include "OrbitalElements/OrbitalEccentricity.hpp"   // for OrbitalEccentri...
+#include "OrbitalElements/SemiMajorAxis.hpp"         // for SemiMajorAxis
+#include "OrbitalElements/SpecificOrbitalEnergy.hpp" // for SpecificOrbital...
+#include "SpecificRelativeAngularMomentum.hpp"       // for SpecificRelativ...
+#include "Vec3.hpp"                                  // for Vec3
+#include <cmath>                                     // for sqrt, isinf
+#include <gtest/gtest.h>                             // for Message, TestPa...
+
+TEST(OrbitTest, TestConstructor) {
+  ASSERT_NO_THROW({ Orbit foo(2300.0, 0.0, 70000.0, &Kerbin); });
+  ASSERT_NO_THROW({
+    Orbit foo(Vec3(7.0e6, 0.0, 0.0), Vec3(0.0, 7.5e3, 0.0), &Earth);
+  });
+}
+
+TEST(OrbitTest, TestGetter) {
+  Orbit foo(2300.0, 100.0, 70000.0, &Kerbin);
+
+  EXPECT_EQ(&Kerbin, foo.ParentBody());
+  EXPECT_EQ(670000.0, foo.Radius());
+  EXPECT_DOUBLE_EQ(std::sqrt(2300.0 * 2300.0 + 100.0 * 100.0), foo.Speed());
+}
+
+TEST(OrbitTest, TestElementClasses) {
+  // the same values as the element classes, with the vertical velocity
+  const double Vx = 2300.0, Vy = 100.0, altitude = 70000.0;
+  Orbit foo(Vx, Vy, altitude, &Kerbin);
+
+  EXPECT_DOUBLE_EQ(SemiMajorAxis(Vx, Vy, altitude, &Kerbin), foo.Sma());
+  EXPECT_DOUBLE_EQ(SpecificOrbitalEnergy(Vx, Vy, altitude, &Kerbin),
+                   foo.Epsilon());
+  EXPECT_DOUBLE_EQ(SpecificRelativeAngularMomentum(Vx, altitude, &Kerbin),
+                   foo.Srh());
+  EXPECT_NEAR(OrbitalEccentricity(Vx, Vy, altitude, &Kerbin), foo.Ecc(),
+              1e-7);
+}
+
+TEST(OrbitTest, TestMemoized) {
+  // the repeated and the out-of-order queries give the same values
+  Orbit foo(2300.0, 100.0, 70000.0, &Kerbin);
+  Orbit bar(2300.0, 100.0, 70000.0, &Kerbin);
+
+  const double ap = foo.Ap();
+  EXPECT_EQ(ap, static_cast<double>(foo.Ap()));
+  EXPECT_EQ(static_cast<double>(bar.Sma()), static_cast<double>(foo.Sma()));
+  EXPECT_EQ(static_cast<double>(bar.Ecc()), static_cast<double>(foo.Ecc()));
+  EXPECT_EQ(ap, static_cast<double>(bar.Ap()));
+  EXPECT_EQ(static_cast<double>(foo.Pe()), static_cast<double>(bar.Pe()));
+}
+
+TEST(OrbitTest, TestCircular) {
+  // a circular orbit keeps the eccentricity tiny, not a rounding residue of
+  // nearly equal squares
+  const double r = 7.0e6;
+  Orbit foo(std::sqrt(Earth.mu_ / r), 0.0, r - Earth.R_, &Earth);
+
+  EXPECT_NEAR(r, foo.Sma(), 1e-6);
+  EXPECT_LT(foo.Ecc(), 1e-15);
+  EXPECT_NEAR(r, foo.Ap(), 1e-6);
+  EXPECT_NEAR(r, foo.Pe(), 1e-6);
+}
+
+TEST(OrbitTest, TestInclined) {
+  // the plane does not matter
+  const double r = 7.0e6;
+  const double v = 8.0e3;
+  Orbit foo(Vec3(r, 0.0, 0.0), Vec3(0.0, 0.6 * v, 0.8 * v), &Earth);
+  Orbit bar(v, 0.0, r - Earth.R_, &Earth);
+
+  EXPECT_DOUBLE_EQ(bar.Sma(), foo.Sma());
+  EXPECT_DOUBLE_EQ(bar.Ecc(), foo.Ecc());
+  EXPECT_DOUBLE_EQ(bar.Srh(), foo.Srh());
+}
+
+TEST(OrbitTest, TestHyperbolic) {
+  // horizontal, so this is the periapsis
+  const double Vx = 12000.0, altitude = 300000.0;
+  Orbit foo(Vx, 0.0, altitude, &Earth);
+
+  EXPECT_GT(foo.Ecc(), 1.0);
+  EXPECT_LT(foo.Sma(), 0.0);
+  EXPECT_GT(foo.Epsilon(), 0.0);
+  EXPECT_DOUBLE_EQ(altitude, foo.Pe().Altitude());
+  EXPECT_TRUE(std::isinf(foo.Ap().Radius()));
+}
+
+TEST(OrbitTest, TestParabolic) {
+  const double altitude = 300000.0;
+  const double r = altitude + Earth.R_;
+  Orbit foo(std::sqrt(2.0 * Earth.mu_ / r), 0.0, altitude, &Earth);
+
+  EXPECT_DOUBLE_EQ(1.0, foo.Ecc());
+  EXPECT_DOUBLE_EQ(r, foo.Pe());
+  // e is 1 to within the rounding, so the apoapsis is at or near infinity
+  EXPECT_GT(foo.Ap(), 1e12 * r);
+}
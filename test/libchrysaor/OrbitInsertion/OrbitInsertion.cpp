@@ -0,0 +1,100 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitInsertion.hpp"
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "Orbit.hpp"                               // for Orbit
+#include "OrbitalElements/CelestialBodyData.hpp"   // for Kerbin, Earth
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentri...
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include <cmath>                                   // for sqrt, atan2
+#include <cstddef>                                 // for size_t
+#include <gtest/gtest.h>                           // for Message, TestPa...
+#include <vector>                                  // for vector
+
+TEST(OrbitInsertionTest, TestConstructor) {
+  ASSERT_NO_THROW({ OrbitInsertion foo; });
+  ASSERT_NO_THROW({ OrbitInsertion foo(70000.0, 80000.0, 70000.0, &Kerbin); });
+}
+
+TEST(OrbitInsertionTest, TestCircular) {
+  const double altitude = 200000.0;
+  OrbitInsertion foo(altitude, altitude, altitude, &Earth);
+
+  EXPECT_DOUBLE_EQ(std::sqrt(Earth.mu_ / (altitude + Earth.R_)), foo.Vx_);
+  EXPECT_EQ(0.0, foo.Vy_);
+  EXPECT_EQ(0.0, foo.gamma_);
+}
+
+TEST(OrbitInsertionTest, TestAtApsis) {
+  // horizontal at either apsis
+  const double ApA = 2.0e6, PeA = 180000.0;
+
+  OrbitInsertion pe(PeA, ApA, PeA, &Earth);
+  EXPECT_EQ(0.0, pe.Vy_);
+  OrbitInsertion ap(ApA, ApA, PeA, &Earth);
+  EXPECT_EQ(0.0, ap.Vy_);
+
+  // the vis-viva speeds
+  const double ra = ApA + Earth.R_, rp = PeA + Earth.R_;
+  const double a = 0.5 * (ra + rp);
+  EXPECT_DOUBLE_EQ(std::sqrt(Earth.mu_ * (2.0 / rp - 1.0 / a)), pe.Vx_);
+  EXPECT_DOUBLE_EQ(std::sqrt(Earth.mu_ * (2.0 / ra - 1.0 / a)), ap.Vx_);
+}
+
+TEST(OrbitInsertionTest, TestRoundTrip) {
+  // the burnout state is on the target orbit
+  const double ApA = 35786000.0, PeA = 185000.0;
+  for (double altitude = PeA; altitude < ApA; altitude += 1.0e6) {
+    OrbitInsertion foo(altitude, ApA, PeA, &Earth);
+    EXPECT_DOUBLE_EQ(std::atan2(foo.Vy_, foo.Vx_), foo.gamma_);
+    EXPECT_GE(foo.Vy_, 0.0);
+
+    Orbit orbit(foo.Vx_, foo.Vy_, altitude, &Earth);
+    EXPECT_NEAR(ApA, orbit.Ap().Altitude(), 1e-6) << altitude;
+    EXPECT_NEAR(PeA, orbit.Pe().Altitude(), 1e-6) << altitude;
+
+    EXPECT_NEAR(SemiMajorAxis(ApA, PeA, &Earth),
+                SemiMajorAxis(foo.Vx_, foo.Vy_, altitude, &Earth), 1e-6);
+    EXPECT_NEAR(OrbitalEccentricity(ApA, PeA, &Earth),
+                OrbitalEccentricity(foo.Vx_, foo.Vy_, altitude, &Earth),
+                1e-14);
+  }
+}
+
+TEST(OrbitInsertionTest, TestBatch) {
+  // a tail that is not a whole SIMD block
+  const std::size_t n = 27;
+  std::vector<double> altitude(n), ApA(n), PeA(n);
+  for (std::size_t i = 0; i < n; i++) {
+    PeA[i] = 70000.0 + 1000.0 * i;
+    ApA[i] = PeA[i] + 50000.0 * i;
+    altitude[i] = PeA[i] + 0.3 * (ApA[i] - PeA[i]);
+  }
+
+  std::vector<double> Vx(n), Vy(n), gamma(n);
+  OrbitInsertion::Solve(&Kerbin, altitude.data(), ApA.data(), PeA.data(),
+                        Vx.data(), Vy.data(), gamma.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    OrbitInsertion foo(altitude[i], ApA[i], PeA[i], &Kerbin);
+    EXPECT_DOUBLE_EQ(foo.Vx_, Vx[i]) << i;
+    EXPECT_NEAR(foo.Vy_, Vy[i], 1e-12) << i;
+    EXPECT_NEAR(foo.gamma_, gamma[i], 1e-15) << i;
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/Apsides.hpp"             // for Apsides
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp"   // for Earth
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp"     // for SpecificRelativ...
+#include <cmath>                                   // for sqrt, isinf
+#include <cstddef>                                 // for size_t
+#include <gtest/gtest.h>                           // for Message, TestPa...
+#include <vector>                                  // for vector
+
+TEST(ApsidesTest, TestConstructor) {
+  ASSERT_NO_THROW({ Apsides foo; });
+  ASSERT_NO_THROW({
+    Apsides foo(SemiMajorAxis(7.0e6), OrbitalEccentricity(0.1), &Earth);
+  });
+}
+
+TEST(ApsidesTest, TestHyperbolic) {
+  const double rp = 7.0e6;
+  const double e = 1.5;
+  Apsides foo(SemiMajorAxis(rp / (1.0 - e)), OrbitalEccentricity(e), &Earth);
+
+  EXPECT_DOUBLE_EQ(rp, foo.periapsis_);
+  EXPECT_DOUBLE_EQ(rp - Earth.R_, foo.periapsisAltitude_);
+  EXPECT_TRUE(std::isinf(foo.apoapsis_));
+  EXPECT_TRUE(std::isinf(foo.apoapsisAltitude_));
+}
+
+TEST(ApsidesTest, TestParabolic) {
+  const double rp = 7.0e6;
+  Apsides foo(OrbitalEccentricity(1.0),
+              SpecificRelativeAngularMomentum(std::sqrt(2.0 * Earth.mu_ * rp)),
+              &Earth);
+
+  EXPECT_DOUBLE_EQ(rp, foo.periapsis_);
+  EXPECT_TRUE(std::isinf(foo.apoapsis_));
+}
+
+TEST(ApsidesTest, TestBatch) {
+  // both kinds of the orbits, and a tail that is not a whole SIMD block
+  const std::size_t n = 23;
+  std::vector<double> a(n), e(n);
+  for (std::size_t i = 0; i < n; i++) {
+    e[i] = 0.05 + 0.1 * i;
+    a[i] = 7.0e6 * (1.0 + i) / (1.0 - e[i]);
+  }
+
+  std::vector<double> rp(n), ra(n), hp(n), ha(n);
+  Apsides::FromElements(&Earth, a.data(), e.data(), rp.data(), ra.data(),
+                        hp.data(), ha.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    Apsides foo(SemiMajorAxis(a[i]), OrbitalEccentricity(e[i]), &Earth);
+    EXPECT_EQ(foo.periapsis_, rp[i]) << i;
+    EXPECT_EQ(foo.apoapsis_, ra[i]) << i;
+    EXPECT_EQ(foo.periapsisAltitude_, hp[i]) << i;
+    EXPECT_EQ(foo.apoapsisAltitude_, ha[i]) << i;
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/Apsides.hpp"             // for Apsides
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/Apoapsis.hpp"            // for Apoapsis
+#include "OrbitalElements/CelestialBodyData.hpp"   // for Earth
+#include "OrbitalElements/EllipticalOrbitData.hpp" // for EllipticalOrbitData
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
+#include "OrbitalElements/Periapsis.hpp"           // for Periapsis
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp"     // for SpecificRelativ...
+#include <gtest/gtest.h>                           // for CmpHelperFloating...
+
+class ApsidesTest : public ::testing::TestWithParam<EllipticalOrbitData> {};
+
+INSTANTIATE_TEST_CASE_P(Kerbin, ApsidesTest,
+                        testing::ValuesIn(KerbinEllipticalOrbitData));
+
+INSTANTIATE_TEST_CASE_P(Earth, ApsidesTest,
+                        testing::ValuesIn(EarthEllipticalOrbitData));
+
+TEST_P(ApsidesTest, Default) {
+  auto as = GetParam();
+
+  Apsides foo(SemiMajorAxis(as.sma), OrbitalEccentricity(as.ecc), as.body);
+
+  EXPECT_DOUBLE_EQ(as.altitude + as.body->R_, foo.periapsis_);
+  EXPECT_DOUBLE_EQ(as.apoapsis + as.body->R_, foo.apoapsis_);
+
+  EXPECT_NEAR(as.altitude, foo.periapsisAltitude_, 1.0e-08);
+  EXPECT_FLOAT_EQ(as.apoapsis, foo.apoapsisAltitude_);
+}
+
+TEST_P(ApsidesTest, FromAngularMomentum) {
+  auto as = GetParam();
+
+  Apsides foo(OrbitalEccentricity(as.ecc),
+              SpecificRelativeAngularMomentum(as.srh), as.body);
+
+  EXPECT_DOUBLE_EQ(as.altitude + as.body->R_, foo.periapsis_);
+  EXPECT_DOUBLE_EQ(as.apoapsis + as.body->R_, foo.apoapsis_);
+}
+
+TEST_P(ApsidesTest, SameAsApsis) {
+  auto as = GetParam();
+
+  SemiMajorAxis sma(as.sma);
+  OrbitalEccentricity ecc(as.ecc);
+  Apsides foo(sma, ecc, as.body);
+
+  EXPECT_EQ(Periapsis(sma, ecc, as.body).Radius(), foo.periapsis_);
+  EXPECT_DOUBLE_EQ(Apoapsis(sma, ecc, as.body).Radius(), foo.apoapsis_);
+}
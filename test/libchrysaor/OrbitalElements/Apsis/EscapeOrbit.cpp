@@ -0,0 +1,69 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/Apoapsis.hpp"            // for Apoapsis
+#include "OrbitalElements/CelestialBodyData.hpp"   // for Earth
+#include "OrbitalElements/OrbitalEccentricity.hpp" // for OrbitalEccentricity
+#include "OrbitalElements/Periapsis.hpp"           // for Periapsis
+#include "OrbitalElements/SemiMajorAxis.hpp"       // for SemiMajorAxis
+#include "SpecificRelativeAngularMomentum.hpp"     // for SpecificRelativ...
+#include <cmath>                                   // for sqrt, isinf
+#include <gtest/gtest.h>                           // for Message, TestPa...
+
+TEST(ApsisTest, TestHyperbolic) {
+  // the semi-major axis is negative, r_p = a(1 - e) as for the ellipses
+  const double rp = 7.0e6;
+  const double e = 1.5;
+  SemiMajorAxis sma(rp / (1.0 - e));
+  OrbitalEccentricity ecc(e);
+
+  Periapsis pe(sma, ecc, &Earth);
+  Apoapsis ap(sma, ecc, &Earth);
+  EXPECT_DOUBLE_EQ(rp, pe);
+  EXPECT_DOUBLE_EQ(rp - Earth.R_, pe.Altitude());
+  EXPECT_TRUE(std::isinf(ap.Radius()));
+  EXPECT_GT(ap.Radius(), 0.0);
+
+  SpecificRelativeAngularMomentum srh(std::sqrt(Earth.mu_ * rp * (1.0 + e)));
+  EXPECT_DOUBLE_EQ(rp, Periapsis(ecc, srh, &Earth));
+  EXPECT_TRUE(std::isinf(Apoapsis(ecc, srh, &Earth).Altitude()));
+}
+
+TEST(ApsisTest, TestParabolic) {
+  // no semi-major axis, h^2 = 2 mu r_p
+  const double rp = 7.0e6;
+  OrbitalEccentricity ecc(1.0);
+  SpecificRelativeAngularMomentum srh(std::sqrt(2.0 * Earth.mu_ * rp));
+
+  EXPECT_DOUBLE_EQ(rp, Periapsis(ecc, srh, &Earth));
+  EXPECT_TRUE(std::isinf(Apoapsis(ecc, srh, &Earth)));
+}
+
+TEST(ApsisTest, TestFromAngularMomentum) {
+  // the same apsides, of the ellipse, either way
+  const double rp = 7.0e6;
+  const double e = 0.3;
+  SemiMajorAxis sma(rp / (1.0 - e));
+  OrbitalEccentricity ecc(e);
+  SpecificRelativeAngularMomentum srh(std::sqrt(Earth.mu_ * rp * (1.0 + e)));
+
+  EXPECT_DOUBLE_EQ(Periapsis(sma, ecc, &Earth), Periapsis(ecc, srh, &Earth));
+  EXPECT_DOUBLE_EQ(Apoapsis(sma, ecc, &Earth), Apoapsis(ecc, srh, &Earth));
+  EXPECT_DOUBLE_EQ(sma * (1.0 + e), Apoapsis(sma, ecc, &Earth));
+}
@@ -19,6 +19,8 @@
 #pragma once
 
 #include "CelestialBody.hpp" // for CelestialBody
+#include "Constants.hpp"     // for EarthMu, EarthEquatorialRadius
 
-const CelestialBody Kerbin(3.5316000e+12, 600000);
-const CelestialBody Earth(3.986004418e+14, 6378136.6);
+constexpr CelestialBody Kerbin(3.5316000e+12, 600000);
+constexpr CelestialBody Earth(Constants::EarthMu,
+                              Constants::EarthEquatorialRadius);
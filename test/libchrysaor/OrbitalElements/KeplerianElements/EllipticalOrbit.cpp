@@ -0,0 +1,49 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/KeplerianElements.hpp"   // for KeplerianElements
+#include "CelestialBody.hpp"                       // for CelestialBody
+#include "OrbitalElements/EllipticalOrbitData.hpp" // for EllipticalOrbit...
+#include "Vec3.hpp"                                // for Vec3
+#include <gtest/gtest.h>                           // for CmpHelperFloati...
+
+class KeplerianElementsTest
+    : public ::testing::TestWithParam<EllipticalOrbitData> {};
+
+INSTANTIATE_TEST_CASE_P(Kerbin, KeplerianElementsTest,
+                        testing::ValuesIn(KerbinEllipticalOrbitData));
+
+INSTANTIATE_TEST_CASE_P(Earth, KeplerianElementsTest,
+                        testing::ValuesIn(EarthEllipticalOrbitData));
+
+TEST_P(KeplerianElementsTest, AtPeriapsis) {
+  auto as = GetParam();
+
+  // horizontal velocity at periapsis, in the equatorial plane
+  const Vec3 position(as.body->R_ + as.altitude, 0.0, 0.0);
+  const Vec3 velocity(0.0, as.velocity, 0.0);
+  KeplerianElements foo(position, velocity, as.body);
+
+  EXPECT_NEAR(as.sma, foo.a_, 1e-9 * as.sma);
+  EXPECT_NEAR(as.ecc, foo.e_, 1.0e-07);
+  EXPECT_EQ(0.0, foo.i_);
+  EXPECT_EQ(0.0, foo.raan_);
+  // the periapsis is on the X axis
+  EXPECT_NEAR(0.0, foo.argp_ + foo.nu_ - (foo.nu_ > 1.0 ? 2 * M_PI : 0.0),
+              1e-9);
+}
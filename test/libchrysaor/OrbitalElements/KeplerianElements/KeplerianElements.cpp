@@ -0,0 +1,212 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OrbitalElements/KeplerianElements.hpp" // for KeplerianElements
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for cos, sin, sqrt, M_PI
+#include <cstddef>                               // for size_t
+#include <gtest/gtest.h>                         // for Message, TestPa...
+#include <vector>                                // for vector
+
+namespace {
+
+const double Deg = M_PI / 180.0;
+
+// the angles are compared on the circle
+double AngleError(double expected, double actual) {
+  return std::abs(std::remainder(expected - actual, 2.0 * M_PI));
+}
+
+// the inverse conversion, via the perifocal frame
+void ToStateVector(const KeplerianElements &k, const CelestialBody *body,
+                   Vec3 *position, Vec3 *velocity) {
+  const double p = k.a_ * (1.0 - k.e_ * k.e_);
+  const double r = p / (1.0 + k.e_ * std::cos(k.nu_));
+  const double s = std::sqrt(body->mu_ / p);
+
+  const Vec3 rp(r * std::cos(k.nu_), r * std::sin(k.nu_), 0.0);
+  const Vec3 vp(-s * std::sin(k.nu_), s * (k.e_ + std::cos(k.nu_)), 0.0);
+
+  const double cO = std::cos(k.raan_), sO = std::sin(k.raan_);
+  const double cw = std::cos(k.argp_), sw = std::sin(k.argp_);
+  const double ci = std::cos(k.i_), si = std::sin(k.i_);
+
+  const Vec3 P(cO * cw - sO * sw * ci, sO * cw + cO * sw * ci, sw * si);
+  const Vec3 Q(-cO * sw - sO * cw * ci, -sO * sw + cO * cw * ci, cw * si);
+
+  *position = P * rp.x_ + Q * rp.y_;
+  *velocity = P * vp.x_ + Q * vp.y_;
+}
+
+KeplerianElements Make(double a, double e, double i, double raan, double argp,
+                       double nu) {
+  KeplerianElements k;
+  k.a_ = a;
+  k.e_ = e;
+  k.i_ = i * Deg;
+  k.raan_ = raan * Deg;
+  k.argp_ = argp * Deg;
+  k.nu_ = nu * Deg;
+  return k;
+}
+
+void ExpectElements(const KeplerianElements &expected,
+                    const KeplerianElements &actual) {
+  EXPECT_NEAR(expected.a_, actual.a_, 1e-9 * std::abs(expected.a_));
+  EXPECT_NEAR(expected.e_, actual.e_, 1e-12);
+  EXPECT_NEAR(expected.i_, actual.i_, 1e-12);
+  EXPECT_LT(AngleError(expected.raan_, actual.raan_), 1e-10);
+  EXPECT_LT(AngleError(expected.argp_, actual.argp_), 1e-9);
+  EXPECT_LT(AngleError(expected.nu_, actual.nu_), 1e-9);
+}
+
+const KeplerianElements Orbits[] = {
+    Make(7.0e6, 0.01, 51.6, 120.0, 30.0, 45.0),
+    Make(2.6560e7, 0.74, 63.4, 270.0, 270.0, 180.0),
+    Make(4.2164e7, 0.2, 0.5, 75.0, 10.0, 300.0),
+    Make(8.0e6, 0.3, 98.0, 340.0, 200.0, 10.0),
+    Make(1.0e7, 0.5, 150.0, 5.0, 95.0, 250.0),
+    Make(-2.0e7, 1.5, 28.5, 200.0, 45.0, 60.0),
+};
+
+} // namespace
+
+TEST(KeplerianElementsTest, TestConstructor) {
+  ASSERT_NO_THROW({ KeplerianElements foo; });
+  ASSERT_NO_THROW({
+    KeplerianElements foo(Vec3(7e6, 0, 0), Vec3(0, 7.5e3, 0), &Earth);
+  });
+}
+
+TEST(KeplerianElementsTest, TestRoundTrip) {
+  for (const KeplerianElements &k : Orbits) {
+    Vec3 r, v;
+    ToStateVector(k, &Earth, &r, &v);
+
+    ExpectElements(k, KeplerianElements(r, v, &Earth));
+  }
+}
+
+TEST(KeplerianElementsTest, TestRange) {
+  for (const KeplerianElements &k : Orbits) {
+    Vec3 r, v;
+    ToStateVector(k, &Earth, &r, &v);
+    const KeplerianElements foo(r, v, &Earth);
+
+    EXPECT_GE(foo.i_, 0.0);
+    EXPECT_LE(foo.i_, M_PI);
+    for (double angle : {foo.raan_, foo.argp_, foo.nu_}) {
+      EXPECT_GE(angle, 0.0);
+      EXPECT_LT(angle, 2.0 * M_PI);
+    }
+  }
+}
+
+TEST(KeplerianElementsTest, TestCircular) {
+  // the anomaly is the argument of latitude
+  const KeplerianElements k = Make(7.0e6, 0.0, 45.0, 60.0, 0.0, 100.0);
+  Vec3 r, v;
+  ToStateVector(k, &Earth, &r, &v);
+  const KeplerianElements foo(r, v, &Earth);
+
+  EXPECT_NEAR(0.0, foo.e_, 1e-14);
+  EXPECT_EQ(0.0, foo.argp_);
+  ExpectElements(k, foo);
+}
+
+TEST(KeplerianElementsTest, TestEquatorial) {
+  // the argument of periapsis is the longitude of periapsis
+  const KeplerianElements k = Make(9.0e6, 0.2, 0.0, 0.0, 135.0, 20.0);
+  Vec3 r, v;
+  ToStateVector(k, &Earth, &r, &v);
+  const KeplerianElements foo(r, v, &Earth);
+
+  EXPECT_EQ(0.0, foo.i_);
+  EXPECT_EQ(0.0, foo.raan_);
+  ExpectElements(k, foo);
+}
+
+TEST(KeplerianElementsTest, TestRetrogradeEquatorial) {
+  // the angles are measured in the direction of motion
+  const KeplerianElements k = Make(9.0e6, 0.2, 180.0, 0.0, 135.0, 20.0);
+  Vec3 r, v;
+  ToStateVector(k, &Earth, &r, &v);
+  const KeplerianElements foo(r, v, &Earth);
+
+  EXPECT_EQ(M_PI, foo.i_);
+  EXPECT_EQ(0.0, foo.raan_);
+  ExpectElements(k, foo);
+}
+
+TEST(KeplerianElementsTest, TestCircularEquatorial) {
+  // the anomaly is the true longitude
+  const Vec3 r(0.0, -7.0e6, 0.0);
+  const Vec3 v(std::sqrt(Earth.mu_ / 7.0e6), 0.0, 0.0);
+  const KeplerianElements foo(r, v, &Earth);
+
+  EXPECT_NEAR(7.0e6, foo.a_, 1e-6);
+  EXPECT_NEAR(0.0, foo.e_, 1e-14);
+  EXPECT_EQ(0.0, foo.i_);
+  EXPECT_EQ(0.0, foo.raan_);
+  EXPECT_EQ(0.0, foo.argp_);
+  EXPECT_NEAR(1.5 * M_PI, foo.nu_, 1e-12);
+}
+
+TEST(KeplerianElementsTest, TestBatch) {
+  // several full vectors, a tail, and the degenerate cases in the lanes
+  std::vector<KeplerianElements> orbits(std::begin(Orbits), std::end(Orbits));
+  orbits.push_back(Make(7.0e6, 0.0, 45.0, 60.0, 0.0, 100.0));
+  orbits.push_back(Make(9.0e6, 0.2, 0.0, 0.0, 135.0, 20.0));
+  orbits.push_back(Make(9.0e6, 0.2, 180.0, 0.0, 135.0, 20.0));
+  orbits.push_back(Make(7.0e6, 0.0, 0.0, 0.0, 0.0, 270.0));
+  orbits.push_back(Make(1.2e7, 0.1, 30.0, 0.0, 0.0, 0.0));
+  const std::size_t n = orbits.size();
+
+  std::vector<double> x(n), y(n), z(n), vx(n), vy(n), vz(n);
+  for (std::size_t k = 0; k < n; k++) {
+    Vec3 r, v;
+    ToStateVector(orbits[k], &Earth, &r, &v);
+    x[k] = r.x_;
+    y[k] = r.y_;
+    z[k] = r.z_;
+    vx[k] = v.x_;
+    vy[k] = v.y_;
+    vz[k] = v.z_;
+  }
+
+  std::vector<double> a(n), e(n), i(n), raan(n), argp(n), nu(n);
+  KeplerianElements::FromStateVectors(&Earth, x.data(), y.data(), z.data(),
+                                      vx.data(), vy.data(), vz.data(),
+                                      a.data(), e.data(), i.data(),
+                                      raan.data(), argp.data(), nu.data(), n);
+
+  for (std::size_t k = 0; k < n; k++) {
+    const KeplerianElements foo(Vec3(x[k], y[k], z[k]),
+                                Vec3(vx[k], vy[k], vz[k]), &Earth);
+    EXPECT_NEAR(foo.a_, a[k], 1e-12 * std::abs(foo.a_));
+    EXPECT_NEAR(foo.e_, e[k], 1e-14);
+    EXPECT_NEAR(foo.i_, i[k], 1e-14);
+    EXPECT_LT(AngleError(foo.raan_, raan[k]), 1e-12);
+    EXPECT_LT(AngleError(foo.argp_, argp[k]), 1e-12);
+    EXPECT_LT(AngleError(foo.nu_, nu[k]), 1e-12);
+    EXPECT_GE(nu[k], 0.0);
+    EXPECT_LT(nu[k], 2.0 * M_PI);
+  }
+}
@@ -22,6 +22,7 @@
 #include "OrbitalElements/SemiMajorAxis.hpp"         // for SemiMajorAxis
 #include "OrbitalElements/SpecificOrbitalEnergy.hpp" // for SpecificOrbital...
 #include "SpecificRelativeAngularMomentum.hpp"       // for SpecificRelativ...
+#include <cmath>                                     // for sqrt
 #include <gtest/gtest.h>                             // for Message, TestPa...
 
 double ecc_max_abs_err = 1.0e-07;
@@ -96,3 +97,20 @@ TEST(OrbitalEccentricityTest, TestGetter) {
     ASSERT_DOUBLE_EQ(0.0, foo);
   }
 }
+
+TEST(OrbitalEccentricityTest, TestEscape) {
+  // faster than the escape velocity, and way off the horizontal
+  const double Vx = 11500.0, Vy = 2000.0, altitude = 200000.0;
+  const double r = altitude + Earth.R_;
+
+  OrbitalEccentricity foo(Vx, Vy, altitude, &Earth);
+  OrbitalEccentricity bar(SpecificOrbitalEnergy(Vx, Vy, altitude, &Earth),
+                          SpecificRelativeAngularMomentum(r * Vx), &Earth);
+  EXPECT_GT(foo, 1.0);
+  EXPECT_DOUBLE_EQ(bar, foo);
+
+  // exactly the escape velocity, horizontally
+  OrbitalEccentricity parabolic(std::sqrt(2.0 * Earth.mu_ / r), 0.0, altitude,
+                                &Earth);
+  EXPECT_DOUBLE_EQ(1.0, parabolic);
+}
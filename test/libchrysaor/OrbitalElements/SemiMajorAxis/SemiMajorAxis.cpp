@@ -96,3 +96,13 @@ TEST(SemiMajorAxisTest, TestGetter) {
     ASSERT_DOUBLE_EQ(r + planet.R_, foo);
   }
 }
+
+TEST(SemiMajorAxisTest, TestHyperbolic) {
+  // negative, as from the vis-viva equation
+  const double Vx = 11500.0, Vy = 2000.0, altitude = 200000.0;
+
+  SemiMajorAxis foo(Vx, Vy, altitude, &Earth);
+  SemiMajorAxis bar(SpecificOrbitalEnergy(Vx, Vy, altitude, &Earth), &Earth);
+  EXPECT_LT(foo, 0.0);
+  EXPECT_DOUBLE_EQ(bar, foo);
+}
@@ -0,0 +1,75 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Parallel.hpp"
+#include <atomic>        // for atomic
+#include <cstddef>       // for size_t
+#include <gtest/gtest.h> // for Message, TestPartResult, TestP...
+#include <thread>        // for thread
+#include <vector>        // for vector
+
+namespace {
+
+// runs ParallelFor over n, and checks that every index came exactly once
+void ExpectEach(std::size_t n, std::size_t grain) {
+  std::vector<std::atomic<int>> seen(n);
+  for (std::atomic<int> &s : seen)
+    s.store(0);
+
+  ParallelFor(n, [&seen](std::size_t i) { seen[i]++; }, grain);
+
+  for (std::size_t i = 0; i < n; i++)
+    EXPECT_EQ(1, seen[i].load()) << i;
+}
+
+} // namespace
+
+TEST(ParallelTest, TestEach) {
+  ExpectEach(0, 1);
+  ExpectEach(1, 1);
+  ExpectEach(1000, 1);
+  ExpectEach(1000, 7);
+  ExpectEach(1000, 0);
+
+  // the pool is reused, call after call
+  for (int k = 0; k < 100; k++)
+    ExpectEach(97, 3);
+}
+
+TEST(ParallelTest, TestNested) {
+  // the inner calls run on the thread of the outer item
+  std::atomic<int> sum(0);
+  ParallelFor(16, [&sum](std::size_t) {
+    ParallelFor(16, [&sum](std::size_t j) { sum += static_cast<int>(j); });
+  });
+  EXPECT_EQ(16 * 120, sum.load());
+}
+
+TEST(ParallelTest, TestConcurrent) {
+  // a call made while another thread has the pool runs on its own thread
+  std::atomic<int> sum(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+    threads.emplace_back([&sum] {
+      for (int k = 0; k < 20; k++)
+        ParallelFor(100, [&sum](std::size_t) { sum++; }, 4);
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+  EXPECT_EQ(4 * 20 * 100, sum.load());
+}
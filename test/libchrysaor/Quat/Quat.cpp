@@ -0,0 +1,129 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Quat.hpp"      // for Quat, BasicQuat, operator<<
+#include "Mat3.hpp"      // for Mat3, BasicMat3
+#include "Vec3.hpp"      // for Vec3
+#include <cmath>         // for M_PI, sqrt
+#include <gtest/gtest.h> // for ASSERT_EQ, ASSERT_NEAR, TEST
+#include <sstream>       // for ostringstream
+#include <string>        // for string
+#include <vector>        // for vector
+
+static void ExpectNear(Vec3 expected, Vec3 actual, double abs_error) {
+  EXPECT_NEAR(expected.x_, actual.x_, abs_error);
+  EXPECT_NEAR(expected.y_, actual.y_, abs_error);
+  EXPECT_NEAR(expected.z_, actual.z_, abs_error);
+}
+
+TEST(QuatTest, TestConstructor) {
+  ASSERT_NO_THROW({ Quat foo; });
+  ASSERT_NO_THROW({ Quat foo(1.0, 0.0, 0.0, 0.0); });
+  ASSERT_NO_THROW({
+    Quat foo = Quat::FromAxisAngle(Vec3(0.0, 0.0, 1.0), 1.0);
+    (void)foo;
+  });
+}
+
+TEST(QuatTest, TestIdentity) {
+  constexpr Quat id;
+  static_assert(id == Quat(1.0, 0.0, 0.0, 0.0), "");
+  static_assert(id.rotate(Vec3(1.0, 2.0, 3.0)) == Vec3(1.0, 2.0, 3.0), "");
+  static_assert(id.matrix() == Mat3::Identity(), "");
+  ASSERT_EQ(1.0, id.norm());
+}
+
+TEST(QuatTest, TestRotate) {
+  const Quat q = Quat::FromAxisAngle(Vec3(0.0, 0.0, 1.0), M_PI / 2.0);
+
+  ExpectNear(Vec3(0.0, 1.0, 3.0), q.rotate(Vec3(1.0, 0.0, 3.0)), 1.0e-15);
+  ExpectNear(Vec3(-1.0, 0.0, 3.0), q.rotate(Vec3(0.0, 1.0, 3.0)), 1.0e-15);
+
+  // must agree with the rotation matrix
+  const Mat3 m = Mat3::RotationZ(M_PI / 2.0);
+  ExpectNear(m * Vec3(0.3, -0.7, 1.1), q.rotate(Vec3(0.3, -0.7, 1.1)),
+             1.0e-15);
+
+  // and with conversion to matrix, for an arbitrary axis
+  const double s = 1.0 / std::sqrt(3.0);
+  const Quat p = Quat::FromAxisAngle(Vec3(s, s, s), 2.0 * M_PI / 3.0);
+  ExpectNear(Vec3(0.0, 1.0, 0.0), p.rotate(Vec3(1.0, 0.0, 0.0)), 1.0e-15);
+  ExpectNear(p.matrix() * Vec3(0.3, -0.7, 1.1), p.rotate(Vec3(0.3, -0.7, 1.1)),
+             1.0e-15);
+}
+
+TEST(QuatTest, TestCompose) {
+  const Quat a = Quat::FromAxisAngle(Vec3(0.0, 0.0, 1.0), 0.3);
+  const Quat b = Quat::FromAxisAngle(Vec3(1.0, 0.0, 0.0), -1.2);
+  const Vec3 v(0.5, 2.0, -1.0);
+
+  ExpectNear(a.rotate(b.rotate(v)), (a * b).rotate(v), 1.0e-14);
+
+  Quat c = a;
+  c *= b;
+  ASSERT_EQ(a * b, c);
+
+  // conjugate undoes the rotation
+  ExpectNear(v, a.conjugate().rotate(a.rotate(v)), 1.0e-15);
+
+  // and the matrices compose the same way
+  const Mat3 m = a.matrix() * b.matrix();
+  ExpectNear(m * v, (a * b).rotate(v), 1.0e-14);
+}
+
+TEST(QuatTest, TestNormalize) {
+  Quat foo(1.0, 2.0, -2.0, 4.0);
+  ASSERT_EQ(5.0, foo.norm());
+
+  const Quat bar = foo.normalized();
+  ASSERT_EQ(Quat(0.2, 0.4, -0.4, 0.8), bar);
+  ASSERT_EQ(Quat(1.0, 2.0, -2.0, 4.0), foo);
+
+  foo.normalize();
+  ASSERT_EQ(bar, foo);
+  ASSERT_DOUBLE_EQ(1.0, foo.norm());
+}
+
+TEST(QuatTest, TestBatchedRotate) {
+  const Quat q = Quat::FromAxisAngle(Vec3(0.6, 0.0, 0.8), 0.7) *
+                 Quat::FromAxisAngle(Vec3(0.0, 1.0, 0.0), -2.1);
+
+  const std::size_t n = 41;
+  std::vector<double> x(n), y(n), z(n), ox(n), oy(n), oz(n);
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = static_cast<double>(i);
+    y[i] = -0.5 * static_cast<double>(i);
+    z[i] = 1.0 / (1.0 + static_cast<double>(i));
+  }
+
+  q.rotate(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    ExpectNear(q.rotate(Vec3(x[i], y[i], z[i])), Vec3(ox[i], oy[i], oz[i]),
+               1.0e-13);
+  }
+}
+
+TEST(QuatTest, TestPrint) {
+  const Quat foo(1.0, 2.5, 3.0, -4.0);
+
+  std::ostringstream output;
+  output << foo;
+
+  ASSERT_EQ(std::string("(1; 2.5; 3; -4)"), output.str());
+}
@@ -0,0 +1,166 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RotatingFrame.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Mat3.hpp"          // for Mat3
+#include "SolarSystem.hpp"   // for Earth
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for cos, sin, M_PI
+#include <cstddef>           // for size_t
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+
+namespace {
+
+const CelestialBody &Earth = SolarSystem::Earth;
+
+void ExpectNear(Vec3 ref, Vec3 v, double eps) {
+  EXPECT_NEAR(ref.x_, v.x_, eps);
+  EXPECT_NEAR(ref.y_, v.y_, eps);
+  EXPECT_NEAR(ref.z_, v.z_, eps);
+}
+
+} // namespace
+
+TEST(RotatingFrameTest, TestConstructor) {
+  const RotatingFrame frame(&Earth);
+
+  ASSERT_EQ(0.0, frame.Epoch());
+  ASSERT_EQ(0.0, frame.Angle());
+  ASSERT_EQ(1.0, frame.Cos());
+  ASSERT_EQ(0.0, frame.Sin());
+
+  const RotatingFrame shifted(&Earth, 0.5);
+  ASSERT_EQ(0.5, shifted.Angle());
+  ASSERT_EQ(std::cos(0.5), shifted.Cos());
+  ASSERT_EQ(std::sin(0.5), shifted.Sin());
+}
+
+TEST(RotatingFrameTest, TestQuarterTurn) {
+  RotatingFrame frame(&Earth);
+  frame.SetEpoch(Earth.Trot_ / 4.0);
+
+  ASSERT_NEAR(M_PI / 2.0, frame.Angle(), 1.0e-15);
+
+  // the body-fixed X axis now points to the inertial Y
+  ExpectNear(Vec3(0.0, 1.0, 0.0), frame.ToInertial(Vec3(1.0, 0.0, 0.0)),
+             1.0e-15);
+  ExpectNear(Vec3(0.0, -1.0, 0.0), frame.ToBodyFixed(Vec3(1.0, 0.0, 0.0)),
+             1.0e-15);
+  ExpectNear(Vec3(0.0, 0.0, 1.0), frame.ToBodyFixed(Vec3(0.0, 0.0, 1.0)),
+             0.0);
+}
+
+TEST(RotatingFrameTest, TestRoundTrip) {
+  RotatingFrame frame(&Earth, 1.234);
+
+  const Vec3 r(7.0e+06, -1.0e+06, 2.0e+06);
+  const Vec3 v(1.0e+03, 7.5e+03, -5.0e+02);
+
+  for (double t = 0.0; t < 1.0e+06; t = 2.0 * t + 123.0) {
+    frame.SetEpoch(t);
+
+    const Vec3 rbf = frame.ToBodyFixed(r);
+    ASSERT_NEAR(r.norm(), rbf.norm(), 1.0e-08);
+    ExpectNear(r, frame.ToInertial(rbf), 1.0e-08);
+
+    const Vec3 vbf = frame.VelocityToBodyFixed(r, v);
+    ExpectNear(v, frame.VelocityToInertial(rbf, vbf), 1.0e-11);
+
+    ExpectNear(frame.ToBodyFixedMatrix() * r, rbf, 1.0e-08);
+    ExpectNear(frame.ToInertialMatrix() * rbf, frame.ToInertial(rbf),
+               1.0e-08);
+  }
+}
+
+TEST(RotatingFrameTest, TestVelocity) {
+  RotatingFrame frame(&Earth);
+  frame.SetEpoch(1000.0);
+
+  // a point on the equator, at rest on the surface
+  const Vec3 rbf(Earth.R_, 0.0, 0.0);
+  const Vec3 v = frame.VelocityToInertial(rbf, Vec3());
+
+  ASSERT_NEAR(Earth.EquatorialSpeed(), v.norm(), 1.0e-10);
+  ASSERT_NEAR(0.0, v.dot(frame.ToInertial(rbf)), 1.0e-06);
+
+  // and it is at rest in the body-fixed frame
+  ExpectNear(Vec3(), frame.VelocityToBodyFixed(frame.ToInertial(rbf), v),
+             1.0e-10);
+}
+
+TEST(RotatingFrameTest, TestStep) {
+  RotatingFrame stepped(&Earth, 0.3);
+  RotatingFrame exact(&Earth, 0.3);
+
+  stepped.SetEpoch(100.0);
+  stepped.SetStep(0.5);
+
+  for (std::size_t i = 1; i <= 10 * RotatingFrame::ResyncSteps + 7; i++) {
+    stepped.Step();
+    exact.SetEpoch(100.0 + 0.5 * i);
+
+    ASSERT_EQ(exact.Epoch(), stepped.Epoch());
+    ASSERT_NEAR(exact.Cos(), stepped.Cos(), 1.0e-14);
+    ASSERT_NEAR(exact.Sin(), stepped.Sin(), 1.0e-14);
+  }
+
+  // and the step can be changed in the middle
+  stepped.SetStep(-60.0);
+  for (std::size_t i = 1; i <= 100; i++) {
+    stepped.Step();
+    exact.SetEpoch(exact.Epoch() - 60.0);
+
+    ASSERT_EQ(exact.Epoch(), stepped.Epoch());
+    ASSERT_NEAR(exact.Cos(), stepped.Cos(), 1.0e-14);
+    ASSERT_NEAR(exact.Sin(), stepped.Sin(), 1.0e-14);
+  }
+}
+
+TEST(RotatingFrameTest, TestNonRotating) {
+  const CelestialBody body(1.0e+10, 1.0e+05);
+  RotatingFrame frame(&body);
+  frame.SetEpoch(12345.0);
+
+  const Vec3 r(1.0, 2.0, 3.0);
+  ASSERT_EQ(r, frame.ToBodyFixed(r));
+  ASSERT_EQ(r, frame.ToInertial(r));
+  ASSERT_EQ(Vec3(4.0, 5.0, 6.0), frame.VelocityToBodyFixed(r, Vec3(4, 5, 6)));
+}
+
+TEST(RotatingFrameTest, TestBatch) {
+  RotatingFrame frame(&Earth);
+  frame.SetEpoch(4321.0);
+
+  const std::size_t n = 37;
+  double x[n], y[n], z[n], bx[n], by[n], bz[n], ix[n], iy[n], iz[n];
+  for (std::size_t i = 0; i < n; i++) {
+    x[i] = 7.0e+06 * std::cos(0.1 * i);
+    y[i] = 7.0e+06 * std::sin(0.1 * i);
+    z[i] = 1.0e+05 * i;
+  }
+
+  frame.ToBodyFixed(x, y, z, bx, by, bz, n);
+  frame.ToInertial(bx, by, bz, ix, iy, iz, n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    const Vec3 r(x[i], y[i], z[i]);
+    ExpectNear(frame.ToBodyFixed(r), Vec3(bx[i], by[i], bz[i]), 1.0e-08);
+    ExpectNear(r, Vec3(ix[i], iy[i], iz[i]), 1.0e-08);
+  }
+}
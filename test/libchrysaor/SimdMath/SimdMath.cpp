@@ -0,0 +1,139 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimdMath.hpp"
+#include "Simd.hpp"      // for Simd
+#include <cmath>         // for sin, cos, atan2, sqrt, cbrt, M_PI
+#include <cstddef>       // for size_t
+#include <cstring>       // for memcpy
+#include <gtest/gtest.h> // for Message, TestPartResult, TestP...
+#include <vector>        // for vector
+
+namespace {
+
+typedef Simd<double>::type V;
+const std::size_t W = Simd<double>::width;
+
+} // namespace
+
+TEST(SimdMathTest, TestSinCos) {
+  for (double x0 = -1000.0; x0 < 1000.0; x0 += 0.37) {
+    double x[W];
+    for (std::size_t j = 0; j < W; j++)
+      x[j] = x0 + 0.01 * j;
+
+    V vx, vs, vc;
+    std::memcpy(&vx, x, sizeof(V));
+    SimdSinCos(vx, &vs, &vc);
+
+    for (std::size_t j = 0; j < W; j++) {
+      EXPECT_NEAR(std::sin(x[j]), vs[j], 4e-16) << x[j];
+      EXPECT_NEAR(std::cos(x[j]), vc[j], 4e-16) << x[j];
+    }
+  }
+}
+
+TEST(SimdMathTest, TestSinCosQuadrants) {
+  const double x[] = {0.0, M_PI_2, M_PI, -M_PI_2};
+
+  V vx, vs, vc;
+  std::memcpy(&vx, x, sizeof(V));
+  SimdSinCos(vx, &vs, &vc);
+
+  for (std::size_t j = 0; j < W; j++) {
+    EXPECT_NEAR(std::sin(x[j]), vs[j], 1e-16);
+    EXPECT_NEAR(std::cos(x[j]), vc[j], 1e-16);
+  }
+}
+
+TEST(SimdMathTest, TestAtan2) {
+  for (double a = -M_PI; a < M_PI; a += 0.013) {
+    double y[W], x[W];
+    for (std::size_t j = 0; j < W; j++) {
+      const double r = 1.0 + 1000.0 * j;
+      y[j] = r * std::sin(a + 0.001 * j);
+      x[j] = r * std::cos(a + 0.001 * j);
+    }
+
+    V vy, vx, va;
+    std::memcpy(&vy, y, sizeof(V));
+    std::memcpy(&vx, x, sizeof(V));
+    SimdAtan2(vy, vx, &va);
+
+    for (std::size_t j = 0; j < W; j++)
+      EXPECT_NEAR(std::atan2(y[j], x[j]), va[j], 1e-15);
+  }
+}
+
+TEST(SimdMathTest, TestAtan2Axes) {
+  const double y[] = {0.0, 1.0, 0.0, -1.0};
+  const double x[] = {1.0, 0.0, -1.0, 0.0};
+
+  V vy, vx, va;
+  std::memcpy(&vy, y, sizeof(V));
+  std::memcpy(&vx, x, sizeof(V));
+  SimdAtan2(vy, vx, &va);
+
+  for (std::size_t j = 0; j < W; j++)
+    EXPECT_DOUBLE_EQ(std::atan2(y[j], x[j]), va[j]);
+
+  const V zero = {};
+  SimdAtan2(zero, zero, &va);
+  for (std::size_t j = 0; j < W; j++)
+    EXPECT_EQ(0.0, va[j]);
+}
+
+TEST(SimdMathTest, TestSqrt) {
+  const double x[] = {0.0, 1.0, 4.0, 1e300};
+
+  V vx, vr;
+  std::memcpy(&vx, x, sizeof(V));
+  SimdSqrt(vx, &vr);
+
+  for (std::size_t j = 0; j < W; j++)
+    EXPECT_EQ(std::sqrt(x[j]), vr[j]);
+
+  for (double x0 = 1e-300; x0 < 1e300; x0 *= 3.7) {
+    for (std::size_t j = 0; j < W; j++)
+      vx[j] = x0 * (1.0 + 0.3 * j);
+    SimdSqrt(vx, &vr);
+
+    for (std::size_t j = 0; j < W; j++)
+      EXPECT_NEAR(1.0, vr[j] / std::sqrt(vx[j]), 3e-16) << vx[j];
+  }
+}
+
+TEST(SimdMathTest, TestCbrt) {
+  const double x[] = {0.0, 1.0, -8.0, 27e300};
+
+  V vx, vr;
+  std::memcpy(&vx, x, sizeof(V));
+  SimdCbrt(vx, &vr);
+
+  for (std::size_t j = 0; j < W; j++)
+    EXPECT_DOUBLE_EQ(std::cbrt(x[j]), vr[j]);
+
+  for (double x0 = 1e-300; x0 < 1e300; x0 *= 3.7) {
+    for (std::size_t j = 0; j < W; j++)
+      vx[j] = (j & 1 ? -x0 : x0) * (1.0 + 0.3 * j);
+    SimdCbrt(vx, &vr);
+
+    for (std::size_t j = 0; j < W; j++)
+      EXPECT_NEAR(1.0, vr[j] / std::cbrt(vx[j]), 5e-16) << vx[j];
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SolarSystem.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Constants.hpp"     // for EarthMu, SpeedOfLight, ...
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+
+namespace {
+
+// all of these are compile-time constants
+constexpr CelestialBody Earth(Constants::EarthMu,
+                              Constants::EarthEquatorialRadius,
+                              86164.098903691);
+
+static_assert(Earth.mu_ == 3.986004418e+14, "TCB-compatible GM of Earth");
+static_assert(Earth.R_ == 6378136.6, "equatorial radius of Earth");
+static_assert(Earth.omega_ > 7.2921e-05 && Earth.omega_ < 7.2922e-05,
+              "angular velocity of Earth");
+static_assert(Earth.GravitationalAccelerationAtRadius(Earth.R_) > 9.79,
+              "gravity of Earth");
+
+static_assert(Constants::SpeedOfLight == 299792458.0, "speed of light");
+static_assert(Constants::StandardGravity == 9.80665, "g0");
+
+} // namespace
+
+TEST(ConstantsTest, TestPhysical) {
+  ASSERT_EQ(299792458.0, Constants::SpeedOfLight);
+  ASSERT_EQ(6.67408e-11, Constants::GravitationalConstant);
+  ASSERT_EQ(9.80665, Constants::StandardGravity);
+  ASSERT_EQ(101325.0, Constants::StandardAtmosphere);
+  ASSERT_EQ(8.3144598, Constants::MolarGasConstant);
+  ASSERT_EQ(1.38064852e-23, Constants::BoltzmannConstant);
+  ASSERT_EQ(6.022140857e+23, Constants::AvogadroConstant);
+}
+
+TEST(ConstantsTest, TestAstronomical) {
+  ASSERT_EQ(149597870700.0, Constants::AstronomicalUnit);
+  ASSERT_EQ(1.32712442099e+20, Constants::SunMu);
+  ASSERT_EQ(3.986004418e+14, Constants::EarthMu);
+  ASSERT_EQ(6378136.6, Constants::EarthEquatorialRadius);
+  ASSERT_EQ(0.0010826359, Constants::EarthJ2);
+  ASSERT_EQ(7.292115e-05, Constants::EarthAngularVelocity);
+  ASSERT_EQ(298.25642, Constants::EarthInverseFlattening);
+  ASSERT_EQ(3.09870359e+06, Constants::SunToMarsMassRatio);
+  ASSERT_EQ(1.36566e+08, Constants::SunToPlutoMassRatio);
+  ASSERT_EQ(3396190.0, Constants::MarsRadius);
+  ASSERT_EQ(1737400.0, Constants::MoonRadius);
+  ASSERT_EQ(696000000.0, Constants::SunRadius);
+}
+
+TEST(SolarSystemTest, TestHierarchy) {
+  ASSERT_EQ(nullptr, SolarSystem::Sun.ParentBody());
+  ASSERT_EQ(&SolarSystem::Sun, SolarSystem::Mercury.ParentBody());
+  ASSERT_EQ(&SolarSystem::Sun, SolarSystem::Earth.ParentBody());
+  ASSERT_EQ(&SolarSystem::Sun, SolarSystem::Neptune.ParentBody());
+  ASSERT_EQ(&SolarSystem::Earth, SolarSystem::Moon.ParentBody());
+}
+
+TEST(SolarSystemTest, TestBodies) {
+  ASSERT_EQ(Constants::SunMu, SolarSystem::Sun.mu_);
+  ASSERT_EQ(Constants::EarthMu, SolarSystem::Earth.mu_);
+  // from the nominal, rounded, angular velocity
+  ASSERT_NEAR(86164.0989, SolarSystem::Earth.Trot_, 1.0e-02);
+  ASSERT_NEAR(465.1, SolarSystem::Earth.EquatorialSpeed(), 1.0e-02);
+
+  // reference values from the JPL DE430, the mass ratios are less precise
+  ASSERT_NEAR(4.902800e+12, SolarSystem::Moon.mu_, 1.0e-04 * 4.902800e+12);
+  ASSERT_NEAR(2.203187e+13, SolarSystem::Mercury.mu_, 1.0e-04 * 2.203187e+13);
+  ASSERT_NEAR(3.248586e+14, SolarSystem::Venus.mu_, 1.0e-04 * 3.248586e+14);
+  ASSERT_NEAR(4.282837e+13, SolarSystem::Mars.mu_, 1.0e-04 * 4.282837e+13);
+  ASSERT_NEAR(1.267128e+17, SolarSystem::Jupiter.mu_, 1.0e-04 * 1.267128e+17);
+  ASSERT_NEAR(3.794058e+16, SolarSystem::Saturn.mu_, 1.0e-04 * 3.794058e+16);
+  ASSERT_NEAR(5.794556e+15, SolarSystem::Uranus.mu_, 1.0e-04 * 5.794556e+15);
+  ASSERT_NEAR(6.836527e+15, SolarSystem::Neptune.mu_, 1.0e-04 * 6.836527e+15);
+  ASSERT_NEAR(9.7178e+11, SolarSystem::Pluto.mu_, 1.0e-04 * 9.7178e+11);
+
+  ASSERT_EQ(0.0, SolarSystem::Mars.Trot_);
+  ASSERT_EQ(Constants::JupiterRadius, SolarSystem::Jupiter.R_);
+}
@@ -0,0 +1,233 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Terrain.hpp"
+#include "CelestialBody.hpp" // for CelestialBody
+#include "Vec3.hpp"          // for Vec3
+#include <cmath>             // for cos, sin, M_PI
+#include <cstddef>           // for size_t
+#include <cstdio>            // for remove
+#include <cstdlib>           // for mkdtemp
+#include <fstream>           // for ifstream, ofstream
+#include <gtest/gtest.h>     // for Message, TestPartResult, TestP...
+#include <ios>               // for ios
+#include <iterator>          // for istreambuf_iterator
+#include <string>            // for string
+#include <unistd.h>          // for rmdir
+#include <vector>            // for vector
+
+namespace {
+
+const CelestialBody Kerbin(3.5316000e+12, 600000.0, 21549.425);
+
+// linear within the tiles, so the bilinear interpolation is exact
+double Synthetic(double latitude, double longitude) {
+  return 100.0 * latitude + 10.0 * longitude + 5.0;
+}
+
+class TerrainTest : public ::testing::Test {
+protected:
+  const double tileSize = 10.0;
+  const std::size_t samples = 11;
+
+  std::string directory;
+  std::vector<std::string> files;
+
+  void SetUp() override {
+    char path[] = "/tmp/chrysaor-terrain-XXXXXX";
+    ASSERT_TRUE(mkdtemp(path));
+    directory = path;
+
+    // the tiles around the origin, 3 rows by 4 columns
+    Terrain terrain(&Kerbin, directory, tileSize, 1);
+    for (std::size_t row = 8; row < 11; row++) {
+      for (std::size_t col = 17; col < 21; col++)
+        Write(terrain, row, col);
+    }
+  }
+
+  void TearDown() override {
+    for (const std::string &file : files)
+      std::remove(file.c_str());
+    rmdir(directory.c_str());
+  }
+
+  void Write(const Terrain &terrain, std::size_t row, std::size_t col) {
+    const double lat0 = -90.0 + row * tileSize;
+    const double lon0 = -180.0 + col * tileSize;
+    const double step = tileSize / (samples - 1);
+
+    std::vector<float> heights(samples * samples);
+    for (std::size_t i = 0; i < samples; i++) {
+      for (std::size_t j = 0; j < samples; j++) {
+        heights[i * samples + j] = static_cast<float>(
+            Synthetic(lat0 + i * step, lon0 + j * step));
+      }
+    }
+
+    files.push_back(terrain.TilePath(row, col));
+    ASSERT_TRUE(Terrain::SaveTile(files.back(), samples, heights.data()));
+  }
+
+  // writes the tile, with its bytes passed through edit
+  template <typename Edit>
+  void WriteEdited(const Terrain &terrain, std::size_t row, std::size_t col,
+                   Edit edit) {
+    Write(terrain, row, col);
+
+    std::string bytes;
+    {
+      std::ifstream in(files.back(), std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(in),
+                   std::istreambuf_iterator<char>());
+    }
+
+    edit(&bytes);
+
+    std::ofstream out(files.back(), std::ios::binary | std::ios::trunc);
+    out << bytes;
+  }
+};
+
+} // namespace
+
+TEST_F(TerrainTest, TestConstructor) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+  EXPECT_EQ(tileSize, terrain.TileSize());
+  EXPECT_EQ(0U, terrain.Loads());
+  EXPECT_EQ(directory + "/9_18.dem", terrain.TilePath(9, 18));
+}
+
+TEST_F(TerrainTest, TestHeight) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+
+  for (double lat = -9.75; lat < 20.0; lat += 0.5) {
+    for (double lon = -9.75; lon < 20.0; lon += 0.5)
+      EXPECT_NEAR(Synthetic(lat, lon), terrain.Height(lat, lon), 1e-3);
+  }
+
+  // the grid points, and the tile edges, from either side
+  EXPECT_NEAR(Synthetic(3.0, 7.0), terrain.Height(3.0, 7.0), 1e-3);
+  EXPECT_NEAR(Synthetic(0.0, 0.0), terrain.Height(0.0, 0.0), 1e-3);
+  EXPECT_NEAR(Synthetic(10.0, 10.0), terrain.Height(10.0, 10.0), 1e-3);
+  EXPECT_NEAR(Synthetic(10.0, 10.0), terrain.Height(9.999999, 9.999999),
+              1e-3);
+}
+
+TEST_F(TerrainTest, TestMissing) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+
+  EXPECT_EQ(0.0, terrain.Height(45.0, 100.0));
+  EXPECT_EQ(0.0, terrain.Height(90.0, 0.0));
+  EXPECT_EQ(0.0, terrain.Height(-90.0, -180.0));
+
+  // a missing tile is cached too
+  const std::size_t loads = terrain.Loads();
+  EXPECT_EQ(0.0, terrain.Height(45.0, 100.0));
+  EXPECT_EQ(loads, terrain.Loads());
+}
+
+TEST_F(TerrainTest, TestMalformed) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+
+  // the row 12, from 30 to 40 degrees of latitude
+  WriteEdited(terrain, 12, 0, [](std::string *bytes) { bytes->clear(); });
+  WriteEdited(terrain, 12, 1,
+              [](std::string *bytes) { bytes->resize(bytes->size() - 4); });
+  WriteEdited(terrain, 12, 2, [](std::string *bytes) { (*bytes)[0] = 'X'; });
+  WriteEdited(terrain, 12, 3, [](std::string *bytes) { (*bytes)[8] = 1; });
+  WriteEdited(terrain, 12, 4, [](std::string *bytes) { (*bytes)[8] = 12; });
+  WriteEdited(terrain, 12, 5, [](std::string *bytes) { *bytes += "0"; });
+
+  for (std::size_t col = 0; col < 6; col++)
+    EXPECT_EQ(0.0, terrain.Height(35.0, -175.0 + 10.0 * col)) << col;
+
+  // and an intact one of the same row
+  Write(terrain, 12, 6);
+  EXPECT_NEAR(Synthetic(35.0, -115.0), terrain.Height(35.0, -115.0), 1e-3);
+}
+
+TEST_F(TerrainTest, TestSaveUnwritable) {
+  const float heights[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+
+  EXPECT_FALSE(Terrain::SaveTile(directory + "/missing/0_0.dem", 2, heights));
+}
+
+TEST_F(TerrainTest, TestLongitudeWrap) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+
+  EXPECT_EQ(terrain.Height(5.0, 5.0), terrain.Height(5.0, 365.0));
+  EXPECT_EQ(terrain.Height(5.0, -5.0), terrain.Height(5.0, 355.0));
+  EXPECT_EQ(terrain.Height(5.0, -5.0), terrain.Height(5.0, -725.0));
+}
+
+TEST_F(TerrainTest, TestCache) {
+  Terrain terrain(&Kerbin, directory, tileSize, 2);
+
+  // A, then B, then A again: two loads
+  terrain.Height(5.0, 5.0);
+  terrain.Height(5.0, 15.0);
+  terrain.Height(5.0, 6.0);
+  EXPECT_EQ(2U, terrain.Loads());
+
+  // C evicts the least recently used, B
+  terrain.Height(15.0, 5.0);
+  EXPECT_EQ(3U, terrain.Loads());
+  terrain.Height(5.0, 7.0);
+  EXPECT_EQ(3U, terrain.Loads());
+  terrain.Height(5.0, 15.0);
+  EXPECT_EQ(4U, terrain.Loads());
+
+  // and the evicted tiles still give the right heights
+  EXPECT_NEAR(Synthetic(15.0, 5.0), terrain.Height(15.0, 5.0), 1e-3);
+}
+
+TEST_F(TerrainTest, TestBatch) {
+  Terrain terrain(&Kerbin, directory, tileSize, 2);
+
+  // a ground track, across the tiles, and off them
+  const std::size_t n = 10000;
+  std::vector<double> lat(n), lon(n), height(n);
+  for (std::size_t i = 0; i < n; i++) {
+    const double f = 2.0 * M_PI * i / n;
+    lat[i] = 15.0 * std::sin(f) + 5.0;
+    lon[i] = 360.0 * i / n - 180.0;
+  }
+
+  terrain.Height(lat.data(), lon.data(), height.data(), n);
+
+  // a single pass over the track loads each of the tiles once
+  EXPECT_LT(terrain.Loads(), 50U);
+
+  Terrain reference(&Kerbin, directory, tileSize, 64);
+  for (std::size_t i = 0; i < n; i++)
+    EXPECT_EQ(reference.Height(lat[i], lon[i]), height[i]);
+}
+
+TEST_F(TerrainTest, TestAltitude) {
+  Terrain terrain(&Kerbin, directory, tileSize, 4);
+
+  const double lat = 2.5 * M_PI / 180.0;
+  const double lon = 7.5 * M_PI / 180.0;
+  const double radius = Kerbin.R_ + 10000.0;
+  const Vec3 r(radius * std::cos(lat) * std::cos(lon),
+               radius * std::cos(lat) * std::sin(lon),
+               radius * std::sin(lat));
+
+  EXPECT_NEAR(10000.0 - Synthetic(2.5, 7.5), terrain.Altitude(r), 1e-3);
+}
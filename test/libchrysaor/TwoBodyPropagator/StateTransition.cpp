@@ -0,0 +1,143 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "TwoBodyPropagator.hpp"                 // for TwoBodyPropagator
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt, abs
+#include <gtest/gtest.h>                         // for Message, TestPa...
+
+namespace {
+
+// the central differences of the propagation, column by column
+void FiniteDifferences(Vec3 r, Vec3 v, double dt, double *stm) {
+  TwoBodyPropagator propagator(&Earth);
+
+  for (int j = 0; j < 6; j++) {
+    const double h = j < 3 ? 1e-6 * r.norm() : 1e-6 * v.norm();
+    Vec3 d[2];
+    Vec3 rs[2], vs[2];
+    for (int s = 0; s < 2; s++) {
+      const double x = s == 0 ? -h : h;
+      d[s] = Vec3(j % 3 == 0 ? x : 0.0, j % 3 == 1 ? x : 0.0,
+                  j % 3 == 2 ? x : 0.0);
+      if (j < 3)
+        propagator.Propagate(r + d[s], v, dt, &rs[s], &vs[s]);
+      else
+        propagator.Propagate(r, v + d[s], dt, &rs[s], &vs[s]);
+    }
+    const Vec3 dr = (rs[1] - rs[0]) * (0.5 / h);
+    const Vec3 dv = (vs[1] - vs[0]) * (0.5 / h);
+    stm[0 * 6 + j] = dr.x_;
+    stm[1 * 6 + j] = dr.y_;
+    stm[2 * 6 + j] = dr.z_;
+    stm[3 * 6 + j] = dv.x_;
+    stm[4 * 6 + j] = dv.y_;
+    stm[5 * 6 + j] = dv.z_;
+  }
+}
+
+// each 3x3 block, relative to its norm
+void ExpectNear(const double *expected, const double *actual,
+                double tolerance) {
+  for (int b = 0; b < 4; b++) {
+    const int offset = (b / 2) * 18 + (b % 2) * 3;
+    double norm = 0.0, error = 0.0;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        const int k = offset + 6 * i + j;
+        norm += expected[k] * expected[k];
+        error += (expected[k] - actual[k]) * (expected[k] - actual[k]);
+      }
+    }
+    EXPECT_LE(std::sqrt(error), tolerance * std::sqrt(norm)) << "block " << b;
+  }
+}
+
+void ExpectTransition(Vec3 r, Vec3 v, double dt) {
+  TwoBodyPropagator propagator(&Earth);
+
+  Vec3 r1, v1, r2, v2;
+  double stm[36], expected[36];
+  propagator.Propagate(r, v, dt, &r1, &v1, stm);
+  propagator.Propagate(r, v, dt, &r2, &v2);
+  EXPECT_EQ(r2, r1);
+  EXPECT_EQ(v2, v1);
+
+  FiniteDifferences(r, v, dt, expected);
+  ExpectNear(expected, stm, 1e-6);
+}
+
+} // namespace
+
+TEST(TwoBodyPropagatorTest, TestTransitionIdentity) {
+  TwoBodyPropagator propagator(&Earth);
+
+  Vec3 r(7.0e6, 0.0, 0.0), v(0.0, 7.5e3, 1.0e3), r1, v1;
+  double stm[36];
+  propagator.Propagate(r, v, 0.0, &r1, &v1, stm);
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      EXPECT_EQ(i == j ? 1.0 : 0.0, stm[6 * i + j]);
+}
+
+TEST(TwoBodyPropagatorTest, TestTransitionElliptic) {
+  const Vec3 r(7.0e6, 1.0e6, -5.0e5), v(-1.0e3, 7.2e3, 1.5e3);
+  ExpectTransition(r, v, 600.0);
+  ExpectTransition(r, v, 4000.0);
+  ExpectTransition(r, v, -2500.0);
+
+  // a few revolutions
+  ExpectTransition(r, v, 30000.0);
+}
+
+TEST(TwoBodyPropagatorTest, TestTransitionHyperbolic) {
+  const Vec3 r(7.0e6, 0.0, 1.0e6), v(1.0e3, 12.0e3, 0.0);
+  ExpectTransition(r, v, 600.0);
+  ExpectTransition(r, v, 20000.0);
+}
+
+TEST(TwoBodyPropagatorTest, TestTransitionParabolic) {
+  // about the escape speed, the series of the Stumpff functions
+  const Vec3 r(7.0e6, 0.0, 0.0);
+  const double ve = std::sqrt(2.0 * Earth.mu_ / r.norm());
+  ExpectTransition(r, Vec3(0.0, ve, 0.0), 300.0);
+  ExpectTransition(r, Vec3(0.0, ve, 0.0), 5000.0);
+}
+
+TEST(TwoBodyPropagatorTest, TestTransitionComposition) {
+  TwoBodyPropagator propagator(&Earth);
+
+  // phi(t1 + t2) = phi(t2, t1) * phi(t1)
+  const Vec3 r(7.0e6, 1.0e6, -5.0e5), v(-1.0e3, 7.2e3, 1.5e3);
+  Vec3 r1, v1, r2, v2, r3, v3;
+  double a[36], b[36], c[36], ab[36];
+  propagator.Propagate(r, v, 1000.0, &r1, &v1, a);
+  propagator.Propagate(r1, v1, 1500.0, &r2, &v2, b);
+  propagator.Propagate(r, v, 2500.0, &r3, &v3, c);
+
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      ab[6 * i + j] = 0.0;
+      for (int k = 0; k < 6; k++)
+        ab[6 * i + j] += b[6 * i + k] * a[6 * k + j];
+    }
+  }
+  ExpectNear(c, ab, 1e-9);
+}
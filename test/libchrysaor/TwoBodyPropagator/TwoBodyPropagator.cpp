@@ -0,0 +1,202 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TwoBodyPropagator.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "Kepler.hpp"                            // for TrueAnomaly
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt, cos, sin, M_PI
+#include <gtest/gtest.h>                         // for Message, TestPa...
+
+namespace {
+
+// the integrals of the motion
+double Energy(Vec3 r, Vec3 v) {
+  return 0.5 * v.dot(v) - Earth.mu_ / r.norm();
+}
+
+Vec3 AngularMomentum(Vec3 r, Vec3 v) { return r.cross(v); }
+
+void ExpectNear(Vec3 expected, Vec3 actual, double tolerance) {
+  EXPECT_NEAR(0.0, (expected - actual).norm(), tolerance)
+      << expected << " vs " << actual;
+}
+
+// the state at periapsis, in the XY plane
+void Periapsis(double rp, double e, Vec3 *r, Vec3 *v) {
+  *r = Vec3(rp, 0.0, 0.0);
+  *v = Vec3(0.0, std::sqrt(Earth.mu_ * (1.0 + e) / rp), 0.0);
+}
+
+} // namespace
+
+TEST(TwoBodyPropagatorTest, TestStumpff) {
+  double c2, c3;
+
+  TwoBodyPropagator::StumpffFunctions(0.0, &c2, &c3);
+  EXPECT_DOUBLE_EQ(1.0 / 2.0, c2);
+  EXPECT_DOUBLE_EQ(1.0 / 6.0, c3);
+
+  TwoBodyPropagator::StumpffFunctions(M_PI * M_PI, &c2, &c3);
+  EXPECT_DOUBLE_EQ(2.0 / (M_PI * M_PI), c2);
+  EXPECT_DOUBLE_EQ(1.0 / (M_PI * M_PI), c3);
+
+  TwoBodyPropagator::StumpffFunctions(-4.0, &c2, &c3);
+  EXPECT_DOUBLE_EQ((std::cosh(2.0) - 1.0) / 4.0, c2);
+  EXPECT_DOUBLE_EQ((std::sinh(2.0) - 2.0) / 8.0, c3);
+}
+
+TEST(TwoBodyPropagatorTest, TestStumpffSeries) {
+  // the series meets the closed form, on both sides and on both ends
+  for (double z : {-1.0, 1.0}) {
+    double c2, c3, d2, d3;
+    TwoBodyPropagator::StumpffFunctions(z * (1.0 - 1e-15), &c2, &c3);
+    TwoBodyPropagator::StumpffFunctions(z * (1.0 + 1e-15), &d2, &d3);
+    EXPECT_NEAR(c2, d2, 1e-15);
+    EXPECT_NEAR(c3, d3, 1e-15);
+  }
+}
+
+TEST(TwoBodyPropagatorTest, TestZero) {
+  TwoBodyPropagator foo(&Earth);
+  Vec3 r0, v0, r, v;
+  Periapsis(7e6, 0.1, &r0, &v0);
+
+  foo.Propagate(r0, v0, 0.0, &r, &v);
+  EXPECT_EQ(r0, r);
+  EXPECT_EQ(v0, v);
+}
+
+TEST(TwoBodyPropagatorTest, TestCircular) {
+  // a quarter of the circular orbit
+  const double R = 7e6;
+  const double V = std::sqrt(Earth.mu_ / R);
+  const double T = 2.0 * M_PI * R / V;
+
+  TwoBodyPropagator foo(&Earth);
+  Vec3 r, v;
+  foo.Propagate(Vec3(R, 0, 0), Vec3(0, V, 0), 0.25 * T, &r, &v);
+
+  ExpectNear(Vec3(0, R, 0), r, 1e-6);
+  ExpectNear(Vec3(-V, 0, 0), v, 1e-9);
+
+  // and whole revolutions
+  foo.Propagate(Vec3(R, 0, 0), Vec3(0, V, 0), 10.0 * T, &r, &v);
+  ExpectNear(Vec3(R, 0, 0), r, 1e-5);
+}
+
+TEST(TwoBodyPropagatorTest, TestKepler) {
+  // the same position as the Kepler's equation gives
+  for (double e : {0.0, 0.3, 0.7, 0.95, 1.0, 1.5, 4.0}) {
+    const double rp = 7e6;
+    const double p = rp * (1.0 + e);
+    Vec3 r0, v0;
+    Periapsis(rp, e, &r0, &v0);
+
+    TwoBodyPropagator foo(&Earth);
+    for (double dt = 60.0; dt < 1e5; dt *= 1.5) {
+      double M;
+      if (e < 1.0) {
+        const double a = rp / (1.0 - e);
+        M = std::sqrt(Earth.mu_ / (a * a * a)) * dt;
+      } else if (e == 1.0) {
+        M = std::sqrt(Earth.mu_ / (2.0 * rp * rp * rp)) * dt;
+      } else {
+        const double a = rp / (e - 1.0);
+        M = std::sqrt(Earth.mu_ / (a * a * a)) * dt;
+      }
+      const double nu = TrueAnomaly(M, e);
+      const double rn = p / (1.0 + e * std::cos(nu));
+
+      Vec3 r, v;
+      foo.Propagate(r0, v0, dt, &r, &v);
+      ExpectNear(Vec3(rn * std::cos(nu), rn * std::sin(nu), 0.0), r,
+                 1e-9 * rn);
+    }
+  }
+}
+
+TEST(TwoBodyPropagatorTest, TestIntegrals) {
+  // an inclined ellipse, a parabola and a hyperbola
+  const Vec3 r0(7e6, -1e6, 2e6);
+  for (double speed : {7.0e3, 9.5e3, 10.5e3, 14.0e3}) {
+    const Vec3 v0 = Vec3(1.0, 6.0, 2.0) * (speed / std::sqrt(41.0));
+
+    TwoBodyPropagator foo(&Earth);
+    for (double dt = -2e4; dt < 2e4; dt += 1234.5) {
+      Vec3 r, v;
+      foo.Propagate(r0, v0, dt, &r, &v);
+
+      const double E = Energy(r0, v0);
+      EXPECT_NEAR(E, Energy(r, v), 1e-9 * std::abs(Earth.mu_ / r0.norm()));
+      ExpectNear(AngularMomentum(r0, v0), AngularMomentum(r, v),
+                 1e-10 * AngularMomentum(r0, v0).norm());
+    }
+  }
+}
+
+TEST(TwoBodyPropagatorTest, TestParabolic) {
+  // exactly the escape speed, one code path for all the conics
+  const double R = 7e6;
+  TwoBodyPropagator foo(&Earth);
+  Vec3 r, v;
+  foo.Propagate(Vec3(R, 0, 0), Vec3(0, std::sqrt(2.0 * Earth.mu_ / R), 0),
+                3600.0, &r, &v);
+
+  EXPECT_NEAR(0.0, Energy(r, v), 1e-9 * Earth.mu_ / R);
+  EXPECT_GT(r.norm(), R);
+}
+
+TEST(TwoBodyPropagatorTest, TestRoundTrip) {
+  const Vec3 r0(7e6, -1e6, 2e6);
+  const Vec3 v0(1e3, 7e3, 2e3);
+
+  TwoBodyPropagator foo(&Earth);
+  Vec3 r1, v1, r2, v2;
+  foo.Propagate(r0, v0, 5000.0, &r1, &v1);
+  foo.Propagate(r1, v1, -5000.0, &r2, &v2);
+
+  ExpectNear(r0, r2, 1e-6);
+  ExpectNear(v0, v2, 1e-9);
+}
+
+TEST(TwoBodyPropagatorTest, TestWarmStart) {
+  // the same coast arc, with a perturbed initial state
+  const Vec3 r0(7e6, -1e6, 2e6);
+  const Vec3 v0(1e3, 7e3, 2e3);
+
+  TwoBodyPropagator foo(&Earth);
+  Vec3 r, v;
+  foo.Propagate(r0, v0, 5000.0, &r, &v);
+  const int cold = foo.Iterations();
+
+  for (int i = 1; i <= 10; i++) {
+    const Vec3 dv(1e-3 * i, -2e-3 * i, 0.5e-3 * i);
+    foo.Propagate(r0, v0 + dv, 5000.0, &r, &v);
+    EXPECT_LE(foo.Iterations(), 3);
+    EXPECT_LT(foo.Iterations(), cold);
+
+    // the same answer, as from the cold start
+    TwoBodyPropagator bar(&Earth);
+    Vec3 r1, v1;
+    bar.Propagate(r0, v0 + dv, 5000.0, &r1, &v1);
+    ExpectNear(r1, r, 1e-6);
+    ExpectNear(v1, v, 1e-9);
+  }
+}
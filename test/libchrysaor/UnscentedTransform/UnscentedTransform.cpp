@@ -0,0 +1,178 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UnscentedTransform.hpp"
+#include "CelestialBody.hpp"                     // for CelestialBody
+#include "Constants.hpp"                         // for EarthJ2
+#include "Gravity/ZonalGravity.hpp"              // for ZonalGravity
+#include "NumericalPropagator.hpp"               // for NumericalPropagator
+#include "OrbitalElements/CelestialBodyData.hpp" // for Earth
+#include "TwoBodyPropagator.hpp"                 // for TwoBodyPropagator
+#include "Vec3.hpp"                              // for Vec3
+#include <cmath>                                 // for sqrt, abs
+#include <cstddef>                               // for size_t
+#include <gtest/gtest.h>                         // for Message, TestPa...
+#include <vector>                                // for vector
+
+namespace {
+
+const double Mean[6] = {7.0e6, 1.0e6, -5.0e5, -1.0e3, 7.2e3, 1.5e3};
+
+// 100 m and 0.1 m/s, correlated
+void Covariance(double scale, double *P) {
+  const double sigma[6] = {100.0, 100.0, 100.0, 0.1, 0.1, 0.1};
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      P[6 * i + j] = scale * scale * sigma[i] * sigma[j] *
+                     (i == j ? 1.0 : (i % 3 == j % 3 ? 0.5 : 0.1));
+}
+
+// relative to the diagonal
+void ExpectNear(const double *expected, const double *actual,
+                double tolerance) {
+  for (int i = 0; i < 6; i++)
+    for (int j = 0; j < 6; j++)
+      EXPECT_NEAR(expected[6 * i + j], actual[6 * i + j],
+                  tolerance * std::sqrt(expected[7 * i] * expected[7 * j]))
+          << i << ", " << j;
+}
+
+} // namespace
+
+TEST(UnscentedTransformTest, TestConstructor) {
+  ASSERT_NO_THROW({ UnscentedTransform foo; });
+  ASSERT_NO_THROW({ UnscentedTransform foo(1e-3, 2.0, 0.0); });
+
+  UnscentedTransform foo;
+  EXPECT_DOUBLE_EQ(std::sqrt(6.0), foo.Scale());
+  UnscentedTransform bar(0.5, 2.0, 3.0);
+  EXPECT_DOUBLE_EQ(1.5, bar.Scale());
+}
+
+TEST(UnscentedTransformTest, TestIdentity) {
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  const NumericalPropagator propagator(&gravity, 10.0);
+  const UnscentedTransform foo;
+
+  double P[36], mean[6], covariance[36];
+  Covariance(1.0, P);
+  foo.Propagate(&propagator, Mean, P, 0.0, mean, covariance);
+
+  for (int k = 0; k < 6; k++)
+    EXPECT_NEAR(Mean[k], mean[k], 1e-9 * std::abs(Mean[k]));
+  ExpectNear(P, covariance, 1e-9);
+}
+
+TEST(UnscentedTransformTest, TestLinear) {
+  // the small uncertainty moves with the state transition matrix,
+  // P' = phi*P*phi^T
+  const ZonalGravity gravity(&Earth, 0.0);
+  const NumericalPropagator propagator(&gravity, 5.0);
+  TwoBodyPropagator kepler(&Earth);
+
+  const double dt = 3000.0;
+  double P[36], phi[36], expected[36];
+  Covariance(1.0, P);
+
+  Vec3 r, v;
+  kepler.Propagate(Vec3(Mean[0], Mean[1], Mean[2]),
+                   Vec3(Mean[3], Mean[4], Mean[5]), dt, &r, &v, phi);
+  for (int i = 0; i < 6; i++) {
+    for (int j = 0; j < 6; j++) {
+      expected[6 * i + j] = 0.0;
+      for (int k = 0; k < 6; k++)
+        for (int l = 0; l < 6; l++)
+          expected[6 * i + j] += phi[6 * i + k] * P[6 * k + l] * phi[6 * j + l];
+    }
+  }
+
+  const UnscentedTransform foo;
+  double mean[6], covariance[36];
+  foo.Propagate(&propagator, Mean, P, dt, mean, covariance);
+
+  // the mean moves off the propagated state by the second order only
+  EXPECT_NEAR(0.0, (Vec3(mean[0], mean[1], mean[2]) - r).norm(), 1.0);
+  EXPECT_NEAR(0.0, (Vec3(mean[3], mean[4], mean[5]) - v).norm(), 1e-3);
+  ExpectNear(expected, covariance, 1e-4);
+
+  // in place
+  double m[6], c[36];
+  for (int k = 0; k < 6; k++)
+    m[k] = Mean[k];
+  for (int k = 0; k < 36; k++)
+    c[k] = P[k];
+  foo.Propagate(&propagator, m, c, dt, m, c);
+  for (int k = 0; k < 6; k++)
+    EXPECT_EQ(mean[k], m[k]);
+  for (int k = 0; k < 36; k++)
+    EXPECT_EQ(covariance[k], c[k]);
+}
+
+TEST(UnscentedTransformTest, TestNonlinear) {
+  // the large along-track uncertainty bends with the orbit, and the mean
+  // falls inside of it
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  const NumericalPropagator propagator(&gravity, 10.0);
+  const UnscentedTransform foo;
+
+  double P[36], mean[6], covariance[36];
+  Covariance(100.0, P);
+  foo.Propagate(&propagator, Mean, P, 20000.0, mean, covariance);
+
+  Vec3 r, v;
+  NumericalPropagator single(&gravity, 10.0);
+  single.Propagate(Vec3(Mean[0], Mean[1], Mean[2]),
+                   Vec3(Mean[3], Mean[4], Mean[5]), 20000.0, &r, &v);
+  const Vec3 rm(mean[0], mean[1], mean[2]);
+  EXPECT_GT((rm - r).norm(), 1.0);
+  EXPECT_LT(rm.norm(), r.norm() + 1e3);
+
+  for (int i = 0; i < 6; i++) {
+    EXPECT_GT(covariance[7 * i], P[7 * i]);
+    for (int j = 0; j < 6; j++)
+      EXPECT_DOUBLE_EQ(covariance[6 * i + j], covariance[6 * j + i]);
+  }
+}
+
+TEST(UnscentedTransformTest, TestBatch) {
+  // more cases than a block, in parallel
+  const ZonalGravity gravity(&Earth, Constants::EarthJ2);
+  const NumericalPropagator propagator(&gravity, 20.0);
+  const UnscentedTransform foo(0.5);
+
+  const std::size_t n = 11;
+  std::vector<double> means(6 * n), covariances(36 * n);
+  for (std::size_t c = 0; c < n; c++) {
+    for (int k = 0; k < 6; k++)
+      means[6 * c + k] = Mean[k] * (1.0 + 0.01 * c);
+    Covariance(1.0 + c, &covariances[36 * c]);
+  }
+
+  std::vector<double> mean(6 * n), covariance(36 * n);
+  foo.Propagate(&propagator, means.data(), covariances.data(), 2000.0,
+                mean.data(), covariance.data(), n);
+
+  for (std::size_t c = 0; c < n; c++) {
+    double m[6], P[36];
+    foo.Propagate(&propagator, &means[6 * c], &covariances[36 * c], 2000.0, m,
+                  P);
+    for (int k = 0; k < 6; k++)
+      EXPECT_NEAR(m[k], mean[6 * c + k], 1e-9 * std::abs(m[k]));
+    ExpectNear(P, &covariance[36 * c], 1e-9);
+  }
+}
@@ -57,3 +57,43 @@ TEST(Vec3Test, TestPrint) {
 
   ASSERT_EQ(foo_str, output.str());
 }
+
+TEST(Vec3Test, TestConstexpr) {
+  constexpr Vec3 foo(1.0, 2.0, 3.0);
+  constexpr Vec3 bar({4.0, 5.0, 6.0});
+
+  static_assert((foo + bar) == Vec3(5.0, 7.0, 9.0), "");
+  static_assert((bar - foo) == Vec3(3.0, 3.0, 3.0), "");
+  static_assert((foo * 2.0) == Vec3(2.0, 4.0, 6.0), "");
+  static_assert(foo.dot(bar) == 32.0, "");
+  static_assert(foo.cross(bar) == Vec3(-3.0, 6.0, -3.0), "");
+
+  ASSERT_EQ(Vec3(5.0, 7.0, 9.0), foo + bar);
+}
+
+TEST(Vec3Test, TestCompoundChaining) {
+  Vec3 foo(1.0, 2.0, 3.0);
+  const Vec3 bar(1.0, 1.0, 1.0);
+
+  Vec3 &ref = ((foo += bar) *= 2.0);
+
+  ASSERT_EQ(&foo, &ref);
+  ASSERT_EQ(Vec3(4.0, 6.0, 8.0), foo);
+
+  (foo -= bar) /= Vec3(3.0, 5.0, 7.0);
+  ASSERT_EQ(Vec3(1.0, 1.0, 1.0), foo);
+}
+
+TEST(Vec3Test, TestFusedExpression) {
+  const Vec3 r(6378136.6, -1234.5, 42.0);
+  const Vec3 v(7.8e+03, 0.1, -3.3);
+  const Vec3 a(-9.8, 0.01, 0.002);
+  const double dt = 0.125;
+
+  const Vec3 fused = r + v * dt + a * (0.5 * dt * dt);
+
+  // must be bit-for-bit identical to the hand-written per-component version.
+  ASSERT_EQ(r.x_ + v.x_ * dt + a.x_ * (0.5 * dt * dt), fused.x_);
+  ASSERT_EQ(r.y_ + v.y_ * dt + a.y_ * (0.5 * dt * dt), fused.y_);
+  ASSERT_EQ(r.z_ + v.z_ * dt + a.z_ * (0.5 * dt * dt), fused.z_);
+}
@@ -0,0 +1,76 @@
+/*
+ *    This file is part of chrysaor.
+ *    copyright (c) 2016 Roman Lebedev.
+ *
+ *    chrysaor is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    chrysaor is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with chrysaor.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Dual.hpp"      // for Dual, operator*, operator-, operator/
+#include "Vec3.hpp"      // for BasicVec3, Vec3f, Vec3
+#include <gtest/gtest.h> // for ASSERT_EQ, ASSERT_DOUBLE_EQ, TEST
+#include <sstream>       // for ostringstream
+#include <string>        // for string
+
+TEST(Vec3ScalarTest, TestFloat) {
+  Vec3f foo(1.0f, 2.0f, 2.0f);
+  const Vec3f bar(0.5f, 0.5f, 0.5f);
+
+  foo += bar;
+  ASSERT_EQ(Vec3f(1.5f, 2.5f, 2.5f), foo);
+  ASSERT_FLOAT_EQ(3.0f, Vec3f(1.0f, 2.0f, 2.0f).norm());
+  ASSERT_FLOAT_EQ(3.25f, foo.dot(bar));
+
+  std::ostringstream output;
+  output << foo;
+  ASSERT_EQ(std::string("(1.5; 2.5; 2.5)"), output.str());
+}
+
+TEST(Vec3ScalarTest, TestDualGradient) {
+  using D = Dual<double>;
+
+  const double x = 3.0;
+  const double y = -4.0;
+  const double z = 12.0;
+
+  // seed derivative wrt x, then wrt y, then wrt z:
+  // d|r|/dr = r / |r|
+  const BasicVec3<D> rx(D(x, 1.0), D(y), D(z));
+  const BasicVec3<D> ry(D(x), D(y, 1.0), D(z));
+  const BasicVec3<D> rz(D(x), D(y), D(z, 1.0));
+
+  ASSERT_DOUBLE_EQ(13.0, rx.norm().val_);
+  ASSERT_DOUBLE_EQ(x / 13.0, rx.norm().eps_);
+  ASSERT_DOUBLE_EQ(y / 13.0, ry.norm().eps_);
+  ASSERT_DOUBLE_EQ(z / 13.0, rz.norm().eps_);
+}
+
+TEST(Vec3ScalarTest, TestDualJacobian) {
+  using D = Dual<double>;
+
+  // gravity-like field, a = -mu * r / |r|^3
+  const double mu = 2.0;
+  const Vec3 r(1.0, 2.0, 2.0);
+
+  const BasicVec3<D> rd(D(r.x_, 1.0), D(r.y_), D(r.z_));
+  const D n = rd.norm();
+  const BasicVec3<D> a = rd * (D(-mu) / (n * n * n));
+
+  // da/dx = -mu * (e_x / |r|^3 - 3 x r / |r|^5)
+  const double n3 = 27.0;
+  const double n5 = 243.0;
+  ASSERT_DOUBLE_EQ(-mu * r.x_ / n3, a.x_.val_);
+  ASSERT_DOUBLE_EQ(-mu * (1.0 / n3 - 3.0 * r.x_ * r.x_ / n5), a.x_.eps_);
+  ASSERT_DOUBLE_EQ(-mu * (-3.0 * r.x_ * r.y_ / n5), a.y_.eps_);
+  ASSERT_DOUBLE_EQ(-mu * (-3.0 * r.x_ * r.z_ / n5), a.z_.eps_);
+}